@@ -0,0 +1,128 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_ASSETSTREAMER_H
+#define VULKANRENDERER_ASSETSTREAMER_H
+
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "VulkanUploader.h"
+
+///@brief loads assets on background I/O threads and uploads them under a per-frame byte budget
+///@details I/O threads run the load function of a request (read, map or decode) and park the result. Update() runs on
+/// the render thread once per frame and hands loaded bytes to VulkanUploader until the frame's budget is spent, an asset
+/// larger than the budget is spread over several frames. Uploads go out in request order, so a level streams in the
+/// order it was requested and readiness always grows as a prefix of the requests.
+class AssetStreamer {
+public:
+    ///@brief bytes to upload, valid until the asset was staged
+    struct AssetData {
+        const void* data = nullptr;
+        VkDeviceSize size = 0;
+        ///@brief keeps data alive, a decoded buffer or the mapped file it points into
+        std::shared_ptr<const void> owner;
+
+        static AssetData FromBuffer(std::vector<char> buffer);
+    };
+
+    ///@brief runs on an I/O thread, may throw
+    using LoadFunction = std::function<AssetData()>;
+    ///@brief runs on the render thread once the last byte was staged, graphics submits after it wait for the copy
+    using ReadyFunction = std::function<void()>;
+
+    ///@brief either dstBuffer or image.image is set, an image request uploads one mip level in whole block rows
+    struct Request {
+        LoadFunction load;
+        VulkanUploader::ImageUpload image{};
+        VkBuffer dstBuffer = VK_NULL_HANDLE;
+        VkDeviceSize dstOffset = 0;
+        VkAccessFlags dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        ReadyFunction onReady;
+    };
+
+    struct Stats {
+        ///@brief requests waiting for or running on an I/O thread
+        uint32_t loadQueueDepth = 0;
+        ///@brief loaded requests waiting for upload budget
+        uint32_t uploadQueueDepth = 0;
+        VkDeviceSize bytesPendingUpload = 0;
+        ///@brief staged by frames whose slot was not waited on yet
+        VkDeviceSize bytesInFlight = 0;
+        VkDeviceSize bytesUploadedLastFrame = 0;
+        uint64_t completedRequests = 0;
+    };
+
+    ///@param uploadBudget bytes staged per Update(), bounds the memcpy and copy commands a frame pays for streaming
+    AssetStreamer(VulkanUploader* uploader, uint32_t ioThreadCount = 2, VkDeviceSize uploadBudget = 4 * 1024 * 1024);
+    ~AssetStreamer();
+
+    AssetStreamer(const AssetStreamer&) = delete;
+    AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+    void SetUploadBudget(VkDeviceSize uploadBudget) { m_UploadBudget = std::max<VkDeviceSize>(uploadBudget, 1); }
+
+    ///@brief resets the per-slot accounting, GPU has to be idle
+    void SetFramesInFlight(uint32_t framesInFlight);
+
+    ///@brief queues a request, the load function is started on an I/O thread right away
+    void Submit(Request request);
+
+    ///@brief stages loaded assets up to the budget, call after frameSlot was waited on and before the uploader is flushed
+    ///@details rethrows the first load failure on the render thread
+    void Update(uint32_t frameSlot);
+
+    [[ nodiscard ]] Stats GetStats() const;
+    [[ nodiscard ]] bool IsIdle() const;
+
+    ///@brief reads a whole file on the calling thread
+    static AssetData ReadFile(const std::string& path);
+
+    ///@brief touches every page of a mapped range, so page faults are taken by the I/O thread and not by Update()
+    static void Prefault(const void* data, size_t size);
+private:
+    struct Job {
+        Request request;
+        AssetData data;
+        VkDeviceSize uploaded = 0;
+        bool loaded = false;
+        std::string error;
+    };
+
+    void uploadBufferChunk(Job& job, uint32_t frameSlot, VkDeviceSize chunkSize);
+    ///@brief stages whole block rows of the level within budget, opens and closes the image upload around them
+    void uploadImageChunk(Job& job, uint32_t frameSlot, VkDeviceSize& budget);
+    void accountUpload(uint32_t frameSlot, VkDeviceSize size);
+
+    VulkanUploader* m_Uploader;
+    VkDeviceSize m_UploadBudget;
+
+    mutable std::mutex m_Mutex;
+    ///@brief request order, Update() drains from the front
+    std::deque<std::shared_ptr<Job>> m_Jobs;
+
+    ///@brief bytes staged by each frame slot, retired when the slot is waited on again
+    std::vector<VkDeviceSize> m_SlotBytes = std::vector<VkDeviceSize>(1, 0);
+    VkDeviceSize m_BytesInFlight = 0;
+    VkDeviceSize m_BytesUploadedLastFrame = 0;
+    uint64_t m_CompletedRequests = 0;
+
+    ///@brief queued loads are skipped once set, so shutdown does not wait for a whole level to be read
+    std::atomic<bool> m_Stopping = false;
+    ///@brief declared last, joined first while the members above are still alive
+    ThreadPool m_IoThreads;
+};
+
+#endif //VULKANRENDERER_ASSETSTREAMER_H
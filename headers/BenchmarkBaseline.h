@@ -0,0 +1,49 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_BENCHMARKBASELINE_H
+#define VULKANRENDERER_BENCHMARKBASELINE_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "FrameStatistics.h"
+#include "Json.h"
+
+///@brief results file of an earlier benchmark run, which new scene summaries are checked against
+///@details average and p95 of every metric both runs measured are compared. A statistic regressed when it is more than
+/// the threshold percentage above the baseline and the difference is at least MIN_REGRESSION_MS.
+class BenchmarkBaseline {
+public:
+    ///@brief differences below this are timer noise, never a regression
+    static constexpr double MIN_REGRESSION_MS = 0.05;
+
+    struct Regression {
+        FrameStatistics::Metric metric;
+        ///@brief "average" or "p95"
+        const char* statistic;
+        double value;
+        double baselineValue;
+    };
+
+    using Summaries = std::array<FrameStatistics::Summary, FrameStatistics::METRIC_COUNT>;
+
+    ///@param json contents of a results file written by Benchmark, throws when malformed
+    explicit BenchmarkBaseline(const std::string& json);
+
+    ///@brief throws when the file can't be read
+    [[ nodiscard ]] static BenchmarkBaseline Load(const std::string& path);
+
+    [[ nodiscard ]] bool HasScene(const std::string& scene) const { return findScene(scene) != nullptr; }
+
+    ///@brief empty when nothing regressed or the scene is not in the baseline
+    [[ nodiscard ]] std::vector<Regression> Compare(const std::string& scene, const Summaries& summaries, double thresholdPercent) const;
+private:
+    [[ nodiscard ]] const JsonValue* findScene(const std::string& scene) const;
+
+    JsonValue m_Baseline;
+};
+
+#endif //VULKANRENDERER_BENCHMARKBASELINE_H
@@ -0,0 +1,77 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_DRAWPACKET_H
+#define VULKANRENDERER_DRAWPACKET_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ThreadPool.h"
+
+///@brief one draw of a frame, recorded in sort key order
+struct DrawPacket {
+    uint64_t sortKey;
+    ///@brief draw list index, instance batches are counted after the scene draws
+    uint32_t drawIndex;
+};
+
+///@brief builds draw packet sort keys and radix sorts packets on a thread pool
+///@details keys hold, from the most significant bits, pass, pipeline, material, mesh and depth, so sorted packets
+/// change pipelines least often, then materials, then meshes, and draws sharing all state go front to back.
+/// The sort is an LSD radix sort over 8 bit digits, every digit is counted and then scattered chunk by chunk on the
+/// workers into offsets computed from those counts, which keeps the sort stable. A first read counts all digits at
+/// once, digits equal for every packet, typically pass and pipeline, are skipped.
+class DrawPacketSorter {
+public:
+    static constexpr uint32_t PASS_BITS = 4;
+    static constexpr uint32_t PIPELINE_BITS = 8;
+    static constexpr uint32_t MATERIAL_BITS = 24;
+    static constexpr uint32_t MESH_BITS = 12;
+    static constexpr uint32_t DEPTH_BITS = 16;
+
+    explicit DrawPacketSorter(ThreadPool* threadPool) : m_ThreadPool(threadPool) {};
+
+    DrawPacketSorter(const DrawPacketSorter&) = delete;
+    DrawPacketSorter& operator=(const DrawPacketSorter&) = delete;
+
+    ///@brief fields are truncated to their bits, depth is the view distance and is clamped at 0
+    [[ nodiscard ]] static uint64_t MakeKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+
+    [[ nodiscard ]] static uint32_t GetPipeline(uint64_t sortKey) { return static_cast<uint32_t>(sortKey >> PIPELINE_SHIFT) & ((1u << PIPELINE_BITS) - 1); }
+    [[ nodiscard ]] static uint32_t GetMaterial(uint64_t sortKey) { return static_cast<uint32_t>(sortKey >> MATERIAL_SHIFT) & ((1u << MATERIAL_BITS) - 1); }
+
+    ///@brief sorts by key in ascending order, packets with equal keys keep their order
+    void Sort(std::vector<DrawPacket>& packets);
+private:
+    static constexpr uint32_t MESH_SHIFT = DEPTH_BITS;
+    static constexpr uint32_t MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+    static constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+    static constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+    static_assert(PASS_SHIFT + PASS_BITS == 64, "sort key fields have to fill 64 bits");
+
+    static constexpr uint32_t RADIX_BITS = 8;
+    static constexpr uint32_t RADIX = 1u << RADIX_BITS;
+    static constexpr uint32_t DIGIT_COUNT = 64 / RADIX_BITS;
+
+    ///@brief below this many packets per chunk the job overhead outweighs sorting in parallel
+    static constexpr size_t MIN_PACKETS_PER_JOB = 4096;
+
+    ///@brief true when every packet falls into the same bucket of digit, from the first counting pass
+    [[ nodiscard ]] bool isSharedDigit(uint32_t digit, uint32_t chunkCount, size_t count) const;
+
+    ///@brief calls function(chunk, begin, end) for every chunk, on the pool when there is more than one
+    template<typename Function>
+    void forEachChunk(uint32_t chunkCount, size_t chunkSize, size_t count, const Function& function);
+
+    ThreadPool* m_ThreadPool;
+
+    std::vector<DrawPacket> m_Scratch;
+    ///@brief indexed [chunk][digit][bucket]
+    std::vector<uint32_t> m_Histograms;
+    ///@brief indexed [chunk][bucket], next write position of the digit being scattered
+    std::vector<uint32_t> m_Offsets;
+};
+
+#endif //VULKANRENDERER_DRAWPACKET_H
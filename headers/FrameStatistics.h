@@ -0,0 +1,59 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_FRAMESTATISTICS_H
+#define VULKANRENDERER_FRAMESTATISTICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VulkanProfiler.h"
+
+///@brief per-frame timings of a run, summarized as average and percentiles
+///@details fed with completed profiler frames, so every metric of a frame is known when it arrives. Frame time is the
+/// distance between the starts of two consecutive frames, record, submit and GPU time come from the scopes of the
+/// same names the renderer opens around recording, vkQueueSubmit and the whole command buffer.
+class FrameStatistics {
+public:
+    enum Metric {
+        FRAME_TIME,
+        RECORD_TIME,
+        SUBMIT_TIME,
+        GPU_TIME,
+        METRIC_COUNT
+    };
+
+    ///@brief JSON keys of the metrics, in Metric order
+    static constexpr const char* METRIC_NAMES[METRIC_COUNT] = {"frame", "record", "submit", "gpu"};
+
+    ///@brief milliseconds, percentiles use the nearest rank
+    struct Summary {
+        size_t count = 0;
+        double average = 0.0;
+        double min = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    ///@brief adds the frame's samples, frames have to arrive in order
+    void AddFrame(const VulkanProfiler::FrameRecord& frameRecord);
+    void AddSample(Metric metric, double milliseconds);
+    void Clear();
+
+    [[ nodiscard ]] Summary Summarize(Metric metric) const;
+    [[ nodiscard ]] size_t GetFrameCount() const { return m_FrameCount; }
+
+    static Summary Summarize(std::vector<double> samples);
+private:
+    std::array<std::vector<double>, METRIC_COUNT> m_Samples;
+    size_t m_FrameCount = 0;
+    ///@brief start of the previous frame, negative before the first one
+    double m_PreviousBeginUs = -1.0;
+};
+
+#endif //VULKANRENDERER_FRAMESTATISTICS_H
@@ -0,0 +1,109 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_INSTANCEBATCH_H
+#define VULKANRENDERER_INSTANCEBATCH_H
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+///@brief index range of a mesh in the renderer's shared vertex and index buffers
+struct MeshRange {
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+};
+
+///@brief one mesh drawn N times with a single instanced draw
+///@details attributes are kept as structure of arrays, an update touching one attribute streams through one tightly
+/// packed array and every frame each array is copied as is into its own per-instance vertex binding, so packing costs
+/// three memcpy. Matches the per-instance inputs of shaders/instanced.vert.
+class InstanceBatch {
+public:
+    static constexpr uint32_t TRANSFORM_BINDING = 1;
+    static constexpr uint32_t COLOR_BINDING = 2;
+    static constexpr uint32_t MATERIAL_BINDING = 3;
+
+    explicit InstanceBatch(const MeshRange& mesh) : Mesh(mesh) {};
+
+    ///@brief appends an instance, returns its index
+    uint32_t Add(const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f), uint32_t materialIndex = UINT32_MAX) {
+        Transforms.push_back(transform);
+        Colors.push_back(color);
+        MaterialIndices.push_back(materialIndex);
+
+        return static_cast<uint32_t>(Transforms.size() - 1);
+    }
+
+    ///@brief new instances get identity transforms, white color and no material
+    void Resize(size_t count) {
+        Transforms.resize(count, glm::mat4(1.0f));
+        Colors.resize(count, glm::vec4(1.0f));
+        MaterialIndices.resize(count, UINT32_MAX);
+    }
+
+    void Clear() {
+        Transforms.clear();
+        Colors.clear();
+        MaterialIndices.clear();
+    }
+
+    [[ nodiscard ]] uint32_t Size() const { return static_cast<uint32_t>(Transforms.size()); }
+
+    ///@brief per-instance bindings, the mesh vertices stay in binding 0
+    static std::array<VkVertexInputBindingDescription, 3> getBindingDescriptions() {
+        std::array<VkVertexInputBindingDescription, 3> bindingDescriptions{};
+
+        bindingDescriptions[0].binding = TRANSFORM_BINDING;
+        bindingDescriptions[0].stride = sizeof(glm::mat4);
+        bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        bindingDescriptions[1].binding = COLOR_BINDING;
+        bindingDescriptions[1].stride = sizeof(glm::vec4);
+        bindingDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        bindingDescriptions[2].binding = MATERIAL_BINDING;
+        bindingDescriptions[2].stride = sizeof(uint32_t);
+        bindingDescriptions[2].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        return bindingDescriptions;
+    }
+
+    ///@brief locations follow the Vertex attributes, a mat4 takes one location per column
+    static std::array<VkVertexInputAttributeDescription, 6> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 6> attributeDescriptions{};
+
+        for(uint32_t column = 0; column < 4; column++){
+            attributeDescriptions[column].binding = TRANSFORM_BINDING;
+            attributeDescriptions[column].location = 3 + column;
+            attributeDescriptions[column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attributeDescriptions[column].offset = column * sizeof(glm::vec4);
+        }
+
+        attributeDescriptions[4].binding = COLOR_BINDING;
+        attributeDescriptions[4].location = 7;
+        attributeDescriptions[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        attributeDescriptions[4].offset = 0;
+
+        attributeDescriptions[5].binding = MATERIAL_BINDING;
+        attributeDescriptions[5].location = 8;
+        attributeDescriptions[5].format = VK_FORMAT_R32_UINT;
+        attributeDescriptions[5].offset = 0;
+
+        return attributeDescriptions;
+    }
+
+    MeshRange Mesh;
+
+    std::vector<glm::mat4> Transforms;
+    std::vector<glm::vec4> Colors;
+    ///@brief bindless material buffer index, UINT32_MAX when unused
+    std::vector<uint32_t> MaterialIndices;
+};
+
+#endif //VULKANRENDERER_INSTANCEBATCH_H
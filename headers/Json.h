@@ -0,0 +1,59 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_JSON_H
+#define VULKANRENDERER_JSON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///@brief parsed JSON document node, just enough for glTF and the benchmark reports, no unicode escapes
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object } type = Type::Null;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    [[ nodiscard ]] const JsonValue* find(const std::string& key) const {
+        auto it = object.find(key);
+        return it == object.end() ? nullptr : &it->second;
+    }
+
+    ///@brief throws when the key is missing
+    [[ nodiscard ]] const JsonValue& at(const std::string& key) const {
+        auto value = find(key);
+        if(!value)
+            throw std::runtime_error("JsonValue::at() -> Missing \"" + key + "\"!");
+        return *value;
+    }
+
+    [[ nodiscard ]] uint64_t integer(const std::string& key, uint64_t fallback) const {
+        auto value = find(key);
+        return value ? static_cast<uint64_t>(value->number) : fallback;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_Text(text) {};
+
+    ///@brief throws on malformed input
+    JsonValue Parse();
+private:
+    void skipWhitespace();
+    char expect(char character);
+    bool consume(char character);
+    std::string parseString();
+    JsonValue parseValue();
+
+    const std::string& m_Text;
+    size_t m_Position = 0;
+};
+
+#endif //VULKANRENDERER_JSON_H
@@ -0,0 +1,42 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_MAPPEDFILE_H
+#define VULKANRENDERER_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///@brief read-only view of a whole file, memory mapped where the platform allows it, read into memory elsewhere
+///@details pages of a mapping are only read when touched, so a large container can be opened cheaply and its ranges
+/// streamed on demand. Read-only access from several threads is safe.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ///@brief throws when the file can not be opened or is empty
+    void Open(const std::string& path);
+    void Close();
+
+    [[ nodiscard ]] const char* GetData() const { return m_Data; }
+    [[ nodiscard ]] size_t GetSize() const { return m_Size; }
+    [[ nodiscard ]] bool IsOpen() const { return m_Data != nullptr; }
+
+    ///@brief checks that [offset, offset + size) lies inside the file without overflowing
+    [[ nodiscard ]] bool Contains(uint64_t offset, uint64_t size) const { return offset <= m_Size && size <= m_Size - offset; }
+private:
+    const char* m_Data = nullptr;
+    size_t m_Size = 0;
+    ///@brief only used where mapping is not available
+    std::vector<char> m_FallbackData;
+};
+
+#endif //VULKANRENDERER_MAPPEDFILE_H
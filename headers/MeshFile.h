@@ -0,0 +1,95 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_MESHFILE_H
+#define VULKANRENDERER_MESHFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "Vertex.h"
+
+///@brief .vkm mesh container, designed to be mapped and uploaded without parsing
+///@details layout: MeshFileHeader | MeshFileEntry[meshCount] | vertex blob | index blob. Both blobs start at
+/// MESH_FILE_ALIGNMENT (page size, also above every GPU offset alignment), so they can be copied or DMA'd from the
+/// mapping straight into staging memory. Meshes are consecutive ranges of the blobs, element aligned, so a mesh can be
+/// streamed alone and its offsets translate directly into vertexOffset / firstIndex of a draw. Everything is little endian.
+struct MeshFileHeader {
+    static constexpr char MAGIC[4] = {'V', 'K', 'M', 'F'};
+    ///@brief bumped on every layout change, older files are rejected instead of misread
+    static constexpr uint32_t VERSION = 2;
+
+    char magic[4];
+    uint32_t version;
+    ///@brief sizeof(Vertex) of the writer, a different vertex layout needs a new version
+    uint32_t vertexStride;
+    uint32_t indexSize;
+    uint32_t meshCount;
+    uint32_t reserved;
+    uint64_t meshTableOffset;
+    uint64_t vertexBlobOffset;
+    uint64_t vertexBlobSize;
+    uint64_t indexBlobOffset;
+    uint64_t indexBlobSize;
+};
+
+struct MeshFileEntry {
+    ///@brief object space, xyz - center, w - radius
+    float boundingSphere[4];
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    ///@brief first vertex and index of the mesh within the blobs, in elements
+    uint32_t firstVertex;
+    uint32_t firstIndex;
+};
+
+static constexpr uint64_t MESH_FILE_ALIGNMENT = 4096;
+
+///@brief read-only view of a .vkm file, memory mapped where the platform allows it
+class MeshFile {
+public:
+    ///@brief maps the file and validates header and mesh table against the file size, throws on malformed files
+    void Open(const std::string& path);
+    void Close();
+
+    [[ nodiscard ]] uint32_t GetMeshCount() const { return m_Header ? m_Header->meshCount : 0; }
+    [[ nodiscard ]] const MeshFileEntry& GetMesh(uint32_t mesh) const { return m_Meshes[mesh]; }
+
+    ///@brief whole blobs, for uploading every mesh with one copy each
+    [[ nodiscard ]] const void* GetVertexBlob() const { return m_File.GetData() + m_Header->vertexBlobOffset; }
+    [[ nodiscard ]] size_t GetVertexBlobSize() const { return m_Header->vertexBlobSize; }
+    [[ nodiscard ]] const void* GetIndexBlob() const { return m_File.GetData() + m_Header->indexBlobOffset; }
+    [[ nodiscard ]] size_t GetIndexBlobSize() const { return m_Header->indexBlobSize; }
+
+    ///@brief ranges of a single mesh, pointers into the mapping
+    [[ nodiscard ]] const Vertex* GetVertices(uint32_t mesh) const;
+    [[ nodiscard ]] const uint32_t* GetIndices(uint32_t mesh) const;
+private:
+    void validate(const std::string& path);
+
+    MappedFile m_File;
+    const MeshFileHeader* m_Header = nullptr;
+    const MeshFileEntry* m_Meshes = nullptr;
+};
+
+///@brief builds a .vkm file, used by the offline converter
+class MeshFileWriter {
+public:
+    ///@brief appends a mesh, indices are relative to its own vertices, returns the mesh index
+    uint32_t AddMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    void Write(const std::string& path) const;
+
+    [[ nodiscard ]] uint32_t GetMeshCount() const { return static_cast<uint32_t>(m_Meshes.size()); }
+private:
+    std::vector<MeshFileEntry> m_Meshes;
+    std::vector<Vertex> m_Vertices;
+    std::vector<uint32_t> m_Indices;
+};
+
+#endif //VULKANRENDERER_MESHFILE_H
@@ -12,15 +12,41 @@
 #include <stdexcept>
 #include <cstdlib>
 #include <vector>
+#include <array>
 #include <string>
 #include <algorithm>
 #include <optional>
 #include <set>
+#include <map>
+#include <unordered_map>
 #include <limits>
 #include <fstream>
+#include <mutex>
+#include <chrono>
 
 #include "VulkanInstance.h"
 #include "VulkanDebugMessenger.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanPipelineRegistry.h"
+#include "VulkanBindlessDescriptors.h"
+#include "VulkanFrameData.h"
+#include "VulkanGpuCuller.h"
+#include "VulkanAsyncCompute.h"
+#include "VulkanMemoryAllocator.h"
+#include "VulkanUploader.h"
+#include "AssetStreamer.h"
+#include "VulkanTextureManager.h"
+#include "VulkanCommandRecorder.h"
+#include "ThreadPool.h"
+#include "DrawPacket.h"
+#include "VulkanProfiler.h"
+#include "FrameStatistics.h"
+#include "VulkanDeletionQueue.h"
+#include "RenderGraph.h"
+#include "ShaderManager.h"
+#include "Vertex.h"
+#include "InstanceBatch.h"
+#include "MeshFile.h"
 
 static std::vector<char> readFile(const std::string& filename){
     std::ifstream file(filename, std::ios::ate | std::ios::binary);
@@ -42,23 +68,180 @@ static std::vector<char> readFile(const std::string& filename){
 namespace MyRenderer{
     class RenderEngine{
     public:
+        ///@brief trade-off between input latency and throughput, selects frames in flight, swap chain size and present mode
+        enum class LatencyMode {
+            LowLatency,     ///< 1 frame in flight, FIFO_RELAXED or FIFO
+            Balanced,       ///< 2 frames in flight, MAILBOX or FIFO
+            MaxThroughput   ///< 3 frames in flight, IMMEDIATE or MAILBOX
+        };
+
+        ///@brief the built-in triangle in the shared vertex and index buffers
+        static constexpr MeshRange TRIANGLE_MESH{3, 0, 0};
+
         RenderEngine(uint32_t width, uint32_t height, const std::string& title);
         ~RenderEngine() = default;
 
         void Run();
 
+        ///@brief renders into device-owned images instead of a swap chain, no window is created
+        ///@param frameCount number of frames rendered before Run() returns
+        void SetHeadless(bool headless, uint32_t frameCount = 1);
+
+        ///@brief frame timings of the last frames are written as Chrome trace JSON on exit
+        void SetTraceOutput(const std::string& path);
+
+        ///@brief collects the timings of every measured frame, has to outlive Run() and be set before it
+        ///@details measuring starts once streamed assets arrived and warmupFrames more frames were rendered, in headless
+        /// mode the frame count of SetHeadless() counts measured frames only
+        void SetFrameStatistics(FrameStatistics* frameStatistics, uint32_t warmupFrames = 0);
+
+        ///@brief can be changed while running, the new mode is applied at the next frame boundary
+        void SetLatencyMode(LatencyMode latencyMode);
+
+        ///@brief opt-in Vulkan 1.2 frame pacing on a single timeline semaphore instead of per-frame fences
+        ///@details falls back to fences when the device does not support timeline semaphores, has to be set before Run()
+        void SetTimelineSync(bool timelineSync);
+
+        ///@brief MSAA sample count, clamped to what the device supports, 1 disables multisampling
+        void SetMsaaSamples(uint32_t sampleCount);
+
+        ///@brief frustum culls the draw list in a compute pass and draws it with one indirect count draw
+        ///@details on by default, falls back to CPU recorded draws when the device lacks indirect count draws, has to be set before Run()
+        void SetGpuCulling(bool gpuCulling);
+
+        ///@brief opt-in, runs GPU culling on a separate compute queue overlapping the graphics queue
+        ///@details needs a dedicated compute family or a second graphics family queue, has to be set before Run()
+        void SetAsyncCompute(bool asyncCompute);
+
+        ///@brief draws the batch's mesh once per instance with a single indexed draw, every frame
+        ///@details the batch is read at the start of each frame on the render thread, it has to outlive Run()
+        void AddInstanceBatch(const InstanceBatch* instanceBatch);
+
+        ///@brief .vkm file written by MeshConverter, every mesh is drawn once after the built-in triangle
+        ///@details meshes stream in on background I/O threads and are drawn once their data arrived, has to be set before Run()
+        void SetSceneFile(const std::string& path);
+
+        ///@brief .ktx2 texture applied to every draw, its mip levels stream in as the draws' screen size asks for them
+        ///@details has to be set before Run()
+        void SetTextureFile(const std::string& path);
+
+        ///@brief bytes of streamed assets staged per frame, spreads large loads over frames instead of spiking one
+        void SetUploadBudget(VkDeviceSize bytesPerFrame);
+
     private:
-        const uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+        uint32_t m_FramesInFlight = 2;
+        LatencyMode m_LatencyMode = LatencyMode::Balanced;
+        LatencyMode m_RequestedLatencyMode = LatencyMode::Balanced;
         uint32_t m_CurrentFrame = 0;
         bool m_FrameBufferResized = false;
+        bool m_Headless = false;
+        bool m_TimelineSync = false;
+        bool m_GpuCulling = true;
+        bool m_AsyncCompute = false;
+        ///@brief async compute only, the instance buffer was handed over from the graphics queue to the compute queue
+        bool m_CullInstancesOnCompute = false;
+        uint32_t m_RequestedMsaaSamples = 4;
+        VkSampleCountFlagBits m_MsaaSamples = VK_SAMPLE_COUNT_1_BIT;
+        VkFormat m_DepthFormat = VK_FORMAT_UNDEFINED;
+        uint32_t m_HeadlessFrameCount = 1;
+        std::string m_TraceOutputPath;
+        FrameStatistics* m_FrameStatistics = nullptr;
+        uint32_t m_WarmupFrames = 0;
+        ///@brief profiler number of the first measured frame, known once streaming finished
+        uint64_t m_MeasureFromFrame = UINT64_MAX;
+        std::string m_SceneFilePath;
+        std::string m_TextureFilePath;
         // ********** STRUCTS *********** //
 
         struct QueueFamilyIndices {
             std::optional<uint32_t> graphicsFamily;
             std::optional<uint32_t> presentFamily;
+            ///@brief transfer-only family (DMA engine), empty when the device has none
+            std::optional<uint32_t> transferFamily;
+            ///@brief compute family without graphics (async compute engine), empty when the device has none
+            std::optional<uint32_t> computeFamily;
+            uint32_t graphicsQueueCount = 0;
+            bool presentRequired = true;
+
+            ///@brief checks if all queue families has value, present family is ignored in headless mode
+            [[nodiscard]] bool isComplete() const { return graphicsFamily.has_value() && (presentFamily.has_value() || !presentRequired); }
+        };
+
+        ///@brief one indexed draw of the draw list
+        struct DrawCommand {
+            uint32_t indexCount;
+            uint32_t firstIndex;
+            int32_t vertexOffset;
+            ///@brief bindless indices of the material resources, INVALID_INDEX when unused
+            uint32_t textureIndex = VulkanBindlessDescriptors::INVALID_INDEX;
+            uint32_t materialBufferIndex = VulkanBindlessDescriptors::INVALID_INDEX;
+            ///@brief index into m_Objects
+            uint32_t transformIndex = 0;
+            ///@brief draws of the same mesh share it, groups them in the sort key
+            uint32_t meshId = 0;
+            ///@brief texture manager id, its bindless index is written into m_Objects every frame
+            uint32_t textureId = VulkanBindlessDescriptors::INVALID_INDEX;
+            ///@brief object space, xyz - center, w - radius
+            glm::vec4 boundingSphere = glm::vec4(0.0f);
+        };
+
+        ///@brief where one instance batch was packed for the frame being recorded
+        struct InstanceBatchBinding {
+            MeshRange mesh;
+            uint32_t instanceCount;
+            VkBuffer buffer;
+            VkDeviceSize transformOffset;
+            VkDeviceSize colorOffset;
+            VkDeviceSize materialOffset;
+        };
+
+        ///@brief per-draw data, layout matches the push_constant block in shaders/bindless.glsl
+        struct DrawPushConstants {
+            uint32_t textureIndex;
+            uint32_t materialBufferIndex;
+            uint32_t transformIndex;
+        };
 
-            ///@brief checks if all queue families has value
-            [[nodiscard]] bool isComplete() const { return graphicsFamily.has_value() && presentFamily.has_value(); }
+        ///@brief state bound in the secondary command buffer being recorded, binds repeating it are skipped
+        ///@details both pipelines share m_PipelineLayout and declare viewport and scissor dynamic, so descriptor sets,
+        /// dynamic state and the mesh buffers bound once stay valid across pipeline switches
+        struct BoundDrawState {
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            bool sharedStateBound = false;
+            VkBuffer instanceBuffer = VK_NULL_HANDLE;
+            VkDeviceSize instanceOffsets[3] = {};
+            std::optional<DrawPushConstants> pushConstants;
+        };
+
+        ///@brief sort key pass field, one render pass with opaque draws only for now
+        static constexpr uint32_t OPAQUE_PASS = 0;
+        ///@brief largest mesh id the sort key holds
+        static constexpr uint32_t MAX_MESH_ID = (1u << DrawPacketSorter::MESH_BITS) - 1;
+
+        ///@brief per-frame uniform block, layout matches FrameUniforms in shaders/frame.glsl
+        struct FrameUniforms {
+            glm::mat4 viewProjection;
+            ///@brief x - seconds since start, y - seconds since the previous frame
+            glm::vec4 time;
+            ///@brief left, right, bottom, top, near, far, normals point inside
+            glm::vec4 frustumPlanes[6];
+        };
+
+        ///@brief std430 layout of ObjectData in shaders/frame.glsl
+        struct ObjectData {
+            glm::mat4 transform;
+            ///@brief bindless indices, INVALID_INDEX when unused
+            uint32_t textureIndex = VulkanBindlessDescriptors::INVALID_INDEX;
+            uint32_t materialBufferIndex = VulkanBindlessDescriptors::INVALID_INDEX;
+            uint32_t padding[2] = {};
+        };
+
+        struct LatencyPolicy {
+            uint32_t framesInFlight;
+            ///@brief swap chain images requested on top of minImageCount
+            uint32_t extraSwapChainImages;
+            ///@brief present modes in order of preference, FIFO is the fallback
+            std::vector<VkPresentModeKHR> presentModes;
         };
 
         struct SwapChainSupportDetails {
@@ -86,12 +269,35 @@ namespace MyRenderer{
 
         void cleanupSwapChain();
 
+        ///@brief runs deleter once every frame submitted so far and the one being recorded completed
+        void deferDestroy(VulkanDeletionQueue::Deleter deleter);
+
+        ///@brief advances the completed frame count after the fence of m_CurrentFrame was waited on
+        void collectCompletedFrames();
+
+        ///@brief resizes every per-frame resource and recreates the swap chain for m_RequestedLatencyMode
+        void applyLatencyMode();
+
+        ///@brief starts measuring frame statistics once streaming finished
+        void updateMeasuring();
+
         void drawFrame();
 
+        ///@brief submits a frame without acquire/present, used in headless mode
+        void drawHeadlessFrame();
+
+        ///@brief blocks until the previous frame submitted in m_CurrentFrame completed
+        void waitForFrameSlot();
+
+        ///@brief submits m_CurrentFrame command buffer, signals signalSemaphore (if not null) and the frame fence or timeline value
+        void submitFrame(const std::vector<VkSemaphore>& waitSemaphores, const std::vector<VkPipelineStageFlags>& waitStages,
+                         VkSemaphore signalSemaphore);
+
         // **********MAIN CORE*********** //
 
         // ********HELPER METHODS******** //
         bool checkDeviceExtensionsSupport(VkPhysicalDevice physicalDevice);
+        bool checkTimelineSemaphoreSupport(VkPhysicalDevice physicalDevice);
 
         [[nodiscard]] std::vector<const char*> getRequiredExtensions() const;
         int ratePhysicalDevice(const VkPhysicalDevice &physicalDevice);
@@ -100,12 +306,67 @@ namespace MyRenderer{
         SwapChainSupportDetails querySwapChainSupportDetails(VkPhysicalDevice physicalDevice);
 
         static VkSurfaceFormatKHR chooseSwapChainSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableSurfaceFormats);
-        static VkPresentModeKHR chooseSwapChainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+        [[nodiscard]] VkPresentModeKHR chooseSwapChainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) const;
+        static LatencyPolicy getLatencyPolicy(LatencyMode latencyMode);
+        [[ nodiscard ]] VkSampleCountFlagBits chooseMsaaSampleCount() const;
+        [[ nodiscard ]] VkFormat chooseDepthFormat() const;
         VkExtent2D chooseSwapChainExtent2D(const VkSurfaceCapabilitiesKHR& surfaceCapabilities);
 
         VkShaderModule createShaderModule(const std::vector<char>& shaderCode);
 
+        ///@brief rebuilds pipelines using one of the recompiled shaders, called on the shader watcher thread
+        void onShadersReloaded(const std::vector<std::string>& shaderNames);
+
+        ///@brief swaps in pipelines rebuilt by hot reload, called at the frame boundary
+        void applyReloadedPipelines();
+
+        ///@brief publishes pipelines finished by the startup compile, draws without a pipeline are skipped until then
+        void collectCompiledPipelines();
+
         void recordCommandBuffer(VkCommandBuffer, uint32_t imageIndex);
+
+        ///@brief declares the frame passes, barriers and layout transitions between them are derived by the graph
+        void buildRenderGraph();
+
+        ///@brief records a slice of the sorted draw packets into a secondary command buffer, called from worker threads
+        void recordDrawSlice(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t drawCount) const;
+
+        ///@brief binds the pipeline, with dynamic state, geometry and descriptor sets the first time in the command buffer
+        ///@return false while the pipeline is still compiling
+        bool bindDrawState(VkCommandBuffer commandBuffer, BoundDrawState& boundDrawState, VulkanPipelineRegistry::PipelineHandle pipelineHandle) const;
+
+        void pushDrawConstants(VkCommandBuffer commandBuffer, BoundDrawState& boundDrawState, const DrawPushConstants& pushConstants) const;
+
+        ///@brief builds one packet per scene draw and instance batch and sorts them by state, after updateInstanceData()
+        void buildDrawPackets(const glm::mat4& viewProjection);
+
+        ///@brief draws recorded for the draw list, instance batches are counted after them
+        [[ nodiscard ]] uint32_t getSceneDrawCount() const;
+
+        ///@brief packs every instance batch into the instance ring, after the frame slot was waited on
+        void updateInstanceData();
+
+        ///@brief builds the GPU culling instance list from the draw list
+        [[ nodiscard ]] std::vector<VulkanGpuCuller::Instance> buildCullInstances() const;
+
+        ///@brief bounding box center with the farthest indexed vertex as radius, loose but cheap
+        [[ nodiscard ]] static glm::vec4 computeBoundingSphere(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+        ///@brief copies the frame uniforms and object transforms into the frame data ring, after the frame slot was waited on
+        void updateFrameData();
+
+        ///@brief requests the mip level each textured draw needs for its projected bounding sphere and publishes
+        /// the textures' current bindless indices in m_Objects
+        void updateTextureResidency(const glm::mat4& viewProjection);
+
+        ///@brief records and submits the frame's work on the async compute queue, fills wait semaphores for the graphics submit
+        void submitAsyncCompute(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages);
+
+        ///@brief dedicated compute family, or the graphics family when it has a second queue, empty when neither exists
+        [[ nodiscard ]] static std::optional<uint32_t> chooseAsyncComputeFamily(const QueueFamilyIndices& indices);
+
+        ///@brief stages streamed assets under the budget, submits pending uploads and fills wait semaphores for the graphics submit
+        void flushUploads(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages);
         // ********HELPER METHODS******** //
 
         ////////////EXTENSION FUNCTIONS////////////
@@ -116,13 +377,21 @@ namespace MyRenderer{
         [[ nodiscard ]] VkResult createVkPhysicalDevice();
         [[ nodiscard ]] VkResult createVkLogicalDevice();
         [[ nodiscard ]] VkResult createVkSwapChain();
+        [[ nodiscard ]] VkResult createVkOffscreenImages();
         [[ nodiscard ]] VkResult createVkSwapChainImageViews();
         [[ nodiscard ]] VkResult createRenderPass();
         [[ nodiscard ]] VkResult createVkGraphicsPipeline();
         [[ nodiscard ]] VkResult createVkFrameBuffers();
         [[ nodiscard ]] VkResult createVkCommandPool();
+        ///@brief sized for the built-in triangle and the scene file's blobs, only the triangle is uploaded, sceneFile may be closed
+        [[ nodiscard ]] VkResult createVkVertexBuffer(const MeshFile& sceneFile);
+        [[ nodiscard ]] VkResult createVkIndexBuffer(const MeshFile& sceneFile);
+
+        ///@brief appends the scene meshes to the draw list and queues their blob ranges on the asset streamer
+        void streamSceneFile(const std::shared_ptr<MeshFile>& sceneFile);
         [[ nodiscard ]] VkResult createVkCommandBuffers();
         [[ nodiscard ]] VkResult createVkSynchronizationObjects();
+        void destroyVkSynchronizationObjects();
 
         ///////////////CALLBACKS///////////////////
         static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
@@ -132,6 +401,7 @@ namespace MyRenderer{
                     void* pUserData
                 );
         static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
+        static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
         ///////////////CALLBACKS///////////////////
     private:
         uint32_t m_Width;
@@ -139,17 +409,17 @@ namespace MyRenderer{
 
         std::string m_Title;
 
-        GLFWwindow* m_Window;
+        GLFWwindow* m_Window = nullptr;
 
         std::vector<const char*> m_ValidationLayers = {
                 "VK_LAYER_KHRONOS_validation"
         };
 
-        std::vector<const char*> m_DeviceExtensions = {
-                VK_KHR_SWAPCHAIN_EXTENSION_NAME
-        };
+        std::vector<const char*> m_DeviceExtensions = {};
 
         std::vector<VkImage> m_SwapChainImages = {};
+        std::vector<VkImage> m_OffscreenImages = {};
+        std::vector<VulkanAllocation> m_OffscreenImageAllocations = {};
         std::vector<VkImageView> m_SwapChainImageViews = {};
         std::vector<VkFramebuffer> m_SwapChainFrameBuffers = {};
 
@@ -160,6 +430,37 @@ namespace MyRenderer{
 #endif
         VulkanInstance* m_VulkanInstance;
         VulkanDebugMessenger* m_VulkanDebugMessenger;
+        VulkanPipelineCache* m_VulkanPipelineCache;
+        VulkanPipelineRegistry* m_VulkanPipelineRegistry;
+        VulkanBindlessDescriptors* m_VulkanBindlessDescriptors;
+        VulkanFrameData* m_VulkanFrameData;
+        ///@brief only created with GPU culling enabled
+        VulkanGpuCuller* m_VulkanGpuCuller = nullptr;
+        ///@brief only created with async compute enabled
+        VulkanAsyncCompute* m_VulkanAsyncCompute = nullptr;
+        ///@brief dynamic offsets of the frame being recorded
+        uint32_t m_FrameUniformOffset = 0;
+        uint32_t m_ObjectTransformOffset = 0;
+        double m_LastFrameTime = 0.0;
+        VulkanMemoryAllocator* m_VulkanMemoryAllocator;
+        VulkanUploader* m_VulkanUploader;
+        AssetStreamer* m_AssetStreamer;
+        VulkanTextureManager* m_VulkanTextureManager;
+        ThreadPool* m_ThreadPool;
+        ///@brief separate from m_ThreadPool, the command recorder waits on that one every frame
+        ThreadPool* m_PipelineCompilePool;
+        VulkanCommandRecorder* m_VulkanCommandRecorder;
+        VulkanProfiler* m_VulkanProfiler;
+        VulkanDeletionQueue* m_VulkanDeletionQueue;
+        RenderGraph* m_RenderGraph = nullptr;
+        ///@brief debug builds with a window only, recompiles edited shaders while running
+        ShaderManager* m_ShaderManager = nullptr;
+        ///@brief swap chain or offscreen image of the frame being recorded
+        RenderGraph::ResourceHandle m_BackBufferResource = 0;
+        ///@brief transient attachments, the multisampled color target only exists with MSAA enabled
+        RenderGraph::ResourceHandle m_ColorResource = 0;
+        RenderGraph::ResourceHandle m_DepthResource = 0;
+        uint32_t m_ImageIndex = 0;
 
         /*Vulkan objects*/
         VkSurfaceKHR m_SurfaceKHR = VK_NULL_HANDLE;
@@ -167,18 +468,68 @@ namespace MyRenderer{
         VkDevice m_LogicalDevice = VK_NULL_HANDLE;
         VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
         VkQueue m_PresentQueue  = VK_NULL_HANDLE;
+        VkQueue m_TransferQueue = VK_NULL_HANDLE;
+        VkQueue m_ComputeQueue = VK_NULL_HANDLE;
         VkSwapchainKHR m_SwapChainKHR = VK_NULL_HANDLE;
         VkFormat m_SwapChainImageFormat = VK_FORMAT_UNDEFINED;
         VkExtent2D m_SwapChainExtent2D{};
         VkRenderPass m_RenderPass{};
         VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
-        VkPipeline m_GraphicsPipeline = VK_NULL_HANDLE;
+        VulkanPipelineRegistry::PipelineHandle m_TrianglePipeline = 0;
+        VulkanPipelineRegistry::PipelineHandle m_InstancedPipeline = 0;
+        ///@brief rebuilt by hot reload, not used by any command buffer until applyReloadedPipelines()
+        std::vector<std::pair<VulkanPipelineRegistry::PipelineHandle, VkPipeline>> m_PendingPipelines = {};
+        std::mutex m_PendingPipelineMutex;
+
+        ///@brief Run() start, time to first frame and pipeline compile time are measured from it
+        std::chrono::steady_clock::time_point m_StartTime{};
         VkCommandPool m_CommandPool = VK_NULL_HANDLE;
         std::vector<VkCommandBuffer> m_CommandBuffers = {};
 
+        const std::vector<Vertex> m_Vertices = {
+                {{0.0f, -0.5f}, {1.0f, 0.0f, 0.0f}, {0.5f, 0.0f}},
+                {{0.5f, 0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
+                {{-0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}
+        };
+        const std::vector<uint32_t> m_Indices = {0, 1, 2};
+
+        std::vector<DrawCommand> m_DrawList = {};
+        ///@brief draws whose geometry finished streaming, streaming completes in draw list order so they are a prefix
+        uint32_t m_ReadyDrawCount = 0;
+        ///@brief model matrices and resource indices, copied into the frame data ring every frame
+        std::vector<ObjectData> m_Objects = {};
+
+        ///@brief recording order of the frame's scene draws and instance batches
+        std::vector<DrawPacket> m_DrawPackets = {};
+        ///@brief scene draws among m_DrawPackets, draw indices from it on are instance batches
+        uint32_t m_PacketSceneDrawCount = 0;
+        ///@brief texture and material buffer index pair to the sort key material id, rebuilt every frame
+        std::unordered_map<uint64_t, uint32_t> m_MaterialIds = {};
+        ///@brief draw command mesh id to the sort key mesh id, rebuilt every frame
+        std::unordered_map<uint32_t, uint32_t> m_MeshIds = {};
+        DrawPacketSorter* m_DrawPacketSorter;
+
+        std::vector<const InstanceBatch*> m_InstanceBatches = {};
+        std::vector<InstanceBatchBinding> m_InstanceBatchBindings = {};
+        ///@brief per-instance vertex data of every frame in flight, grows to the largest frame seen
+        VulkanRingArena* m_InstanceRing = nullptr;
+        VkDeviceSize m_InstanceRingFrameSize = 0;
+
+        VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+        VulkanAllocation m_VertexBufferAllocation{};
+        VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+        VulkanAllocation m_IndexBufferAllocation{};
+
         std::vector<VkSemaphore> m_ImageAvailableSemaphores = {};
         std::vector<VkSemaphore> m_RenderFinishedSemaphores = {};
         std::vector<VkFence> m_InFlightFences = {};
+        ///@brief timeline sync only, reaches value N once frame N completed, other queues can wait on it directly
+        VkSemaphore m_FrameTimelineSemaphore = VK_NULL_HANDLE;
+
+        ///@brief number of frames submitted, the value a frame got is stored for its frame slot
+        uint64_t m_SubmittedFrameCount = 0;
+        uint64_t m_CompletedFrameCount = 0;
+        std::vector<uint64_t> m_FrameSlotSubmissions = {};
     };
 }
 
@@ -0,0 +1,197 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_RENDERGRAPH_H
+#define VULKANRENDERER_RENDERGRAPH_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "VulkanMemoryAllocator.h"
+
+///@brief frame graph of passes which declare the images they read and write
+///@details Compile() only works on the declarations (no Vulkan calls), so the culled passes, barrier lists and alias slots
+/// can be inspected without a device. Realize() creates the transient images, Execute() records barriers and passes.
+/// Images only used as attachments are created TRANSIENT_ATTACHMENT and backed by lazily allocated memory where the
+/// device has it (tile based GPUs never commit it), everything else shares memory through alias slots.
+class RenderGraph {
+public:
+    using ResourceHandle = uint32_t;
+    using ExecuteFunction = std::function<void(VkCommandBuffer commandBuffer)>;
+
+    ///@brief how a pass uses an image, selects pipeline stage, access mask, layout and image usage
+    enum class AccessType {
+        None,
+        ColorAttachmentWrite,
+        DepthStencilAttachmentWrite,
+        DepthStencilAttachmentRead,
+        FragmentShaderRead,
+        ComputeShaderRead,
+        ComputeShaderWrite,
+        TransferRead,
+        TransferWrite,
+        Present
+    };
+
+    ///@brief image owned by the graph, only lives between its first and last use and may share memory with others
+    struct ImageDescription {
+        VkFormat format;
+        VkExtent2D extent;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+        VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    };
+
+    ///@brief image owned outside of the graph (swap chain, offscreen target), set every frame with SetImportedImage()
+    struct ImportDescription {
+        VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+        VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        ///@brief stage the image is available at when the frame starts, e.g. the stage the acquire semaphore is waited on
+        VkPipelineStageFlags initialStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        ///@brief state the image is left in, anything but None marks it as graph output
+        AccessType finalAccess = AccessType::None;
+    };
+
+    struct ImageBarrier {
+        ResourceHandle resource;
+        VkPipelineStageFlags srcStage;
+        VkPipelineStageFlags dstStage;
+        VkAccessFlags srcAccess;
+        VkAccessFlags dstAccess;
+        VkImageLayout oldLayout;
+        VkImageLayout newLayout;
+    };
+
+    ///@brief live pass in execution order with the barriers recorded right before it
+    struct CompiledPass {
+        uint32_t pass;
+        std::vector<ImageBarrier> barriers;
+    };
+
+    RenderGraph() = default;
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    [[ nodiscard ]] ResourceHandle CreateImage(const std::string& name, const ImageDescription& imageDescription);
+    [[ nodiscard ]] ResourceHandle ImportImage(const std::string& name, const ImportDescription& importDescription);
+    void SetImportedImage(ResourceHandle resource, VkImage image, VkImageView imageView);
+
+    ///@param hasSideEffects pass is never culled, even if nothing reads what it writes
+    [[ nodiscard ]] uint32_t AddPass(const std::string& name, ExecuteFunction execute, bool hasSideEffects = false);
+    void Read(uint32_t pass, ResourceHandle resource, AccessType accessType);
+    void Write(uint32_t pass, ResourceHandle resource, AccessType accessType);
+
+    ///@brief culls passes which do not contribute to an output, schedules barriers and assigns alias slots
+    void Compile();
+
+    ///@brief creates transient images, images sharing an alias slot are bound to the same memory
+    ///@details attachment-only images leave their alias slot when lazily allocated memory is available
+    void Realize(VulkanMemoryAllocator* allocator);
+
+    ///@brief records every live pass with its barriers, followed by the transitions into the final import states
+    void Execute(VkCommandBuffer commandBuffer) const;
+
+    [[ nodiscard ]] const std::vector<CompiledPass>& GetCompiledPasses() const { return m_CompiledPasses; }
+    [[ nodiscard ]] const std::vector<ImageBarrier>& GetFinalBarriers() const { return m_FinalBarriers; }
+    [[ nodiscard ]] bool IsPassCulled(uint32_t pass) const { return m_Passes.at(pass).culled; }
+    ///@brief UINT32_MAX for imported images
+    [[ nodiscard ]] uint32_t GetAliasSlot(ResourceHandle resource) const { return m_Resources.at(resource).aliasSlot; }
+    [[ nodiscard ]] uint32_t GetAliasSlotCount() const { return static_cast<uint32_t>(m_AliasSlots.size()); }
+    [[ nodiscard ]] bool IsLazilyAllocated(ResourceHandle resource) const { return m_Resources.at(resource).lazilyAllocated; }
+    [[ nodiscard ]] VkImage GetImage(ResourceHandle resource) const { return m_Resources.at(resource).image; }
+    [[ nodiscard ]] VkImageView GetImageView(ResourceHandle resource) const { return m_Resources.at(resource).imageView; }
+    [[ nodiscard ]] const std::string& GetName(ResourceHandle resource) const { return m_Resources.at(resource).name; }
+private:
+    struct AccessInfo {
+        VkPipelineStageFlags stage;
+        VkAccessFlags access;
+        VkImageLayout layout;
+        VkImageUsageFlags usage;
+        bool write;
+    };
+
+    struct ResourceAccess {
+        ResourceHandle resource;
+        VkPipelineStageFlags stage;
+        VkAccessFlags access;
+        VkImageLayout layout;
+        bool write;
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteFunction execute;
+        bool hasSideEffects;
+        std::vector<ResourceAccess> accesses;
+        bool culled = false;
+    };
+
+    struct Resource {
+        std::string name;
+        bool imported;
+        ImageDescription description{};
+        ImportDescription importDescription{};
+        VkImageUsageFlags usage = 0;
+
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView imageView = VK_NULL_HANDLE;
+
+        ///@brief first and last live pass using the image, UINT32_MAX when unused
+        uint32_t firstPass = UINT32_MAX;
+        uint32_t lastPass = UINT32_MAX;
+        uint32_t aliasSlot = UINT32_MAX;
+
+        ///@brief own allocation of a lazily allocated image, aliased images use the allocation of their slot
+        bool lazilyAllocated = false;
+        VulkanAllocation allocation{};
+    };
+
+    ///@brief synchronization state of a resource while walking the live passes
+    struct ResourceState {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags writeStage = 0;
+        VkAccessFlags writeAccess = 0;
+        ///@brief stages which read since the last write, a later write has to wait for them
+        VkPipelineStageFlags readStages = 0;
+        ///@brief stages the last write was already made visible to
+        VkPipelineStageFlags visibleStages = 0;
+    };
+
+    struct AliasSlot {
+        std::vector<ResourceHandle> resources;
+        VulkanAllocation allocation{};
+        ///@brief stages and writes of the previous image in the slot, the next one has to wait for them
+        VkPipelineStageFlags lastStages = 0;
+        VkAccessFlags lastWriteAccess = 0;
+    };
+
+    static AccessInfo getAccessInfo(AccessType accessType);
+    void addAccess(uint32_t pass, ResourceHandle resource, AccessType accessType, bool write);
+
+    void cullPasses();
+    void assignAliasSlots();
+    void scheduleBarriers();
+
+    void destroyImages();
+
+    ///@brief memory type with LAZILY_ALLOCATED in typeFilter, UINT32_MAX when the device has none
+    [[ nodiscard ]] uint32_t findLazilyAllocatedMemoryType(uint32_t typeFilter) const;
+    [[ nodiscard ]] static bool isAttachmentOnly(VkImageUsageFlags usage);
+
+    std::vector<Pass> m_Passes;
+    std::vector<Resource> m_Resources;
+    std::vector<AliasSlot> m_AliasSlots;
+
+    std::vector<CompiledPass> m_CompiledPasses;
+    std::vector<ImageBarrier> m_FinalBarriers;
+
+    VulkanMemoryAllocator* m_Allocator = nullptr;
+};
+
+#endif //VULKANRENDERER_RENDERGRAPH_H
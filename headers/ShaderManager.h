@@ -0,0 +1,54 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_SHADERMANAGER_H
+#define VULKANRENDERER_SHADERMANAGER_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+///@brief watches the GLSL sources and recompiles changed shaders to SPIR-V on a background thread
+///@details uses inotify, so hot reload is only available on Linux. Binaries are written next to the ones built by CMake
+/// (<output directory>/<shader>.bin) and replaced atomically, a failed compile keeps the previous binary.
+class ShaderManager {
+public:
+    ///@brief called on the watcher thread with the names (e.g. "triangle.frag") of the shaders which compiled
+    using ReloadFunction = std::function<void(const std::vector<std::string>& shaderNames)>;
+
+    ShaderManager(std::string sourceDirectory, std::string outputDirectory, std::string compilerPath);
+    ~ShaderManager();
+
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+
+    ///@brief starts watching, returns false if the source directory can not be watched
+    bool Start(ReloadFunction reloadFunction);
+    void Stop();
+
+    [[ nodiscard ]] bool IsRunning() const { return m_Thread.joinable(); }
+private:
+    void watchLoop();
+
+    ///@brief drains pending inotify events, adds names of changed files
+    void readEvents(std::vector<std::string>& changedFiles) const;
+    bool compileShader(const std::string& shaderName) const;
+
+    [[ nodiscard ]] static bool isShaderStage(const std::string& fileName);
+    [[ nodiscard ]] std::vector<std::string> listShaderStages() const;
+
+    std::string m_SourceDirectory;
+    std::string m_OutputDirectory;
+    std::string m_CompilerPath;
+
+    ReloadFunction m_ReloadFunction;
+
+    int m_InotifyDescriptor = -1;
+    std::thread m_Thread;
+    std::atomic<bool> m_Stopping{false};
+};
+
+#endif //VULKANRENDERER_SHADERMANAGER_H
@@ -0,0 +1,104 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_TEXTUREFILE_H
+#define VULKANRENDERER_TEXTUREFILE_H
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+///@brief KTX2 file header, followed by the index and the level index
+struct TextureFileHeader {
+    static constexpr unsigned char IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    unsigned char identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    ///@brief 0 asks the loader to generate the mip chain from level 0
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+///@brief level index entry, entry 0 is the full resolution level
+struct TextureFileLevel {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+///@brief texel block of a format, 1x1 with the texel size for uncompressed formats
+struct TextureFormatInfo {
+    uint32_t blockWidth = 1;
+    uint32_t blockHeight = 1;
+    uint32_t blockSize = 4;
+    bool srgb = false;
+};
+
+///@brief read-only view of a 2D .ktx2 texture, memory mapped where the platform allows it
+///@details levels are stored as tightly packed rows of texel blocks, the layout VulkanUploader copies from, so stored
+/// levels are uploaded straight from the mapping. Files without a mip chain get one generated on the CPU the first time
+/// a smaller level is asked for. BC1 - BC3 levels can be decoded to RGBA8 for devices without BC support.
+/// Reading levels from several threads is safe.
+class TextureFile {
+public:
+    ///@brief maps the file and validates header and level index against the file size, throws on malformed
+    /// or unsupported files (supercompression, arrays, cube maps, 3D textures, formats outside the table)
+    void Open(const std::string& path);
+    void Close();
+
+    [[ nodiscard ]] VkFormat GetFormat() const { return m_Format; }
+    [[ nodiscard ]] const TextureFormatInfo& GetFormatInfo() const { return m_FormatInfo; }
+    [[ nodiscard ]] uint32_t GetWidth() const { return m_Header ? m_Header->pixelWidth : 0; }
+    [[ nodiscard ]] uint32_t GetHeight() const { return m_Header ? m_Header->pixelHeight : 0; }
+    ///@brief stored and generated levels
+    [[ nodiscard ]] uint32_t GetLevelCount() const { return m_LevelCount; }
+
+    [[ nodiscard ]] VkExtent2D GetLevelExtent(uint32_t level) const;
+    [[ nodiscard ]] size_t GetLevelSize(uint32_t level) const;
+    ///@brief points into the mapping or into the generated chain, valid while the file is open
+    [[ nodiscard ]] const char* GetLevelData(uint32_t level) const;
+
+    ///@brief decodes a BC1, BC2 or BC3 level to RGBA8 rows
+    [[ nodiscard ]] std::vector<char> DecodeLevel(uint32_t level) const;
+
+    ///@brief false for formats outside the table
+    static bool GetFormatInfo(VkFormat format, TextureFormatInfo& info);
+    ///@brief RGBA8 format DecodeLevel() produces for the format, VK_FORMAT_UNDEFINED when it can not be decoded
+    static VkFormat GetDecodedFormat(VkFormat format);
+private:
+    void validate(const std::string& path);
+    void generateLevels() const;
+
+    MappedFile m_File;
+    const TextureFileHeader* m_Header = nullptr;
+    const TextureFileLevel* m_Levels = nullptr;
+    VkFormat m_Format = VK_FORMAT_UNDEFINED;
+    TextureFormatInfo m_FormatInfo{};
+    uint32_t m_LevelCount = 0;
+
+    ///@brief levels 1.. of a file stored without a mip chain, built once on first access
+    mutable std::mutex m_GenerateMutex;
+    mutable bool m_Generated = false;
+    mutable std::vector<std::vector<char>> m_GeneratedLevels;
+};
+
+#endif //VULKANRENDERER_TEXTUREFILE_H
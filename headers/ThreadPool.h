@@ -0,0 +1,49 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_THREADPOOL_H
+#define VULKANRENDERER_THREADPOOL_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+///@brief fixed set of worker threads executing jobs from a shared queue
+///@details first exception thrown by a job is kept and rethrown from Wait()
+class ThreadPool {
+public:
+    ///@param threadCount number of workers, 0 picks hardware concurrency
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> job);
+
+    ///@brief blocks until every submitted job has finished
+    void Wait();
+
+    [[ nodiscard ]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_Threads;
+    std::queue<std::function<void()>> m_Jobs;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_JobAvailable;
+    std::condition_variable m_JobsFinished;
+
+    uint32_t m_ActiveJobs = 0;
+    bool m_Stopping = false;
+    std::exception_ptr m_Exception;
+};
+
+#endif //VULKANRENDERER_THREADPOOL_H
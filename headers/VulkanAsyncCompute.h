@@ -0,0 +1,103 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANASYNCCOMPUTE_H
+#define VULKANRENDERER_VULKANASYNCCOMPUTE_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+///@brief submits compute work to a separate queue so it overlaps with the graphics queue
+///@details every frame slot owns a command buffer, a fence and a semaphore signalled by Submit(), the graphics submit
+/// of the same frame waits on it. When the compute queue belongs to another family, buffers change ownership with
+/// release barriers recorded here and acquire barriers recorded by RecordAcquireBarriers(), same as VulkanUploader.
+/// Handing buffers the other way, ReleaseToCompute() records the release into a graphics command buffer and the next
+/// Submit() waits on the semaphore the graphics submit signals for it.
+class VulkanAsyncCompute {
+public:
+    using RecordFunction = std::function<void(VkCommandBuffer)>;
+
+    struct WaitSemaphore {
+        VkSemaphore semaphore;
+        VkPipelineStageFlags stageMask;
+    };
+
+    ///@brief buffer range changing queues, access masks are the last access before and the first access after the transfer
+    struct BufferTransfer {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        VkAccessFlags srcAccessMask;
+        VkAccessFlags dstAccessMask;
+    };
+
+    VulkanAsyncCompute() = default;
+    ~VulkanAsyncCompute();
+
+    VulkanAsyncCompute(const VulkanAsyncCompute&) = delete;
+    VulkanAsyncCompute& operator=(const VulkanAsyncCompute&) = delete;
+
+    void Create(VkDevice device, VkQueue computeQueue, uint32_t computeFamily, uint32_t graphicsFamily, uint32_t framesInFlight);
+
+    ///@brief recreates the per-slot objects, GPU has to be idle
+    void SetFramesInFlight(uint32_t framesInFlight);
+
+    ///@brief records and submits compute work for frameSlot, the next graphics submit has to wait on TakeWaitSemaphores()
+    ///@param releaseToGraphics buffers written by the work and read by the graphics queue afterwards
+    ///@param graphicsWaitStage first graphics stage reading the results
+    void Submit(uint32_t frameSlot, const RecordFunction& record, const std::vector<BufferTransfer>& releaseToGraphics,
+                VkPipelineStageFlags graphicsWaitStage);
+
+    ///@brief records queue family acquire barriers for the last Submit(), into the graphics submit waiting on it
+    void RecordAcquireBarriers(VkCommandBuffer commandBuffer);
+
+    ///@brief semaphores the next graphics submit has to wait on, the list is cleared
+    [[ nodiscard ]] std::vector<WaitSemaphore> TakeWaitSemaphores();
+
+    ///@brief hands buffers written by the graphics queue to the compute queue
+    ///@details recorded into a graphics command buffer, its submit has to signal TakeSignalSemaphore()
+    void ReleaseToCompute(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer>& transfers,
+                          VkPipelineStageFlags graphicsSrcStage, VkPipelineStageFlags computeDstStage);
+
+    ///@brief semaphore the next graphics submit has to signal, VK_NULL_HANDLE when nothing was released to compute
+    [[ nodiscard ]] VkSemaphore TakeSignalSemaphore();
+
+    [[ nodiscard ]] bool IsSameFamily() const { return m_ComputeFamily == m_GraphicsFamily; }
+private:
+    struct FrameSlot {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+    };
+
+    void createFrameSlots(uint32_t framesInFlight);
+    void destroyFrameSlots();
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkQueue m_ComputeQueue = VK_NULL_HANDLE;
+    uint32_t m_ComputeFamily = 0;
+    uint32_t m_GraphicsFamily = 0;
+
+    VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+    std::vector<FrameSlot> m_FrameSlots;
+
+    std::vector<VkBufferMemoryBarrier> m_PendingAcquireBarriers;
+    VkPipelineStageFlags m_PendingAcquireStageMask = 0;
+    std::vector<WaitSemaphore> m_PendingWaitSemaphores;
+
+    ///@brief graphics to compute handoff, released by a graphics submit and acquired by the next Submit()
+    VkSemaphore m_HandoffSemaphore = VK_NULL_HANDLE;
+    bool m_HandoffRecorded = false;
+    bool m_HandoffSignalled = false;
+    ///@brief acquires of releases not yet covered by a signal, and of the ones the next Submit() waits for
+    std::vector<VkBufferMemoryBarrier> m_RecordedHandoffBarriers;
+    VkPipelineStageFlags m_RecordedHandoffStageMask = 0;
+    std::vector<VkBufferMemoryBarrier> m_SignalledHandoffBarriers;
+    VkPipelineStageFlags m_SignalledHandoffStageMask = 0;
+};
+
+#endif //VULKANRENDERER_VULKANASYNCCOMPUTE_H
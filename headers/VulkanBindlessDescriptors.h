@@ -0,0 +1,80 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANBINDLESSDESCRIPTORS_H
+#define VULKANRENDERER_VULKANBINDLESSDESCRIPTORS_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+///@brief single global descriptor set with update-after-bind arrays of sampled images and storage buffers
+///@details resources are registered once and addressed by index from shaders (push constants or instance data),
+/// the set is bound once per command buffer. Slots are only written while free, so updates never touch a descriptor
+/// a frame in flight may read; removing a resource still in use has to be deferred until the GPU finished with it.
+/// Matches shaders/bindless.glsl.
+class VulkanBindlessDescriptors {
+public:
+    static constexpr uint32_t SAMPLED_IMAGE_BINDING = 0;
+    static constexpr uint32_t STORAGE_BUFFER_BINDING = 1;
+    ///@brief index of "no resource", shaders test for it
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    ///@brief requested array sizes, clamped to the update-after-bind limits of the device in Create()
+    VulkanBindlessDescriptors(uint32_t maxSampledImages, uint32_t maxStorageBuffers);
+    ~VulkanBindlessDescriptors();
+
+    VulkanBindlessDescriptors(const VulkanBindlessDescriptors&) = delete;
+    VulkanBindlessDescriptors& operator=(const VulkanBindlessDescriptors&) = delete;
+
+    ///@brief checks the Vulkan 1.2 descriptor indexing features the set relies on
+    [[ nodiscard ]] static bool CheckSupport(VkPhysicalDevice physicalDevice);
+
+    ///@brief fills the descriptor indexing features the set needs, to be chained into device creation
+    static void EnableFeatures(VkPhysicalDeviceVulkan12Features& vulkan12Features);
+
+    void Create(VkPhysicalDevice physicalDevice, VkDevice device);
+
+    ///@brief writes the image into a free slot, may be called from any thread
+    [[ nodiscard ]] uint32_t AddSampledImage(VkImageView imageView, VkSampler sampler,
+                                             VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    [[ nodiscard ]] uint32_t AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+    ///@brief returns the slot for reuse, no frame in flight may still read it
+    void RemoveSampledImage(uint32_t index);
+    void RemoveStorageBuffer(uint32_t index);
+
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t set = 0) const;
+
+    [[ nodiscard ]] uint32_t GetSampledImageCapacity() const { return m_SampledImageSlots.GetCapacity(); }
+    [[ nodiscard ]] uint32_t GetStorageBufferCapacity() const { return m_StorageBufferSlots.GetCapacity(); }
+
+    VkDescriptorSetLayout DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+private:
+    ///@brief hands out array indices, freed indices are reused first to keep the used range dense
+    class SlotAllocator {
+    public:
+        void SetCapacity(uint32_t capacity) { m_Capacity = capacity; }
+        [[ nodiscard ]] uint32_t GetCapacity() const { return m_Capacity; }
+
+        [[ nodiscard ]] uint32_t Allocate();
+        void Free(uint32_t index);
+    private:
+        uint32_t m_Capacity = 0;
+        uint32_t m_NextSlot = 0;
+        std::vector<uint32_t> m_FreeSlots;
+    };
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+
+    SlotAllocator m_SampledImageSlots;
+    SlotAllocator m_StorageBufferSlots;
+    std::mutex m_Mutex;
+};
+
+#endif //VULKANRENDERER_VULKANBINDLESSDESCRIPTORS_H
@@ -0,0 +1,58 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANCOMMANDRECORDER_H
+#define VULKANRENDERER_VULKANCOMMANDRECORDER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <functional>
+
+#include "ThreadPool.h"
+
+///@brief records slices of a draw list into secondary command buffers on worker threads
+///@details every worker slot owns one command pool per frame in flight, pools are reset as a whole
+/// once the frame fence was waited on, so workers never share a pool and no locking is needed
+class VulkanCommandRecorder {
+public:
+    ///@brief records draws [firstDraw, firstDraw + drawCount) into a secondary buffer which inherits the render pass
+    using RecordFunction = std::function<void(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t drawCount)>;
+
+    explicit VulkanCommandRecorder(ThreadPool* threadPool) : m_ThreadPool(threadPool) {};
+    ~VulkanCommandRecorder();
+
+    void Create(VkDevice device, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+
+    ///@brief adds or removes per-frame command pools, pools of removed frames must not be in use by the GPU
+    void SetFramesInFlight(uint32_t framesInFlight);
+
+    ///@brief splits the draw list between workers and executes the recorded buffers in primaryCommandBuffer
+    ///@details primaryCommandBuffer has to be inside a render pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    void Record(uint32_t frameIndex, VkCommandBuffer primaryCommandBuffer,
+                VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer,
+                uint32_t drawCount, const RecordFunction& recordFunction);
+private:
+    struct WorkerContext {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    };
+
+    ///@brief below this many draws per slice the job overhead outweighs parallel recording
+    static constexpr uint32_t MIN_DRAWS_PER_JOB = 256;
+
+    void recordSlice(WorkerContext& workerContext, const VkCommandBufferInheritanceInfo& inheritanceInfo,
+                     uint32_t firstDraw, uint32_t drawCount, const RecordFunction& recordFunction);
+
+    ThreadPool* m_ThreadPool;
+    VkDevice m_Device = VK_NULL_HANDLE;
+    uint32_t m_QueueFamilyIndex = 0;
+
+    ///@brief indexed [frame in flight][worker]
+    std::vector<std::vector<WorkerContext>> m_FrameContexts;
+    std::vector<VkCommandBuffer> m_ExecuteBuffers;
+};
+
+#endif //VULKANRENDERER_VULKANCOMMANDRECORDER_H
@@ -0,0 +1,46 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANDELETIONQUEUE_H
+#define VULKANRENDERER_VULKANDELETIONQUEUE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+///@brief destroys resources once the GPU finished every frame that could still use them
+///@details frames are numbered by submission, a deleter pushed with frame N runs in Collect() once frame N completed
+/// (its frame fence or timeline value signalled). Push() may be called from any thread.
+class VulkanDeletionQueue {
+public:
+    using Deleter = std::function<void()>;
+
+    VulkanDeletionQueue() = default;
+    ~VulkanDeletionQueue();
+
+    VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+    VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+
+    ///@brief queues deleter until frame lastUsedFrame completed
+    void Push(uint64_t lastUsedFrame, Deleter deleter);
+
+    ///@brief runs deleters of every frame up to and including completedFrame, in push order
+    void Collect(uint64_t completedFrame);
+
+    ///@brief runs every queued deleter, device has to be idle
+    void Flush();
+
+    [[ nodiscard ]] size_t GetPendingCount();
+private:
+    struct Entry {
+        uint64_t lastUsedFrame;
+        Deleter deleter;
+    };
+
+    std::vector<Entry> m_Entries;
+    std::mutex m_Mutex;
+};
+
+#endif //VULKANRENDERER_VULKANDELETIONQUEUE_H
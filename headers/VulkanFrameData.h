@@ -0,0 +1,74 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANFRAMEDATA_H
+#define VULKANRENDERER_VULKANFRAMEDATA_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "VulkanMemoryAllocator.h"
+
+///@brief per-frame uniform and storage data written into a ring buffer and addressed with dynamic offsets
+///@details the descriptor set is written once, every frame only copies its data into the ring and binds the set with
+/// new dynamic offsets, so there are no allocations or descriptor writes per frame. Dynamic descriptors can not live in
+/// the update-after-bind bindless set, so this is a separate set. Matches shaders/frame.glsl.
+class VulkanFrameData {
+public:
+    static constexpr uint32_t UNIFORM_BINDING = 0;
+    static constexpr uint32_t STORAGE_BINDING = 1;
+
+    ///@param frameSize bytes each frame in flight may push
+    ///@param uniformRange size of the uniform block, every PushUniform() has to match it
+    VulkanFrameData(VulkanMemoryAllocator* allocator, VkDeviceSize frameSize, VkDeviceSize uniformRange);
+    ~VulkanFrameData();
+
+    VulkanFrameData(const VulkanFrameData&) = delete;
+    VulkanFrameData& operator=(const VulkanFrameData&) = delete;
+
+    ///@param queueFamilies every family reading the frame data, the ring is shared concurrently when there is more than one
+    void Create(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t framesInFlight, const std::vector<uint32_t>& queueFamilies = {});
+
+    ///@brief recreates the ring for a new frame in flight count, GPU has to be idle
+    void Resize(uint32_t framesInFlight);
+
+    ///@brief releases what frameSlot pushed last time, its previous frame has to be complete
+    void BeginFrame(uint32_t frameSlot);
+
+    ///@brief copies the uniform block into the ring, returns its dynamic offset
+    [[ nodiscard ]] uint32_t PushUniform(const void* data, VkDeviceSize size);
+
+    ///@brief copies an array into the ring, returns its dynamic offset, shaders see it from the offset to the end of the ring
+    [[ nodiscard ]] uint32_t PushStorage(const void* data, VkDeviceSize size);
+
+    template<typename T>
+    [[ nodiscard ]] uint32_t PushUniform(const T& data) { return PushUniform(&data, sizeof(T)); }
+
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t set,
+              uint32_t uniformOffset, uint32_t storageOffset) const;
+
+    VkDescriptorSetLayout DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+private:
+    ///@brief bump allocation in the ring with a copy, throws when the frame pushed more than the ring holds
+    [[ nodiscard ]] uint32_t push(const void* data, VkDeviceSize size, VkDeviceSize alignment);
+    void writeDescriptorSet();
+
+    VulkanMemoryAllocator* m_Allocator;
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+
+    std::unique_ptr<VulkanRingArena> m_Ring;
+    std::vector<uint32_t> m_QueueFamilies;
+    VkDeviceSize m_FrameSize;
+    VkDeviceSize m_UniformRange;
+
+    VkDeviceSize m_UniformAlignment = 256;
+    VkDeviceSize m_StorageAlignment = 256;
+};
+
+#endif //VULKANRENDERER_VULKANFRAMEDATA_H
@@ -0,0 +1,122 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANGPUCULLER_H
+#define VULKANRENDERER_VULKANGPUCULLER_H
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "VulkanMemoryAllocator.h"
+#include "VulkanUploader.h"
+#include "VulkanFrameData.h"
+#include "VulkanAsyncCompute.h"
+
+///@brief GPU-driven draw submission, a compute pass frustum culls the instance list into indirect draw commands
+///@details the instance list lives in a device-local storage buffer, RecordCulling() writes the visible instances as
+/// VkDrawIndexedIndirectCommand plus a draw count, RecordDraws() consumes them with one vkCmdDrawIndexedIndirectCount.
+/// Every frame in flight has its own command and count region, so culling never waits for the previous frame's draws.
+/// CPU cost per frame does not depend on the instance count. Matches shaders/cull.comp.
+class VulkanGpuCuller {
+public:
+    ///@brief one culled draw, std430 layout of CullInstance in shaders/cull.comp
+    struct Instance {
+        ///@brief object space bounding sphere, xyz - center, w - radius
+        glm::vec4 boundingSphere;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        ///@brief index into the object transforms of the frame data, passed to the draw as firstInstance
+        uint32_t transformIndex;
+    };
+
+    VulkanGpuCuller(VulkanMemoryAllocator* allocator, VulkanUploader* uploader) : m_Allocator(allocator), m_Uploader(uploader) {};
+    ~VulkanGpuCuller();
+
+    VulkanGpuCuller(const VulkanGpuCuller&) = delete;
+    VulkanGpuCuller& operator=(const VulkanGpuCuller&) = delete;
+
+    ///@brief indirect count draws and multi draw indirect
+    [[ nodiscard ]] static bool CheckSupport(VkPhysicalDevice physicalDevice);
+    static void EnableFeatures(VkPhysicalDeviceFeatures& physicalDeviceFeatures, VkPhysicalDeviceVulkan12Features& vulkan12Features);
+
+    ///@param frameDataSetLayout culling reads the object transforms and frustum planes from the frame data (set 1)
+    ///@param shaderCode SPIR-V of shaders/cull.comp
+    void Create(VkDevice device, VkPipelineCache pipelineCache, VkDescriptorSetLayout frameDataSetLayout,
+                const std::vector<char>& shaderCode, uint32_t framesInFlight);
+
+    ///@brief uploads the instance list, before the first frame or with the GPU idle
+    void SetInstances(const std::vector<Instance>& instances);
+
+    ///@brief culls only the first count instances, the rest is skipped without touching the instance buffer
+    ///@details lets streamed meshes join the draw list as their data arrives, clamped to the instance count
+    void SetActiveInstanceCount(uint32_t count) { m_ActiveInstanceCount = std::min(count, m_InstanceCount); }
+
+    ///@brief recreates the per-frame command regions, GPU has to be idle
+    void Resize(uint32_t framesInFlight);
+
+    ///@brief resets the draw count, culls and makes the commands visible to indirect draws, outside of a render pass
+    void RecordCulling(VkCommandBuffer commandBuffer, uint32_t frameSlot, const VulkanFrameData* frameData,
+                       uint32_t uniformOffset, uint32_t transformOffset) const;
+
+    ///@brief resets the draw count without culling, the slot draws nothing
+    ///@details used on the async compute queue until the instance buffer was handed over to it
+    void RecordSkip(VkCommandBuffer commandBuffer, uint32_t frameSlot) const;
+
+    ///@brief draws the visible instances with the bound graphics state
+    void RecordDraws(VkCommandBuffer commandBuffer, uint32_t frameSlot) const;
+
+    ///@brief the slot's command and count regions, written by culling and read by the indirect draw
+    [[ nodiscard ]] std::vector<VulkanAsyncCompute::BufferTransfer> GetDrawTransfers(uint32_t frameSlot) const;
+
+    ///@brief the instance buffer after its upload, read by culling
+    [[ nodiscard ]] VulkanAsyncCompute::BufferTransfer GetInstanceTransfer() const;
+
+    [[ nodiscard ]] uint32_t GetInstanceCount() const { return m_InstanceCount; }
+private:
+    ///@brief layout matches the push_constant block in shaders/cull.comp
+    struct CullPushConstants {
+        uint32_t instanceCount;
+        uint32_t drawOffset;
+        uint32_t countIndex;
+    };
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    void recordReset(VkCommandBuffer commandBuffer, uint32_t frameSlot) const;
+    void recordDrawBarrier(VkCommandBuffer commandBuffer, uint32_t frameSlot) const;
+
+    void createDrawBuffers(uint32_t framesInFlight);
+    void destroyDrawBuffers();
+    void writeDescriptorSet();
+
+    VulkanMemoryAllocator* m_Allocator;
+    VulkanUploader* m_Uploader;
+    VkDevice m_Device = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+    VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+    VkPipeline m_Pipeline = VK_NULL_HANDLE;
+
+    VkBuffer m_InstanceBuffer = VK_NULL_HANDLE;
+    VulkanAllocation m_InstanceBufferAllocation{};
+    uint32_t m_InstanceCount = 0;
+    uint32_t m_ActiveInstanceCount = 0;
+
+    ///@brief framesInFlight regions of m_InstanceCount commands and one count each
+    VkBuffer m_DrawCommandBuffer = VK_NULL_HANDLE;
+    VulkanAllocation m_DrawCommandBufferAllocation{};
+    VkBuffer m_DrawCountBuffer = VK_NULL_HANDLE;
+    VulkanAllocation m_DrawCountBufferAllocation{};
+    uint32_t m_FramesInFlight = 0;
+};
+
+#endif //VULKANRENDERER_VULKANGPUCULLER_H
@@ -26,6 +26,10 @@ public:
     void SetAppName(const std::string &name);
     void SetEngineName(const std::string &name);
 
+    ///@brief highest Vulkan version the application uses, has to be set before Create()
+    void SetApiVersion(uint32_t apiVersion);
+    [[ nodiscard ]] uint32_t GetApiVersion() const { return m_ApiVersion; }
+
     void AddExtensions(const std::vector<const char*>& extensions);
     void AddValidationLayers(const std::vector<const char*>& layers);
 
@@ -35,6 +39,7 @@ private:
 
     std::string m_EngineName = "Default";
     std::string m_AppName = "Default";
+    uint32_t m_ApiVersion = VK_API_VERSION_1_0;
 
     std::vector<const char*> m_Extensions;
     std::vector<const char*> m_ValidationLayers;
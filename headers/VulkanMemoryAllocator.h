@@ -0,0 +1,160 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANMEMORYALLOCATOR_H
+#define VULKANRENDERER_VULKANMEMORYALLOCATOR_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <iostream>
+
+class VulkanMemoryBlock;
+
+///@brief sub-allocation of a VkDeviceMemory block, bind resources with memory + offset
+struct VulkanAllocation {
+    VkDeviceMemory Memory = VK_NULL_HANDLE;
+    VkDeviceSize Offset = 0;
+    VkDeviceSize Size = 0;
+    uint32_t MemoryTypeIndex = 0;
+    ///@brief persistently mapped pointer, nullptr for memory which is not host visible
+    void* MappedData = nullptr;
+
+    VulkanMemoryBlock* Block = nullptr;
+    uint32_t Order = 0;
+};
+
+///@brief one large VkDeviceMemory split with a buddy allocator
+class VulkanMemoryBlock {
+public:
+    VulkanMemoryBlock(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, void* mappedData);
+
+    [[ nodiscard ]] bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation& allocation);
+    void Free(const VulkanAllocation& allocation);
+
+    [[ nodiscard ]] bool IsEmpty() const { return m_UsedSize == 0; }
+
+    VkDeviceMemory Memory;
+    VkDeviceSize Size;
+    uint32_t MemoryTypeIndex;
+    void* MappedData;
+    ///@brief index into allocator pools, UINT32_MAX for dedicated allocations
+    uint32_t PoolIndex = UINT32_MAX;
+private:
+    static constexpr uint32_t MIN_ORDER = 8; // 256 bytes
+
+    [[ nodiscard ]] VkDeviceSize orderSize(uint32_t order) const { return VkDeviceSize(1) << (order + MIN_ORDER); }
+
+    std::vector<std::unordered_set<VkDeviceSize>> m_FreeLists;
+    VkDeviceSize m_UsedSize = 0;
+};
+
+///@brief per memory type block pools for long-lived resources and ring arenas for per-frame data
+///@details buffers and optimal tiling images never share a block, so bufferImageGranularity can be ignored
+class VulkanMemoryAllocator {
+public:
+    enum class ResourceType { Linear = 0, Optimal = 1 };
+
+    struct HeapStatistics {
+        VkDeviceSize heapSize = 0;
+        VkDeviceSize blockBytes = 0;
+        VkDeviceSize usedBytes = 0;
+        uint32_t blockCount = 0;
+        uint32_t allocationCount = 0;
+    };
+
+    VulkanMemoryAllocator() = default;
+    ~VulkanMemoryAllocator();
+
+    void Create(VkPhysicalDevice physicalDevice, VkDevice device);
+
+    [[ nodiscard ]] VulkanAllocation Allocate(const VkMemoryRequirements& memoryRequirements,
+                                              VkMemoryPropertyFlags properties, ResourceType resourceType);
+    void Free(VulkanAllocation& allocation);
+
+    ///@brief allocates a VkDeviceMemory which is not shared with other resources
+    [[ nodiscard ]] VulkanAllocation AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex);
+
+    ///@param queueFamilies more than one family creates a concurrently shared buffer, no ownership transfers between them
+    void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                      VkBuffer& buffer, VulkanAllocation& allocation, const std::vector<uint32_t>& queueFamilies = {});
+    void DestroyBuffer(VkBuffer& buffer, VulkanAllocation& allocation);
+
+    void CreateImage(const VkImageCreateInfo& imageCreateInfo, VkMemoryPropertyFlags properties,
+                     VkImage& image, VulkanAllocation& allocation);
+    void DestroyImage(VkImage& image, VulkanAllocation& allocation);
+
+    [[ nodiscard ]] uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+    [[ nodiscard ]] std::vector<HeapStatistics> GetHeapStatistics();
+    void PrintStatistics();
+
+    [[ nodiscard ]] const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_MemoryProperties; }
+    [[ nodiscard ]] VkDevice GetDevice() const { return m_Device; }
+private:
+    struct Pool {
+        std::vector<std::unique_ptr<VulkanMemoryBlock>> blocks;
+    };
+
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = VkDeviceSize(64) * 1024 * 1024;
+
+    [[ nodiscard ]] VkDeviceSize blockSizeForType(uint32_t memoryTypeIndex) const;
+    [[ nodiscard ]] VkDeviceMemory allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void** mappedData);
+    void freeDeviceMemory(VulkanMemoryBlock* block);
+
+    static uint32_t poolIndex(uint32_t memoryTypeIndex, ResourceType resourceType) {
+        return memoryTypeIndex * 2 + static_cast<uint32_t>(resourceType);
+    }
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties m_MemoryProperties{};
+    uint32_t m_MaxMemoryAllocationCount = 4096;
+    uint32_t m_DeviceMemoryCount = 0;
+
+    std::vector<Pool> m_Pools;
+    std::vector<std::unique_ptr<VulkanMemoryBlock>> m_DedicatedBlocks;
+    std::vector<HeapStatistics> m_HeapStatistics;
+
+    std::mutex m_Mutex;
+};
+
+///@brief ring of per-frame linear allocations inside one mapped buffer
+///@details BeginFrame() releases everything allocated the last time the same frame slot was used,
+/// caller has to make sure the GPU is done with it (in-flight fence of that slot was waited on)
+class VulkanRingArena {
+public:
+    VulkanRingArena(VulkanMemoryAllocator* allocator, VkDeviceSize size, VkBufferUsageFlags usage, uint32_t frameSlots,
+                    const std::vector<uint32_t>& queueFamilies = {});
+    ~VulkanRingArena();
+
+    void BeginFrame(uint32_t frameSlot);
+
+    ///@brief linear bump allocation, returns false when the ring is full
+    [[ nodiscard ]] bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+
+    ///@brief drops every allocation, only valid when the GPU is idle
+    void Reset();
+
+    [[ nodiscard ]] void* GetMappedData(VkDeviceSize offset) const { return static_cast<char*>(m_Allocation.MappedData) + offset; }
+    [[ nodiscard ]] VkDeviceSize GetUsedSize() const { return m_Head - m_Tail; }
+
+    VkBuffer Buffer = VK_NULL_HANDLE;
+    VkDeviceSize Size;
+private:
+    VulkanMemoryAllocator* m_Allocator;
+    VulkanAllocation m_Allocation{};
+
+    //offsets grow monotonically, the physical position is offset % Size
+    VkDeviceSize m_Head = 0;
+    VkDeviceSize m_Tail = 0;
+
+    std::vector<VkDeviceSize> m_FrameEnds;
+    uint32_t m_CurrentFrameSlot = UINT32_MAX;
+};
+
+#endif //VULKANRENDERER_VULKANMEMORYALLOCATOR_H
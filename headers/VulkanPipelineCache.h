@@ -0,0 +1,53 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANPIPELINECACHE_H
+#define VULKANRENDERER_VULKANPIPELINECACHE_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+
+///@brief VkPipelineCache persisted on disk between runs
+///@details blob is wrapped in a small file header (magic, payload size, checksum), the Vulkan cache header
+/// is validated against the selected physical device before the data is handed to the driver
+class VulkanPipelineCache {
+public:
+    explicit VulkanPipelineCache(std::string path) : m_Path(std::move(path)) {};
+    ~VulkanPipelineCache();
+
+    ///@brief loads cache blob from disk, falls back to an empty cache on mismatch or corruption
+    void Create(VkDevice device, VkPhysicalDevice physicalDevice);
+
+    ///@brief writes cache blob to a temporary file and renames it over the old one
+    void Save();
+
+    VkPipelineCache PipelineCache = VK_NULL_HANDLE;
+private:
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t payloadSize;
+        uint64_t payloadHash;
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x4350564B; // "KVPC"
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    [[ nodiscard ]] std::vector<char> loadCacheData() const;
+    [[ nodiscard ]] bool validateCacheHeader(const std::vector<char>& data) const;
+    static uint64_t hashData(const char* data, size_t size);
+    ///@brief flushes the file contents to the disk, true without POSIX
+    static bool syncFile(const std::string& path);
+
+    std::string m_Path;
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties m_PhysicalDeviceProperties{};
+};
+
+#endif //VULKANRENDERER_VULKANPIPELINECACHE_H
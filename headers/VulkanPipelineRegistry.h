@@ -0,0 +1,133 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANPIPELINEREGISTRY_H
+#define VULKANRENDERER_VULKANPIPELINEREGISTRY_H
+
+#include <vulkan/vulkan.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+///@brief everything a graphics pipeline is built from, equal descriptions share one VkPipeline
+///@details viewport and scissor are always dynamic, so a description does not depend on the swap chain extent
+struct PipelineDescription {
+    ///@brief paths of the SPIR-V binaries
+    std::string vertexShader;
+    std::string fragmentShader;
+
+    std::vector<VkVertexInputBindingDescription> vertexBindings;
+    std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+    VkCullModeFlags cullMode = VK_CULL_MODE_NONE;
+    VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+
+    bool depthTest = true;
+    bool depthWrite = true;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+    ///@brief standard alpha blending on the single color attachment
+    bool alphaBlend = false;
+
+    ///@brief pipelines can be used with any render pass compatible with this one
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    uint32_t subpass = 0;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+
+    bool operator==(const PipelineDescription& other) const;
+    [[ nodiscard ]] size_t Hash() const;
+};
+
+///@brief deduplicates graphics pipelines by their description and creates missing ones in batches
+///@details Request() only registers a description and returns a stable handle, Flush() creates every pipeline still
+/// missing with a single vkCreateGraphicsPipelines call through the pipeline cache, CompileAsync() spreads them over a
+/// thread pool instead. Handles survive hot reload, the pipeline behind them is swapped with Replace().
+class VulkanPipelineRegistry {
+public:
+    using PipelineHandle = uint32_t;
+
+    VulkanPipelineRegistry() = default;
+    ~VulkanPipelineRegistry();
+
+    VulkanPipelineRegistry(const VulkanPipelineRegistry&) = delete;
+    VulkanPipelineRegistry& operator=(const VulkanPipelineRegistry&) = delete;
+
+    void Create(VkDevice device, VkPipelineCache pipelineCache);
+
+    ///@brief O(1) for a description registered before, the pipeline exists after the next Flush()
+    [[ nodiscard ]] PipelineHandle Request(const PipelineDescription& pipelineDescription);
+
+    ///@brief creates every requested pipeline which does not exist yet in one batch
+    [[ nodiscard ]] VkResult Flush();
+
+    ///@brief splits every missing pipeline into one batch per worker, returns without waiting for them
+    ///@details all workers share the pipeline cache. Finished pipelines become visible to GetPipeline() with CollectCompiled().
+    void CompileAsync(ThreadPool* threadPool);
+
+    ///@brief publishes pipelines finished by CompileAsync() workers, returns how many became available
+    ///@details pipelines whose shaders were reloaded while their batch was running are rebuilt here first
+    uint32_t CollectCompiled();
+
+    ///@brief blocks until every CompileAsync() batch finished and collects them
+    void WaitIdle();
+
+    ///@brief true while CompileAsync() batches run or their pipelines were not collected yet
+    [[ nodiscard ]] bool IsCompiling();
+
+    ///@brief pipeline behind handle, VK_NULL_HANDLE until it was flushed or collected
+    [[ nodiscard ]] VkPipeline GetPipeline(PipelineHandle handle) const { return m_Entries[handle].pipeline; }
+
+    ///@brief builds new pipelines for every description using one of the SPIR-V files, safe to call from any thread
+    ///@details the registry is left untouched, hand the result to Replace() once no frame is being recorded
+    [[ nodiscard ]] std::vector<std::pair<PipelineHandle, VkPipeline>> CreateReplacements(const std::vector<std::string>& shaderPaths);
+
+    ///@brief swaps the pipeline behind handle and returns the previous one, caller destroys it once the GPU is done with it
+    [[ nodiscard ]] VkPipeline Replace(PipelineHandle handle, VkPipeline pipeline);
+
+    [[ nodiscard ]] uint32_t GetPipelineCount() const { return static_cast<uint32_t>(m_Entries.size()); }
+    [[ nodiscard ]] uint32_t GetReadyPipelineCount() const;
+private:
+    struct Entry {
+        PipelineDescription description;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        ///@brief handed to a CompileAsync() batch, Flush() leaves it alone
+        bool compiling = false;
+        ///@brief one of its shaders was reloaded while compiling, the batch result is rebuilt on collection
+        bool stale = false;
+    };
+
+    struct DescriptionHash {
+        size_t operator()(const PipelineDescription& pipelineDescription) const { return pipelineDescription.Hash(); }
+    };
+
+    ///@brief creates one pipeline per description with a single vkCreateGraphicsPipelines call
+    VkResult createPipelines(const std::vector<PipelineDescription>& descriptions, std::vector<VkPipeline>& pipelines);
+
+    std::vector<Entry> m_Entries;
+    std::unordered_map<PipelineDescription, PipelineHandle, DescriptionHash> m_Lookup;
+    ///@brief guards the descriptions against CreateReplacements() running on another thread
+    std::mutex m_Mutex;
+
+    ///@brief pipelines finished by workers, moved into m_Entries by CollectCompiled()
+    std::vector<std::pair<PipelineHandle, VkPipeline>> m_Compiled;
+    ///@brief handles of failed batches, they stay without a pipeline
+    std::vector<PipelineHandle> m_Failed;
+    uint32_t m_RunningBatches = 0;
+    std::condition_variable m_BatchesFinished;
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+};
+
+#endif //VULKANRENDERER_VULKANPIPELINEREGISTRY_H
@@ -0,0 +1,157 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANPROFILER_H
+#define VULKANRENDERER_VULKANPROFILER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <iostream>
+
+///@brief GPU timestamp scopes and CPU scope timers collected into a ring of recent frames
+///@details GPU results of a frame slot are read back in BeginCommandBuffer(), after the caller waited on the slot fence,
+/// so reading queries never stalls. Scope names have to outlive the profiler (string literals).
+class VulkanProfiler {
+public:
+    struct Scope {
+        const char* name;
+        ///@brief microseconds since Create()
+        double startUs;
+        double durationUs;
+        uint32_t threadIndex;
+    };
+
+    ///@brief sampled value, shown as a graph next to the CPU timeline
+    struct Counter {
+        const char* name;
+        double timeUs;
+        double value;
+    };
+
+    struct FrameRecord {
+        uint64_t frameNumber = 0;
+        ///@brief BeginFrame() time, the distance between two frames is the frame time
+        double beginUs = 0.0;
+        std::vector<Scope> cpuScopes;
+        ///@brief GPU scopes placed on the CPU timeline at the time of the frame submit
+        std::vector<Scope> gpuScopes;
+        std::vector<Counter> counters;
+        double submitUs = 0.0;
+    };
+
+    ///@brief RAII CPU timer, records the time between construction and destruction
+    class CpuScope {
+    public:
+        CpuScope(VulkanProfiler* profiler, const char* name);
+        ~CpuScope();
+
+        CpuScope(const CpuScope&) = delete;
+        CpuScope& operator=(const CpuScope&) = delete;
+    private:
+        VulkanProfiler* m_Profiler;
+        const char* m_Name;
+        double m_StartUs;
+    };
+
+    ///@brief RAII pair of timestamps written into a primary command buffer
+    class GpuScope {
+    public:
+        GpuScope(VulkanProfiler* profiler, VkCommandBuffer commandBuffer, const char* name);
+        ~GpuScope();
+
+        GpuScope(const GpuScope&) = delete;
+        GpuScope& operator=(const GpuScope&) = delete;
+    private:
+        VulkanProfiler* m_Profiler;
+        VkCommandBuffer m_CommandBuffer;
+        uint32_t m_ScopeIndex;
+    };
+
+    ///@brief receives each submitted frame once its GPU scopes were read back, in frame order
+    ///@details runs with the profiler locked, it must not call back into the profiler
+    using FrameCallback = std::function<void(const FrameRecord&)>;
+
+    explicit VulkanProfiler(uint32_t maxGpuScopesPerFrame = 32, uint32_t historySize = 256)
+        : m_MaxGpuScopesPerFrame(maxGpuScopesPerFrame), m_HistorySize(historySize) {};
+    ~VulkanProfiler();
+
+    void Create(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+
+    ///@brief recreates per-frame queries, device has to be idle
+    void SetFramesInFlight(uint32_t framesInFlight);
+
+    ///@brief starts a new frame record, CPU scopes are attributed to the most recent frame
+    void BeginFrame(uint32_t frameIndex);
+
+    ///@brief collects finished GPU scopes of the slot and resets its queries
+    ///@details record at the start of the primary command buffer, outside of a render pass, after the slot fence wait
+    void BeginCommandBuffer(VkCommandBuffer commandBuffer);
+
+    ///@brief marks the CPU time the GPU timeline of the current frame is aligned to
+    void MarkSubmit();
+
+    ///@brief samples a counter into the current frame, the name has to outlive the profiler like scope names
+    void SetCounter(const char* name, double value);
+
+    void SetFrameCallback(FrameCallback frameCallback);
+
+    ///@brief reads back every submitted frame which was not completed yet, device has to be idle
+    void Flush();
+
+    ///@brief writes every frame in the history as Chrome trace JSON (chrome://tracing, Perfetto), device has to be idle
+    void WriteChromeTrace(const std::string& path);
+
+    [[ nodiscard ]] double GetTimeUs() const;
+    ///@brief number of the frame started by the last BeginFrame(), render thread only
+    [[ nodiscard ]] uint64_t GetFrameNumber() const { return m_FrameNumber; }
+    [[ nodiscard ]] bool IsGpuTimingSupported() const { return m_GpuTimingSupported; }
+private:
+    struct GpuFrame {
+        uint64_t frameNumber = 0;
+        std::vector<const char*> scopeNames;
+        bool submitted = false;
+    };
+
+    [[ nodiscard ]] uint32_t beginGpuScope(VkCommandBuffer commandBuffer, const char* name);
+    void endGpuScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex);
+    void addCpuScope(const char* name, double startUs, double endUs);
+    void collectGpuScopes(GpuFrame& gpuFrame, uint32_t frameIndex);
+    ///@brief collects a submitted frame and hands it to the frame callback
+    void completeFrame(GpuFrame& gpuFrame, uint32_t frameIndex);
+    ///@brief completes the submitted frames of every slot, oldest first
+    void completeSubmittedFrames();
+    [[ nodiscard ]] uint32_t threadIndex();
+    [[ nodiscard ]] FrameRecord* findRecord(uint64_t frameNumber);
+
+    uint32_t m_MaxGpuScopesPerFrame;
+    uint32_t m_HistorySize;
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkQueryPool m_QueryPool = VK_NULL_HANDLE;
+    bool m_GpuTimingSupported = false;
+    double m_TimestampPeriod = 1.0;
+    uint64_t m_TimestampMask = ~0ULL;
+
+    std::chrono::steady_clock::time_point m_Epoch;
+
+    std::vector<GpuFrame> m_GpuFrames;
+    uint32_t m_CurrentFrameIndex = 0;
+
+    std::vector<FrameRecord> m_History;
+    uint64_t m_FrameNumber = 0;
+
+    FrameCallback m_FrameCallback;
+
+    std::vector<std::thread::id> m_ThreadIds;
+    std::mutex m_Mutex;
+};
+
+#endif //VULKANRENDERER_VULKANPROFILER_H
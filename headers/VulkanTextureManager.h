@@ -0,0 +1,118 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANTEXTUREMANAGER_H
+#define VULKANRENDERER_VULKANTEXTUREMANAGER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AssetStreamer.h"
+#include "TextureFile.h"
+#include "VulkanBindlessDescriptors.h"
+#include "VulkanMemoryAllocator.h"
+
+///@brief sampled 2D textures with mip levels streamed in on demand, coarsest first
+///@details Load() allocates the whole mip chain and queues the mip tail (levels of at most MIP_TAIL_SIZE texels), so a
+/// texture becomes usable after a few KB. Renderers call RequestLevel() with the finest level an object needs on screen,
+/// Update() queues the missing levels between the resident one and the finest requested on the asset streamer. Once a
+/// level arrived the texture gets a new view starting at it and a new bindless slot, the previous ones are deferred until
+/// frames in flight stopped sampling them, so shaders never see a level that is still being copied.
+/// Compressed formats are uploaded as stored, BC1 - BC3 are decoded to RGBA8 on the I/O threads where the device lacks BC.
+class VulkanTextureManager {
+public:
+    ///@brief runs the deleter once no frame in flight uses the resources it destroys
+    using DeferDestroyFunction = std::function<void(std::function<void()>)>;
+
+    ///@brief levels whose larger side is at most this many texels are loaded together with the texture
+    static constexpr uint32_t MIP_TAIL_SIZE = 64;
+
+    struct MemoryStats {
+        uint32_t textureCount = 0;
+        ///@brief allocated for whole mip chains, resident or not
+        VkDeviceSize deviceBytes = 0;
+        ///@brief levels uploaded so far
+        VkDeviceSize residentBytes = 0;
+        ///@brief the same mip chains as uncompressed RGBA8, compression ratio is rgba8Bytes / deviceBytes
+        VkDeviceSize rgba8Bytes = 0;
+    };
+
+    VulkanTextureManager(VulkanMemoryAllocator* allocator, AssetStreamer* streamer, VulkanBindlessDescriptors* bindlessDescriptors)
+        : m_Allocator(allocator), m_Streamer(streamer), m_BindlessDescriptors(bindlessDescriptors) {};
+    ~VulkanTextureManager();
+
+    VulkanTextureManager(const VulkanTextureManager&) = delete;
+    VulkanTextureManager& operator=(const VulkanTextureManager&) = delete;
+
+    ///@brief enables the texture compression families and anisotropic filtering the device supports
+    static void EnableFeatures(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures& physicalDeviceFeatures);
+
+    void Create(VkPhysicalDevice physicalDevice, VkDevice device, DeferDestroyFunction deferDestroy);
+
+    ///@brief opens a .ktx2 file and queues its mip tail, returns the texture id
+    ///@details throws when the format can be neither sampled by the device nor decoded on the CPU (ASTC and ETC2 on desktop)
+    [[ nodiscard ]] uint32_t Load(const std::string& path);
+
+    ///@brief finest level needed this frame, the finest request of all callers wins
+    void RequestLevel(uint32_t texture, uint32_t level);
+
+    ///@brief queues uploads for the levels requested since the previous call, before the streamer's Update()
+    void Update();
+
+    ///@brief INVALID_INDEX until the mip tail arrived
+    [[ nodiscard ]] uint32_t GetBindlessIndex(uint32_t texture) const { return m_Textures[texture].bindlessIndex; }
+    [[ nodiscard ]] uint32_t GetLevelCount(uint32_t texture) const { return m_Textures[texture].levelCount; }
+    [[ nodiscard ]] VkExtent2D GetExtent(uint32_t texture) const { return m_Textures[texture].extent; }
+    ///@brief finest level visible to shaders, GetLevelCount() while nothing arrived
+    [[ nodiscard ]] uint32_t GetResidentLevel(uint32_t texture) const { return m_Textures[texture].residentLevel; }
+
+    [[ nodiscard ]] MemoryStats GetMemoryStats() const;
+
+    VkSampler Sampler = VK_NULL_HANDLE;
+private:
+    struct Texture {
+        std::shared_ptr<TextureFile> file;
+        ///@brief format of the image, RGBA8 when the file is decoded on the CPU
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        TextureFormatInfo formatInfo{};
+        bool decode = false;
+        VkExtent2D extent{};
+        uint32_t levelCount = 0;
+        uint32_t tailLevel = 0;
+
+        VkImage image = VK_NULL_HANDLE;
+        VulkanAllocation allocation{};
+        VkImageView imageView = VK_NULL_HANDLE;
+        uint32_t bindlessIndex = VulkanBindlessDescriptors::INVALID_INDEX;
+
+        uint32_t residentLevel = 0;
+        ///@brief finest level handed to the streamer
+        uint32_t queuedLevel = 0;
+        ///@brief finest level requested since the previous Update(), levelCount when none
+        uint32_t requestedLevel = 0;
+    };
+
+    [[ nodiscard ]] bool isFormatSupported(VkFormat format) const;
+    ///@brief queues levels from the finest queued one down to level, each as its own request
+    void queueLevels(uint32_t texture, uint32_t level);
+    ///@brief swaps the texture's view and bindless slot for ones starting at the arrived level
+    void onLevelReady(uint32_t texture, uint32_t level);
+
+    VulkanMemoryAllocator* m_Allocator;
+    AssetStreamer* m_Streamer;
+    VulkanBindlessDescriptors* m_BindlessDescriptors;
+
+    VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+    VkDevice m_Device = VK_NULL_HANDLE;
+    DeferDestroyFunction m_DeferDestroy;
+
+    std::vector<Texture> m_Textures;
+};
+
+#endif //VULKANRENDERER_VULKANTEXTUREMANAGER_H
@@ -0,0 +1,115 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#ifndef VULKANRENDERER_VULKANUPLOADER_H
+#define VULKANRENDERER_VULKANUPLOADER_H
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+
+#include "VulkanMemoryAllocator.h"
+
+///@brief copies data into device-local buffers and image mip levels through a staging ring on the transfer queue
+///@details copies are batched and submitted by Flush(), graphics submits wait on the returned semaphores,
+/// so uploads never block the graphics queue. When the transfer queue belongs to another family,
+/// buffer and image ownership is released on the transfer queue and acquired by RecordAcquireBarriers()
+class VulkanUploader {
+public:
+    struct WaitSemaphore {
+        VkSemaphore semaphore;
+        VkPipelineStageFlags stageMask;
+    };
+
+    ///@brief one mip level of a 2D color image, data is tightly packed rows of texel blocks
+    struct ImageUpload {
+        VkImage image = VK_NULL_HANDLE;
+        uint32_t mipLevel = 0;
+        VkExtent2D extent{};
+        ///@brief texel block of the format, 1x1 with the texel size for uncompressed formats
+        uint32_t blockWidth = 1;
+        uint32_t blockHeight = 1;
+        uint32_t blockSize = 4;
+        ///@brief first access after the upload, the level ends up in SHADER_READ_ONLY_OPTIMAL
+        VkAccessFlags dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+        [[ nodiscard ]] uint32_t GetBlockRowCount() const { return (extent.height + blockHeight - 1) / blockHeight; }
+        [[ nodiscard ]] VkDeviceSize GetBlockRowSize() const { return static_cast<VkDeviceSize>((extent.width + blockWidth - 1) / blockWidth) * blockSize; }
+    };
+
+    VulkanUploader(VulkanMemoryAllocator* allocator, VkDeviceSize stagingSize) : m_Allocator(allocator), m_StagingSize(stagingSize) {};
+    ~VulkanUploader();
+
+    void Create(VkDevice device, VkQueue transferQueue, uint32_t transferFamily, uint32_t graphicsFamily);
+
+    ///@brief copies data into the staging ring and records a copy into the current batch
+    ///@details uploads bigger than the staging ring are split, older batches are recycled when the ring is full
+    void UploadBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+                      VkAccessFlags dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+                      VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+    ///@brief transitions the level for copying, its previous contents are discarded
+    ///@details the level must not be read by the GPU until EndImageUpload() was flushed and waited on
+    void BeginImageUpload(const ImageUpload& upload);
+
+    ///@brief copies block rows [firstBlockRow, firstBlockRow + blockRowCount) of the level, split like UploadBuffer()
+    void UploadImageRows(const ImageUpload& upload, uint32_t firstBlockRow, uint32_t blockRowCount, const void* data);
+
+    ///@brief transitions the level to SHADER_READ_ONLY_OPTIMAL and hands it to the graphics queue
+    void EndImageUpload(const ImageUpload& upload);
+
+    ///@brief submits recorded copies to the transfer queue
+    void Flush();
+
+    ///@brief records queue family acquire barriers for flushed uploads, call outside of a render pass
+    ///@details has to be recorded into the submit which waits on TakeWaitSemaphores()
+    void RecordAcquireBarriers(VkCommandBuffer commandBuffer);
+
+    ///@brief semaphores the next graphics submit has to wait on, the list is cleared
+    ///@details at most the semaphore of the latest Flush(), it orders every batch submitted before it
+    [[ nodiscard ]] std::vector<WaitSemaphore> TakeWaitSemaphores();
+
+    [[ nodiscard ]] bool HasPendingUploads() const { return m_Batches[m_CurrentBatch].recording; }
+private:
+    struct Batch {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        VkPipelineStageFlags dstStageMask = 0;
+        bool recording = false;
+    };
+
+    static constexpr uint32_t BATCH_COUNT = 4;
+    static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+    void beginBatch();
+
+    VulkanMemoryAllocator* m_Allocator;
+    VkDeviceSize m_StagingSize;
+    std::unique_ptr<VulkanRingArena> m_StagingRing;
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkQueue m_TransferQueue = VK_NULL_HANDLE;
+    uint32_t m_TransferFamily = 0;
+    uint32_t m_GraphicsFamily = 0;
+
+    VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+    Batch m_Batches[BATCH_COUNT];
+    uint32_t m_CurrentBatch = 0;
+
+    std::vector<VkBufferMemoryBarrier> m_ReleaseBarriers;
+    std::vector<VkBufferMemoryBarrier> m_AcquireBarriers;
+    std::vector<VkBufferMemoryBarrier> m_PendingAcquireBarriers;
+    std::vector<VkImageMemoryBarrier> m_ImageReleaseBarriers;
+    std::vector<VkImageMemoryBarrier> m_ImageAcquireBarriers;
+    std::vector<VkImageMemoryBarrier> m_PendingImageAcquireBarriers;
+    VkPipelineStageFlags m_PendingAcquireStageMask = 0;
+    ///@brief signaled but not taken yet, chained by Flush() so no batch semaphore is signaled twice without a wait
+    std::vector<WaitSemaphore> m_PendingWaitSemaphores;
+};
+
+#endif //VULKANRENDERER_VULKANUPLOADER_H
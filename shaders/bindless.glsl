@@ -0,0 +1,16 @@
+// global bindless set and per-draw indices, matches VulkanBindlessDescriptors and RenderEngine::DrawPushConstants
+#extension GL_EXT_nonuniform_qualifier : require
+
+#define INVALID_INDEX 0xFFFFFFFFu
+
+layout(set = 0, binding = 0) uniform sampler2D textures[];
+
+layout(std430, set = 0, binding = 1) readonly buffer MaterialBuffer {
+    vec4 baseColor;
+} materialBuffers[];
+
+layout(push_constant) uniform DrawConstants {
+    uint textureIndex;
+    uint materialBufferIndex;
+    uint transformIndex;
+} draw;
@@ -0,0 +1,21 @@
+// per-frame data bound with dynamic offsets, matches VulkanFrameData and RenderEngine::FrameUniforms
+
+layout(std140, set = 1, binding = 0) uniform FrameUniforms {
+    mat4 viewProjection;
+    // x - seconds since start, y - seconds since the previous frame
+    vec4 time;
+    // left, right, bottom, top, near, far - xyz normal pointing inside, w distance
+    vec4 frustumPlanes[6];
+} frame;
+
+struct ObjectData {
+    mat4 transform;
+    // bindless indices, 0xFFFFFFFF when unused
+    uint textureIndex;
+    uint materialBufferIndex;
+    uint padding[2];
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer Objects {
+    ObjectData data[];
+} objects;
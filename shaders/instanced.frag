@@ -0,0 +1,18 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "bindless.glsl"
+
+layout(location = 0) out vec4 outColor;
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) flat in uint fragMaterialIndex;
+
+void main() {
+
+    outColor = vec4(fragColor, 1.0);
+
+    // instances of one draw may use different materials
+    if(fragMaterialIndex != INVALID_INDEX)
+        outColor *= materialBuffers[nonuniformEXT(fragMaterialIndex)].baseColor;
+
+}
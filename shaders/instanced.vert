@@ -0,0 +1,22 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "bindless.glsl"
+#include "frame.glsl"
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+
+// per-instance bindings, matches InstanceBatch
+layout(location = 3) in mat4 instanceTransform;
+layout(location = 7) in vec4 instanceColor;
+layout(location = 8) in uint instanceMaterialIndex;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) flat out uint fragMaterialIndex;
+
+void main(){
+    gl_Position = frame.viewProjection * instanceTransform * vec4(inPosition, 0.0, 1.0);
+    fragColor = inColor * instanceColor.rgb;
+    fragMaterialIndex = instanceMaterialIndex;
+}
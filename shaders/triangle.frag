@@ -1,10 +1,22 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "bindless.glsl"
 
 layout(location = 0) out vec4 outColor;
 layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureIndex;
 
 void main() {
 
     outColor = vec4(fragColor, 1.0);
 
+    // the view only covers resident mips, sampling never reads a level still streaming in
+    if(fragTextureIndex != INVALID_INDEX)
+        outColor *= texture(textures[nonuniformEXT(fragTextureIndex)], fragTexCoord);
+
+    if(draw.materialBufferIndex != INVALID_INDEX)
+        outColor *= materialBuffers[nonuniformEXT(draw.materialBufferIndex)].baseColor;
+
 }
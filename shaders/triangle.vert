@@ -1,20 +1,24 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
-vec2 vertexPositions[3] = vec2[](
-    vec2(0.0, -0.5),
-    vec2(0.5, 0.5),
-    vec2(-0.5, 0.5)
-);
+#include "bindless.glsl"
+#include "frame.glsl"
 
-vec3 vertexColors[3] = vec3[](
-    vec3(1.0, 0.0, 0.0),
-    vec3(0.0, 1.0, 0.0),
-    vec3(0.0, 0.0, 1.0)
-);
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
 
+// GPU culled draws carry the object index in firstInstance and push 0
 void main(){
-    gl_Position = vec4(vertexPositions[gl_VertexIndex], 0.0, 1.0);
-    fragColor = vertexColors[gl_VertexIndex];
-}
\ No newline at end of file
+    ObjectData object = objects.data[draw.transformIndex + gl_InstanceIndex];
+
+    gl_Position = frame.viewProjection * object.transform * vec4(inPosition, 0.0, 1.0);
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+    // CPU recorded draws may override the object's texture through push constants
+    fragTextureIndex = draw.textureIndex != INVALID_INDEX ? draw.textureIndex : object.textureIndex;
+}
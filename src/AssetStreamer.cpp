@@ -0,0 +1,196 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "AssetStreamer.h"
+
+#include <fstream>
+
+AssetStreamer::AssetData AssetStreamer::AssetData::FromBuffer(std::vector<char> buffer) {
+    auto owner = std::make_shared<std::vector<char>>(std::move(buffer));
+
+    AssetData assetData;
+    assetData.data = owner->data();
+    assetData.size = owner->size();
+    assetData.owner = owner;
+
+    return assetData;
+}
+
+AssetStreamer::AssetStreamer(VulkanUploader* uploader, uint32_t ioThreadCount, VkDeviceSize uploadBudget)
+    : m_Uploader(uploader), m_UploadBudget(std::max<VkDeviceSize>(uploadBudget, 1)), m_IoThreads(ioThreadCount) {}
+
+AssetStreamer::~AssetStreamer() {
+    m_Stopping = true;
+}
+
+void AssetStreamer::SetFramesInFlight(uint32_t framesInFlight) {
+    m_SlotBytes.assign(framesInFlight, 0);
+    m_BytesInFlight = 0;
+}
+
+void AssetStreamer::Submit(Request request) {
+    auto job = std::make_shared<Job>();
+    job->request = std::move(request);
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(job);
+    }
+
+    m_IoThreads.Submit([this, job](){
+        AssetData data;
+        std::string error;
+        if(!m_Stopping){
+            try {
+                data = job->request.load();
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        job->data = std::move(data);
+        job->error = std::move(error);
+        job->loaded = true;
+    });
+}
+
+void AssetStreamer::Update(uint32_t frameSlot) {
+    if(frameSlot >= m_SlotBytes.size())
+        m_SlotBytes.resize(frameSlot + 1, 0);
+
+    //the slot fence was waited on, everything it staged has been copied
+    m_BytesInFlight -= m_SlotBytes[frameSlot];
+    m_SlotBytes[frameSlot] = 0;
+    m_BytesUploadedLastFrame = 0;
+
+    VkDeviceSize budget = m_UploadBudget;
+    while(budget > 0){
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            //the oldest request blocks the ones behind it, completion stays in request order
+            if(m_Jobs.empty() || !m_Jobs.front()->loaded)
+                break;
+            job = m_Jobs.front();
+        }
+
+        if(!job->error.empty())
+            throw std::runtime_error("AssetStreamer::Update() -> " + job->error);
+
+        if(job->request.image.image != VK_NULL_HANDLE)
+            uploadImageChunk(*job, frameSlot, budget);
+        else {
+            VkDeviceSize chunkSize = std::min(budget, job->data.size - job->uploaded);
+            if(chunkSize > 0)
+                uploadBufferChunk(*job, frameSlot, chunkSize);
+            budget -= chunkSize;
+        }
+
+        if(job->uploaded < job->data.size)
+            break;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Jobs.pop_front();
+        }
+        m_CompletedRequests++;
+
+        //staged data is no longer needed, release the buffer or mapping before the callback
+        job->data = AssetData();
+        if(job->request.onReady)
+            job->request.onReady();
+    }
+}
+
+void AssetStreamer::uploadBufferChunk(Job& job, uint32_t frameSlot, VkDeviceSize chunkSize) {
+    m_Uploader->UploadBuffer(job.request.dstBuffer, job.request.dstOffset + job.uploaded,
+                             static_cast<const char*>(job.data.data) + job.uploaded, chunkSize,
+                             job.request.dstAccessMask, job.request.dstStageMask);
+
+    job.uploaded += chunkSize;
+    accountUpload(frameSlot, chunkSize);
+}
+
+void AssetStreamer::uploadImageChunk(Job& job, uint32_t frameSlot, VkDeviceSize& budget) {
+    const VulkanUploader::ImageUpload& image = job.request.image;
+    VkDeviceSize rowSize = image.GetBlockRowSize();
+    uint32_t rowCount = image.GetBlockRowCount();
+
+    if(job.data.size != rowSize * rowCount)
+        throw std::runtime_error("AssetStreamer::Update() -> Image data size does not match the mip level!");
+
+    //whole rows only, at least one so a row wider than the budget still makes progress
+    auto firstRow = static_cast<uint32_t>(job.uploaded / rowSize);
+    auto chunkRows = static_cast<uint32_t>(std::min<VkDeviceSize>(std::max<VkDeviceSize>(budget / rowSize, 1), rowCount - firstRow));
+
+    if(firstRow == 0)
+        m_Uploader->BeginImageUpload(image);
+    m_Uploader->UploadImageRows(image, firstRow, chunkRows, static_cast<const char*>(job.data.data) + job.uploaded);
+
+    VkDeviceSize chunkSize = chunkRows * rowSize;
+    job.uploaded += chunkSize;
+    if(job.uploaded == job.data.size)
+        m_Uploader->EndImageUpload(image);
+
+    accountUpload(frameSlot, chunkSize);
+    budget -= std::min(budget, chunkSize);
+}
+
+void AssetStreamer::accountUpload(uint32_t frameSlot, VkDeviceSize size) {
+    m_SlotBytes[frameSlot] += size;
+    m_BytesInFlight += size;
+    m_BytesUploadedLastFrame += size;
+}
+
+AssetStreamer::Stats AssetStreamer::GetStats() const {
+    Stats stats;
+    stats.bytesInFlight = m_BytesInFlight;
+    stats.bytesUploadedLastFrame = m_BytesUploadedLastFrame;
+    stats.completedRequests = m_CompletedRequests;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(const auto& job : m_Jobs){
+        if(job->loaded){
+            stats.uploadQueueDepth++;
+            stats.bytesPendingUpload += job->data.size - job->uploaded;
+        }
+        else
+            stats.loadQueueDepth++;
+    }
+
+    return stats;
+}
+
+bool AssetStreamer::IsIdle() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Jobs.empty();
+}
+
+AssetStreamer::AssetData AssetStreamer::ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("AssetStreamer::ReadFile() -> Failed to open " + path + "!");
+
+    std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if(!file)
+        throw std::runtime_error("AssetStreamer::ReadFile() -> Failed to read " + path + "!");
+
+    return AssetData::FromBuffer(std::move(buffer));
+}
+
+void AssetStreamer::Prefault(const void* data, size_t size) {
+    constexpr size_t PREFAULT_STRIDE = 4096;
+
+    //volatile keeps the reads, the values are not used
+    auto bytes = static_cast<const volatile char*>(data);
+    char sink = 0;
+    for(size_t offset = 0; offset < size; offset += PREFAULT_STRIDE)
+        sink ^= bytes[offset];
+    if(size > 0)
+        sink ^= bytes[size - 1];
+    (void)sink;
+}
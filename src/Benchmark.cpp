@@ -0,0 +1,292 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+//renders scripted scenes headless and reports frame, record, submit and GPU time statistics
+//usage: Benchmark [--frames <count>] [--warmup <count>] [--scene <name>]... [--output <results.json>]
+//                 [--baseline <baseline.json>] [--threshold <percent>] [--no-gpu-culling] [--msaa <samples>]
+//exits with failure when a metric regressed against the baseline, so CI can gate on it
+
+#include "RenderEngine.h"
+#include "FrameStatistics.h"
+#include "BenchmarkBaseline.h"
+#include "MeshFile.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+
+namespace {
+    struct Scene {
+        const char* name;
+        ///@brief meshes in the scene file, each one is a draw next to the built-in triangle
+        uint32_t meshCount;
+        uint32_t trianglesPerMesh;
+        ///@brief instances of the built-in triangle in one instanced draw
+        uint32_t instanceCount;
+
+        [[ nodiscard ]] uint64_t GetTriangleCount() const { return 1 + static_cast<uint64_t>(meshCount) * trianglesPerMesh + instanceCount; }
+        [[ nodiscard ]] uint32_t GetDrawCount() const { return 1 + meshCount + (instanceCount > 0 ? 1 : 0); }
+    };
+
+    //1 to 1M triangles and 1 to 100k draws, the built-in triangle is always drawn
+    const Scene SCENES[] = {
+        {"triangle", 0, 0, 0},
+        {"triangles-10k", 1, 10000, 0},
+        {"triangles-1m", 1, 1000000, 0},
+        {"draws-1k", 1000, 100, 0},
+        {"draws-100k", 100000, 1, 0},
+        {"instances-100k", 0, 0, 100000},
+    };
+
+    struct SceneResult {
+        const Scene* scene;
+        size_t frameCount;
+        std::array<FrameStatistics::Summary, FrameStatistics::METRIC_COUNT> summaries;
+    };
+
+    ///@brief meshes of small triangles tiling the clip space, mesh i fills cell i of a square grid
+    void writeSceneFile(const Scene& scene, const std::string& path) {
+        MeshFileWriter writer;
+        auto gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(scene.meshCount))));
+        auto triangleGridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(scene.trianglesPerMesh))));
+        float cellSize = 2.0f / static_cast<float>(gridSize);
+        float triangleSize = cellSize / static_cast<float>(triangleGridSize);
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        for(uint32_t mesh = 0; mesh < scene.meshCount; mesh++){
+            vertices.clear();
+            indices.clear();
+
+            float cellX = -1.0f + cellSize * static_cast<float>(mesh % gridSize);
+            float cellY = -1.0f + cellSize * static_cast<float>(mesh / gridSize);
+            for(uint32_t triangle = 0; triangle < scene.trianglesPerMesh; triangle++){
+                float x = cellX + triangleSize * static_cast<float>(triangle % triangleGridSize);
+                float y = cellY + triangleSize * static_cast<float>(triangle / triangleGridSize);
+                auto firstVertex = static_cast<uint32_t>(vertices.size());
+
+                vertices.push_back({{x + triangleSize * 0.5f, y}, {1.0f, 0.0f, 0.0f}, {0.5f, 0.0f}});
+                vertices.push_back({{x + triangleSize, y + triangleSize}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}});
+                vertices.push_back({{x, y + triangleSize}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}});
+                indices.insert(indices.end(), {firstVertex, firstVertex + 1, firstVertex + 2});
+            }
+
+            writer.AddMesh(vertices, indices);
+        }
+
+        writer.Write(path);
+    }
+
+    SceneResult runScene(const Scene& scene, uint32_t frameCount, uint32_t warmupFrames, bool gpuCulling, uint32_t msaaSamples) {
+        std::string sceneFilePath;
+        if(scene.meshCount > 0){
+            sceneFilePath = (std::filesystem::temp_directory_path() / (std::string("benchmark-") + scene.name + ".vkm")).string();
+            writeSceneFile(scene, sceneFilePath);
+        }
+
+        FrameStatistics frameStatistics;
+        InstanceBatch instanceBatch(MyRenderer::RenderEngine::TRIANGLE_MESH);
+        {
+            MyRenderer::RenderEngine engine(800, 600, "Benchmark");
+            engine.SetHeadless(true, frameCount);
+            engine.SetFrameStatistics(&frameStatistics, warmupFrames);
+            engine.SetGpuCulling(gpuCulling);
+            engine.SetMsaaSamples(msaaSamples);
+            if(!sceneFilePath.empty())
+                engine.SetSceneFile(sceneFilePath);
+
+            if(scene.instanceCount > 0){
+                auto gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(scene.instanceCount))));
+                float cellSize = 2.0f / static_cast<float>(gridSize);
+
+                instanceBatch.Resize(scene.instanceCount);
+                for(uint32_t i = 0; i < scene.instanceCount; i++){
+                    glm::mat4& transform = instanceBatch.Transforms[i];
+                    transform[0][0] = cellSize;
+                    transform[1][1] = cellSize;
+                    transform[3][0] = -1.0f + cellSize * (static_cast<float>(i % gridSize) + 0.5f);
+                    transform[3][1] = -1.0f + cellSize * (static_cast<float>(i / gridSize) + 0.5f);
+                    instanceBatch.Colors[i] = glm::vec4(1.0f);
+                }
+                engine.AddInstanceBatch(&instanceBatch);
+            }
+
+            engine.Run();
+        }
+
+        if(!sceneFilePath.empty())
+            std::filesystem::remove(sceneFilePath);
+
+        SceneResult result{&scene, frameStatistics.GetFrameCount(), {}};
+        for(uint32_t metric = 0; metric < FrameStatistics::METRIC_COUNT; metric++)
+            result.summaries[metric] = frameStatistics.Summarize(static_cast<FrameStatistics::Metric>(metric));
+
+        return result;
+    }
+
+    void writeResults(const std::vector<SceneResult>& results, uint32_t frameCount, uint32_t warmupFrames, const std::string& path) {
+        std::ofstream file(path, std::ios::trunc);
+        if(!file.is_open())
+            throw std::runtime_error("Benchmark -> Failed to open " + path + "!");
+
+        file.setf(std::ios::fixed);
+        file.precision(4);
+
+        //times in milliseconds
+        file << "{\n  \"frames\": " << frameCount << ",\n  \"warmupFrames\": " << warmupFrames << ",\n  \"scenes\": [";
+        for(size_t i = 0; i < results.size(); i++){
+            const SceneResult& result = results[i];
+            file << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.scene->name << "\", \"triangles\": " << result.scene->GetTriangleCount()
+                 << ", \"draws\": " << result.scene->GetDrawCount() << ", \"measuredFrames\": " << result.frameCount;
+
+            for(uint32_t metric = 0; metric < FrameStatistics::METRIC_COUNT; metric++){
+                const FrameStatistics::Summary& summary = result.summaries[metric];
+                file << ",\n     \"" << FrameStatistics::METRIC_NAMES[metric] << "\": {\"count\": " << summary.count
+                     << ", \"average\": " << summary.average << ", \"min\": " << summary.min << ", \"p50\": " << summary.p50
+                     << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max << "}";
+            }
+            file << "}";
+        }
+        file << "\n  ]\n}\n";
+    }
+
+    void printResults(const std::vector<SceneResult>& results) {
+        std::cout << std::left << std::setw(16) << "scene" << std::setw(8) << "metric" << std::right
+                  << std::setw(10) << "avg ms" << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+
+        for(const auto& result : results){
+            for(uint32_t metric = 0; metric < FrameStatistics::METRIC_COUNT; metric++){
+                const FrameStatistics::Summary& summary = result.summaries[metric];
+                if(summary.count == 0)
+                    continue;
+
+                std::cout << std::left << std::setw(16) << (metric == 0 ? result.scene->name : "") << std::setw(8) << FrameStatistics::METRIC_NAMES[metric]
+                          << std::right << std::setw(10) << summary.average << std::setw(10) << summary.p50
+                          << std::setw(10) << summary.p95 << std::setw(10) << summary.p99 << std::endl;
+            }
+        }
+    }
+
+    ///@brief prints every regression against the baseline, returns how many there were
+    uint32_t compareWithBaseline(const std::vector<SceneResult>& results, const std::string& path, double thresholdPercent) {
+        BenchmarkBaseline baseline = BenchmarkBaseline::Load(path);
+
+        uint32_t regressions = 0;
+        for(const auto& result : results){
+            if(!baseline.HasScene(result.scene->name)){
+                std::cout << result.scene->name << ": not in baseline, skipped" << std::endl;
+                continue;
+            }
+
+            for(const auto& regression : baseline.Compare(result.scene->name, result.summaries, thresholdPercent)){
+                std::cout << "REGRESSION " << result.scene->name << " " << FrameStatistics::METRIC_NAMES[regression.metric] << " "
+                          << regression.statistic << ": " << regression.value << " ms, baseline " << regression.baselineValue << " ms (+"
+                          << (regression.value / regression.baselineValue - 1.0) * 100.0 << "%)" << std::endl;
+                regressions++;
+            }
+        }
+
+        return regressions;
+    }
+
+    ///@brief whole argument as a non-negative number, anything else throws naming the option
+    double parseNumber(const std::string& option, const std::string& value) {
+        size_t parsed = 0;
+        double number = 0.0;
+        //stod accepts leading blanks, signs, inf and nan
+        if(!value.empty() && (std::isdigit(static_cast<unsigned char>(value[0])) || value[0] == '.')){
+            try{
+                number = std::stod(value, &parsed);
+            } catch (const std::exception&) {
+                parsed = 0;
+            }
+        }
+
+        if(parsed == 0 || parsed != value.size() || !std::isfinite(number))
+            throw std::runtime_error("Benchmark -> " + option + " expects a number, got \"" + value + "\"!");
+
+        return number;
+    }
+
+    uint32_t parseCount(const std::string& option, const std::string& value, uint32_t min) {
+        double number = parseNumber(option, value);
+        if(number != std::floor(number) || number < min || number > UINT32_MAX)
+            throw std::runtime_error("Benchmark -> " + option + " expects a whole number of at least " + std::to_string(min)
+                                     + ", got \"" + value + "\"!");
+
+        return static_cast<uint32_t>(number);
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t frameCount = 500;
+    uint32_t warmupFrames = 60;
+    std::vector<std::string> sceneNames;
+    std::string outputPath = "benchmark.json";
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+    bool gpuCulling = true;
+    uint32_t msaaSamples = 4;
+
+    try{
+        for(int i = 1; i < argc; i++){
+            std::string argument = argv[i];
+            if(argument == "--frames" && i + 1 < argc)
+                frameCount = parseCount("--frames", argv[++i], 1);
+            else if(argument == "--warmup" && i + 1 < argc)
+                warmupFrames = parseCount("--warmup", argv[++i], 0);
+            else if(argument == "--scene" && i + 1 < argc)
+                sceneNames.emplace_back(argv[++i]);
+            else if(argument == "--output" && i + 1 < argc)
+                outputPath = argv[++i];
+            else if(argument == "--baseline" && i + 1 < argc)
+                baselinePath = argv[++i];
+            else if(argument == "--threshold" && i + 1 < argc)
+                thresholdPercent = parseNumber("--threshold", argv[++i]);
+            else if(argument == "--no-gpu-culling")
+                gpuCulling = false;
+            else if(argument == "--msaa" && i + 1 < argc){
+                msaaSamples = parseCount("--msaa", argv[++i], 1);
+                //VkSampleCountFlagBits only has powers of two
+                if(msaaSamples > 16 || (msaaSamples & (msaaSamples - 1)) != 0)
+                    throw std::runtime_error("Benchmark -> --msaa expects 1, 2, 4, 8 or 16, got " + std::to_string(msaaSamples) + "!");
+            }
+            else
+                throw std::runtime_error("Benchmark -> Unknown argument " + argument + "!");
+        }
+
+        std::vector<SceneResult> results;
+        for(const auto& scene : SCENES){
+            if(!sceneNames.empty() && std::find(sceneNames.begin(), sceneNames.end(), scene.name) == sceneNames.end())
+                continue;
+
+            std::cout << "Running " << scene.name << " (" << scene.GetTriangleCount() << " triangles, " << scene.GetDrawCount() << " draws)" << std::endl;
+            results.push_back(runScene(scene, frameCount, warmupFrames, gpuCulling, msaaSamples));
+        }
+
+        if(results.empty())
+            throw std::runtime_error("Benchmark -> No scene matched!");
+
+        printResults(results);
+        writeResults(results, frameCount, warmupFrames, outputPath);
+        std::cout << "Wrote " << outputPath << std::endl;
+
+        if(!baselinePath.empty()){
+            uint32_t regressions = compareWithBaseline(results, baselinePath, thresholdPercent);
+            if(regressions > 0){
+                std::cerr << regressions << " regressions above " << thresholdPercent << "% against " << baselinePath << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << "No regressions against " << baselinePath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
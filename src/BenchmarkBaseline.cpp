@@ -0,0 +1,60 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "BenchmarkBaseline.h"
+
+#include <fstream>
+#include <iterator>
+
+BenchmarkBaseline::BenchmarkBaseline(const std::string& json) : m_Baseline(JsonParser(json).Parse()) {
+    if(!m_Baseline.find("scenes"))
+        throw std::runtime_error("BenchmarkBaseline::BenchmarkBaseline() -> Baseline has no scenes!");
+}
+
+BenchmarkBaseline BenchmarkBaseline::Load(const std::string& path) {
+    std::ifstream file(path);
+    if(!file.is_open())
+        throw std::runtime_error("BenchmarkBaseline::Load() -> Failed to open baseline " + path + "!");
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return BenchmarkBaseline(text);
+}
+
+std::vector<BenchmarkBaseline::Regression> BenchmarkBaseline::Compare(const std::string& scene, const Summaries& summaries,
+                                                                      double thresholdPercent) const {
+    std::vector<Regression> regressions;
+
+    const JsonValue* baselineScene = findScene(scene);
+    if(!baselineScene)
+        return regressions;
+
+    for(uint32_t metric = 0; metric < FrameStatistics::METRIC_COUNT; metric++){
+        const JsonValue* baselineMetric = baselineScene->find(FrameStatistics::METRIC_NAMES[metric]);
+        const FrameStatistics::Summary& summary = summaries[metric];
+        //GPU time is missing on devices without timestamps
+        if(!baselineMetric || baselineMetric->integer("count", 0) == 0 || summary.count == 0)
+            continue;
+
+        std::pair<const char*, double> values[] = {{"average", summary.average}, {"p95", summary.p95}};
+        for(const auto& [statistic, value] : values){
+            double baselineValue = baselineMetric->at(statistic).number;
+            double limit = baselineValue * (1.0 + thresholdPercent / 100.0);
+            if(value <= limit || value - baselineValue < MIN_REGRESSION_MS)
+                continue;
+
+            regressions.push_back({static_cast<FrameStatistics::Metric>(metric), statistic, value, baselineValue});
+        }
+    }
+
+    return regressions;
+}
+
+const JsonValue* BenchmarkBaseline::findScene(const std::string& scene) const {
+    for(const auto& baselineScene : m_Baseline.at("scenes").array){
+        if(baselineScene.at("name").string == scene)
+            return &baselineScene;
+    }
+
+    return nullptr;
+}
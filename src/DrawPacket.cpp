@@ -0,0 +1,114 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "DrawPacket.h"
+
+#include <algorithm>
+#include <cstring>
+
+uint64_t DrawPacketSorter::MakeKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+    //non-negative floats order like their bit patterns, the top bits keep exponent and leading mantissa
+    depth = std::max(depth, 0.0f);
+    uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+    depthBits >>= 32 - DEPTH_BITS;
+
+    auto field = [](uint32_t value, uint32_t bits){ return static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1); };
+
+    return field(pass, PASS_BITS) << PASS_SHIFT |
+           field(pipeline, PIPELINE_BITS) << PIPELINE_SHIFT |
+           field(material, MATERIAL_BITS) << MATERIAL_SHIFT |
+           field(mesh, MESH_BITS) << MESH_SHIFT |
+           field(depthBits, DEPTH_BITS);
+}
+
+void DrawPacketSorter::Sort(std::vector<DrawPacket>& packets) {
+    size_t count = packets.size();
+    if(count < 2)
+        return;
+
+    uint32_t chunkCount = static_cast<uint32_t>(std::clamp<size_t>(count / MIN_PACKETS_PER_JOB, 1, m_ThreadPool->GetThreadCount()));
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    m_Scratch.resize(count);
+    m_Histograms.assign(static_cast<size_t>(chunkCount) * DIGIT_COUNT * RADIX, 0);
+    m_Offsets.resize(static_cast<size_t>(chunkCount) * RADIX);
+
+    //one pass over the keys counts every digit, digits shared by all packets are found from the totals
+    forEachChunk(chunkCount, chunkSize, count, [this, &packets](uint32_t chunk, size_t begin, size_t end){
+        uint32_t* histograms = m_Histograms.data() + static_cast<size_t>(chunk) * DIGIT_COUNT * RADIX;
+        for(size_t i = begin; i < end; i++){
+            uint64_t sortKey = packets[i].sortKey;
+            for(uint32_t digit = 0; digit < DIGIT_COUNT; digit++)
+                histograms[digit * RADIX + ((sortKey >> (digit * RADIX_BITS)) & (RADIX - 1))]++;
+        }
+    });
+
+    DrawPacket* source = packets.data();
+    DrawPacket* destination = m_Scratch.data();
+    bool reordered = false;
+    for(uint32_t digit = 0; digit < DIGIT_COUNT; digit++){
+        if(isSharedDigit(digit, chunkCount, count))
+            continue;
+
+        //per chunk counts only hold for the order they were taken in
+        if(reordered){
+            forEachChunk(chunkCount, chunkSize, count, [this, source, digit](uint32_t chunk, size_t begin, size_t end){
+                uint32_t* histogram = m_Histograms.data() + (static_cast<size_t>(chunk) * DIGIT_COUNT + digit) * RADIX;
+                std::fill(histogram, histogram + RADIX, 0u);
+                for(size_t i = begin; i < end; i++)
+                    histogram[(source[i].sortKey >> (digit * RADIX_BITS)) & (RADIX - 1)]++;
+            });
+        }
+
+        //bucket major, chunk minor, so earlier chunks write first within a bucket
+        uint32_t offset = 0;
+        for(uint32_t bucket = 0; bucket < RADIX; bucket++){
+            for(uint32_t chunk = 0; chunk < chunkCount; chunk++){
+                m_Offsets[chunk * RADIX + bucket] = offset;
+                offset += m_Histograms[(static_cast<size_t>(chunk) * DIGIT_COUNT + digit) * RADIX + bucket];
+            }
+        }
+
+        forEachChunk(chunkCount, chunkSize, count, [this, source, destination, digit](uint32_t chunk, size_t begin, size_t end){
+            uint32_t* offsets = m_Offsets.data() + static_cast<size_t>(chunk) * RADIX;
+            for(size_t i = begin; i < end; i++)
+                destination[offsets[(source[i].sortKey >> (digit * RADIX_BITS)) & (RADIX - 1)]++] = source[i];
+        });
+        std::swap(source, destination);
+        reordered = true;
+    }
+
+    //an odd number of scattered digits leaves the result in the scratch buffer
+    if(source != packets.data())
+        packets.swap(m_Scratch);
+}
+
+bool DrawPacketSorter::isSharedDigit(uint32_t digit, uint32_t chunkCount, size_t count) const {
+    for(uint32_t bucket = 0; bucket < RADIX; bucket++){
+        size_t bucketCount = 0;
+        for(uint32_t chunk = 0; chunk < chunkCount; chunk++)
+            bucketCount += m_Histograms[(static_cast<size_t>(chunk) * DIGIT_COUNT + digit) * RADIX + bucket];
+
+        if(bucketCount != 0)
+            return bucketCount == count;
+    }
+
+    return false;
+}
+
+template<typename Function>
+void DrawPacketSorter::forEachChunk(uint32_t chunkCount, size_t chunkSize, size_t count, const Function& function) {
+    if(chunkCount == 1){
+        function(0, 0, count);
+        return;
+    }
+
+    for(uint32_t chunk = 0; chunk < chunkCount; chunk++){
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(begin + chunkSize, count);
+        m_ThreadPool->Submit([&function, chunk, begin, end](){ function(chunk, begin, end); });
+    }
+    m_ThreadPool->Wait();
+}
@@ -0,0 +1,74 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+void FrameStatistics::AddFrame(const VulkanProfiler::FrameRecord& frameRecord) {
+    //the first frame only opens the interval
+    if(m_PreviousBeginUs >= 0.0)
+        AddSample(FRAME_TIME, (frameRecord.beginUs - m_PreviousBeginUs) / 1000.0);
+    m_PreviousBeginUs = frameRecord.beginUs;
+
+    //scope names are the literals of the render loop, a pointer match is not guaranteed across translation units
+    double recordUs = 0.0;
+    double submitUs = 0.0;
+    for(const auto& scope : frameRecord.cpuScopes){
+        if(std::strcmp(scope.name, "RecordCommandBuffer") == 0)
+            recordUs += scope.durationUs;
+        else if(std::strcmp(scope.name, "QueueSubmit") == 0)
+            submitUs += scope.durationUs;
+    }
+    AddSample(RECORD_TIME, recordUs / 1000.0);
+    AddSample(SUBMIT_TIME, submitUs / 1000.0);
+
+    //no sample without timestamp support
+    for(const auto& scope : frameRecord.gpuScopes){
+        if(std::strcmp(scope.name, "Frame") == 0)
+            AddSample(GPU_TIME, scope.durationUs / 1000.0);
+    }
+
+    m_FrameCount++;
+}
+
+void FrameStatistics::AddSample(Metric metric, double milliseconds) {
+    m_Samples[metric].push_back(milliseconds);
+}
+
+void FrameStatistics::Clear() {
+    for(auto& samples : m_Samples)
+        samples.clear();
+    m_FrameCount = 0;
+    m_PreviousBeginUs = -1.0;
+}
+
+FrameStatistics::Summary FrameStatistics::Summarize(Metric metric) const {
+    return Summarize(m_Samples[metric]);
+}
+
+FrameStatistics::Summary FrameStatistics::Summarize(std::vector<double> samples) {
+    Summary summary;
+    if(samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double percent){
+        auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    summary.count = samples.size();
+    summary.average = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    summary.min = samples.front();
+    summary.p50 = percentile(50.0);
+    summary.p95 = percentile(95.0);
+    summary.p99 = percentile(99.0);
+    summary.max = samples.back();
+
+    return summary;
+}
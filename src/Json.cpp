@@ -0,0 +1,96 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "Json.h"
+
+#include <cctype>
+
+JsonValue JsonParser::Parse() {
+    JsonValue value = parseValue();
+    skipWhitespace();
+    if(m_Position != m_Text.size())
+        throw std::runtime_error("JsonParser::Parse() -> Trailing characters!");
+    return value;
+}
+
+void JsonParser::skipWhitespace() {
+    while(m_Position < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Position])))
+        m_Position++;
+}
+
+char JsonParser::expect(char character) {
+    skipWhitespace();
+    if(m_Position >= m_Text.size() || m_Text[m_Position] != character)
+        throw std::runtime_error(std::string("JsonParser::Parse() -> Expected '") + character + "'!");
+    return m_Text[m_Position++];
+}
+
+bool JsonParser::consume(char character) {
+    skipWhitespace();
+    if(m_Position < m_Text.size() && m_Text[m_Position] == character){
+        m_Position++;
+        return true;
+    }
+    return false;
+}
+
+std::string JsonParser::parseString() {
+    expect('"');
+    std::string result;
+    while(m_Position < m_Text.size() && m_Text[m_Position] != '"'){
+        char character = m_Text[m_Position++];
+        if(character == '\\' && m_Position < m_Text.size())
+            character = m_Text[m_Position++];
+        result += character;
+    }
+    expect('"');
+
+    return result;
+}
+
+JsonValue JsonParser::parseValue() {
+    skipWhitespace();
+    if(m_Position >= m_Text.size())
+        throw std::runtime_error("JsonParser::Parse() -> Unexpected end of input!");
+
+    JsonValue value;
+    char character = m_Text[m_Position];
+    if(character == '{'){
+        value.type = JsonValue::Type::Object;
+        expect('{');
+        if(!consume('}')){
+            do {
+                std::string key = parseString();
+                expect(':');
+                value.object[key] = parseValue();
+            } while(consume(','));
+            expect('}');
+        }
+    } else if(character == '['){
+        value.type = JsonValue::Type::Array;
+        expect('[');
+        if(!consume(']')){
+            do {
+                value.array.push_back(parseValue());
+            } while(consume(','));
+            expect(']');
+        }
+    } else if(character == '"'){
+        value.type = JsonValue::Type::String;
+        value.string = parseString();
+    } else if(m_Text.compare(m_Position, 4, "true") == 0 || m_Text.compare(m_Position, 5, "false") == 0){
+        value.type = JsonValue::Type::Bool;
+        value.number = character == 't' ? 1.0 : 0.0;
+        m_Position += character == 't' ? 4 : 5;
+    } else if(m_Text.compare(m_Position, 4, "null") == 0){
+        m_Position += 4;
+    } else {
+        value.type = JsonValue::Type::Number;
+        size_t length = 0;
+        value.number = std::stod(m_Text.substr(m_Position, 32), &length);
+        m_Position += length;
+    }
+
+    return value;
+}
@@ -0,0 +1,73 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "MappedFile.h"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+void MappedFile::Open(const std::string& path) {
+    Close();
+
+#ifdef MAPPED_FILE_MMAP
+    int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if(fileDescriptor < 0)
+        throw std::runtime_error("MappedFile::Open() -> Failed to open " + path + "!");
+
+    struct stat fileStat{};
+    if(fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0){
+        close(fileDescriptor);
+        throw std::runtime_error("MappedFile::Open() -> Failed to stat " + path + "!");
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    //the mapping keeps its own reference to the file
+    close(fileDescriptor);
+
+    if(mapping == MAP_FAILED)
+        throw std::runtime_error("MappedFile::Open() -> Failed to map " + path + "!");
+
+    //ranges are read front to back once, by the uploader
+    madvise(mapping, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+    m_Data = static_cast<const char*>(mapping);
+    m_Size = static_cast<size_t>(fileStat.st_size);
+#else
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("MappedFile::Open() -> Failed to open " + path + "!");
+
+    m_FallbackData.resize(static_cast<size_t>(file.tellg()));
+    if(m_FallbackData.empty())
+        throw std::runtime_error("MappedFile::Open() -> " + path + " is empty!");
+    file.seekg(0);
+    file.read(m_FallbackData.data(), static_cast<std::streamsize>(m_FallbackData.size()));
+
+    m_Data = m_FallbackData.data();
+    m_Size = m_FallbackData.size();
+#endif
+}
+
+void MappedFile::Close() {
+#ifdef MAPPED_FILE_MMAP
+    if(m_Data && m_FallbackData.empty())
+        munmap(const_cast<char*>(m_Data), m_Size);
+#endif
+    m_FallbackData.clear();
+    m_FallbackData.shrink_to_fit();
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
@@ -0,0 +1,316 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+//offline converter from OBJ / glTF into the .vkm format read by MeshFile
+//usage: MeshConverter <input.obj|input.gltf|input.glb> <output.vkm>
+
+#include "MeshFile.h"
+#include "Json.h"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace {
+    std::string extensionOf(const std::string& path) {
+        auto dot = path.find_last_of('.');
+        std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+        for(auto& character : extension)
+            character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+
+        return extension;
+    }
+
+    std::string directoryOf(const std::string& path) {
+        auto slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+    }
+
+    std::vector<char> readBinary(const std::string& path) {
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error("MeshConverter -> Failed to open " + path + "!");
+
+        std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        return buffer;
+    }
+
+    //OBJ: v x y z [r g b], vt u v, f with v, v/vt, v//vn, v/vt/vn and negative indices, polygons are fan triangulated,
+    //o and g start a new mesh
+    void convertObj(const std::string& path, MeshFileWriter& writer) {
+        std::ifstream file(path);
+        if(!file.is_open())
+            throw std::runtime_error("MeshConverter -> Failed to open " + path + "!");
+
+        std::vector<Vertex> positions;
+        std::vector<glm::vec2> texCoords;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        //obj position and texture coordinate index to mesh vertex index, vertices are shared within a mesh only
+        std::map<std::pair<long, long>, uint32_t> remap;
+
+        auto flush = [&](){
+            if(!indices.empty())
+                writer.AddMesh(vertices, indices);
+            vertices.clear();
+            indices.clear();
+            remap.clear();
+        };
+
+        std::string line;
+        while(std::getline(file, line)){
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+
+            if(keyword == "v"){
+                Vertex vertex{};
+                float z = 0.0f;
+                stream >> vertex.position.x >> vertex.position.y >> z;
+                //a failed extraction zeroes its target, so colors are only taken when all three are present
+                float color[3];
+                if(stream >> color[0] >> color[1] >> color[2])
+                    vertex.color = glm::vec3(color[0], color[1], color[2]);
+                else
+                    vertex.color = glm::vec3(1.0f);
+                positions.push_back(vertex);
+            } else if(keyword == "vt"){
+                glm::vec2 texCoord(0.0f);
+                stream >> texCoord.x >> texCoord.y;
+                //obj puts the origin at the bottom left, Vulkan samples from the top left
+                texCoords.push_back(glm::vec2(texCoord.x, 1.0f - texCoord.y));
+            } else if(keyword == "f"){
+                auto resolve = [&path](long index, size_t count){
+                    long resolved = index < 0 ? static_cast<long>(count) + index : index - 1;
+                    if(resolved < 0 || resolved >= static_cast<long>(count))
+                        throw std::runtime_error("MeshConverter -> " + path + " references a missing vertex!");
+                    return resolved;
+                };
+
+                std::vector<uint32_t> face;
+                std::string corner;
+                while(stream >> corner){
+                    size_t slash = corner.find('/');
+                    long position = resolve(std::stol(corner.substr(0, slash)), positions.size());
+                    long texCoord = -1;
+                    if(slash != std::string::npos && slash + 1 < corner.size() && corner[slash + 1] != '/')
+                        texCoord = resolve(std::stol(corner.substr(slash + 1)), texCoords.size());
+
+                    auto [entry, inserted] = remap.emplace(std::make_pair(position, texCoord), static_cast<uint32_t>(vertices.size()));
+                    if(inserted){
+                        vertices.push_back(positions[position]);
+                        if(texCoord >= 0)
+                            vertices.back().texCoord = texCoords[texCoord];
+                    }
+                    face.push_back(entry->second);
+                }
+
+                for(size_t i = 2; i < face.size(); i++){
+                    indices.push_back(face[0]);
+                    indices.push_back(face[i - 1]);
+                    indices.push_back(face[i]);
+                }
+            } else if(keyword == "o" || keyword == "g"){
+                flush();
+            }
+        }
+
+        flush();
+    }
+
+    struct GltfAccessor {
+        const char* data;
+        size_t count;
+        size_t stride;
+        uint32_t componentType;
+        uint32_t componentCount;
+    };
+
+    constexpr uint32_t GLTF_UNSIGNED_BYTE = 5121;
+    constexpr uint32_t GLTF_UNSIGNED_SHORT = 5123;
+    constexpr uint32_t GLTF_UNSIGNED_INT = 5125;
+    constexpr uint32_t GLTF_FLOAT = 5126;
+
+    GltfAccessor resolveAccessor(const JsonValue& document, const std::vector<std::vector<char>>& buffers, uint64_t index) {
+        const JsonValue& accessor = document.at("accessors").array.at(index);
+        const JsonValue& view = document.at("bufferViews").array.at(accessor.integer("bufferView", UINT64_MAX));
+        const std::vector<char>& buffer = buffers.at(view.integer("buffer", 0));
+
+        static const std::map<std::string, uint32_t> componentCounts = {
+                {"SCALAR", 1}, {"VEC2", 2}, {"VEC3", 3}, {"VEC4", 4}
+        };
+
+        GltfAccessor result{};
+        result.count = accessor.integer("count", 0);
+        result.componentType = static_cast<uint32_t>(accessor.integer("componentType", 0));
+        result.componentCount = componentCounts.at(accessor.at("type").string);
+
+        size_t componentSize = result.componentType == GLTF_UNSIGNED_BYTE ? 1 : result.componentType == GLTF_UNSIGNED_SHORT ? 2 : 4;
+        size_t elementSize = componentSize * result.componentCount;
+        result.stride = view.integer("byteStride", elementSize);
+
+        uint64_t offset = view.integer("byteOffset", 0) + accessor.integer("byteOffset", 0);
+        if(result.count > 0 && offset + result.stride * (result.count - 1) + elementSize > buffer.size())
+            throw std::runtime_error("MeshConverter -> glTF accessor " + std::to_string(index) + " is out of range!");
+        result.data = buffer.data() + offset;
+
+        return result;
+    }
+
+    ///@brief element of a float or normalized unsigned byte/short VEC2 accessor, the types glTF allows for TEXCOORD_n
+    glm::vec2 readTexCoord(const GltfAccessor& accessor, size_t index) {
+        const char* element = accessor.data + index * accessor.stride;
+
+        glm::vec2 texCoord;
+        if(accessor.componentType == GLTF_FLOAT)
+            std::memcpy(&texCoord, element, sizeof(texCoord));
+        else if(accessor.componentType == GLTF_UNSIGNED_SHORT){
+            uint16_t components[2];
+            std::memcpy(components, element, sizeof(components));
+            texCoord = glm::vec2(components[0] / 65535.0f, components[1] / 65535.0f);
+        } else
+            texCoord = glm::vec2(static_cast<uint8_t>(element[0]) / 255.0f, static_cast<uint8_t>(element[1]) / 255.0f);
+
+        return texCoord;
+    }
+
+    //glTF 2.0 triangle primitives: POSITION (float), optional COLOR_0 (float VEC3/VEC4), TEXCOORD_0 (float or
+    //normalized u8/u16 VEC2) and indices (u8/u16/u32),
+    //buffers from .bin files or the GLB binary chunk, data URIs are not supported
+    void convertGltf(const std::string& path, MeshFileWriter& writer) {
+        std::vector<char> file = readBinary(path);
+        std::string json;
+        std::vector<std::vector<char>> buffers;
+        std::vector<char> binaryChunk;
+
+        if(extensionOf(path) == "glb"){
+            //12 byte header, then chunks of {length, type, data}
+            size_t position = 12;
+            while(position + 8 <= file.size()){
+                uint32_t length, type;
+                std::memcpy(&length, file.data() + position, 4);
+                std::memcpy(&type, file.data() + position + 4, 4);
+                if(position + 8 + length > file.size())
+                    throw std::runtime_error("MeshConverter -> " + path + " has a truncated chunk!");
+
+                const char* chunk = file.data() + position + 8;
+                if(type == 0x4E4F534A) //JSON
+                    json.assign(chunk, length);
+                else if(type == 0x004E4942) //BIN
+                    binaryChunk.assign(chunk, chunk + length);
+                position += 8 + length;
+            }
+        } else {
+            json.assign(file.begin(), file.end());
+        }
+
+        JsonValue document = JsonParser(json).Parse();
+
+        for(const auto& buffer : document.at("buffers").array){
+            auto uri = buffer.find("uri");
+            if(!uri)
+                buffers.push_back(binaryChunk);
+            else if(uri->string.rfind("data:", 0) == 0)
+                throw std::runtime_error("MeshConverter -> Embedded data URIs are not supported!");
+            else
+                buffers.push_back(readBinary(directoryOf(path) + uri->string));
+        }
+
+        for(const auto& mesh : document.at("meshes").array){
+            for(const auto& primitive : mesh.at("primitives").array){
+                if(primitive.integer("mode", 4) != 4)
+                    continue;
+
+                const JsonValue& attributes = primitive.at("attributes");
+                GltfAccessor positions = resolveAccessor(document, buffers, attributes.integer("POSITION", UINT64_MAX));
+                if(positions.componentType != GLTF_FLOAT || positions.componentCount < 2)
+                    throw std::runtime_error("MeshConverter -> Only float positions are supported!");
+
+                std::unique_ptr<GltfAccessor> colors;
+                if(attributes.find("COLOR_0")){
+                    colors = std::make_unique<GltfAccessor>(resolveAccessor(document, buffers, attributes.integer("COLOR_0", 0)));
+                    if(colors->componentType != GLTF_FLOAT || colors->componentCount < 3 || colors->count != positions.count)
+                        throw std::runtime_error("MeshConverter -> Only float COLOR_0 is supported!");
+                }
+
+                std::unique_ptr<GltfAccessor> texCoords;
+                if(attributes.find("TEXCOORD_0")){
+                    texCoords = std::make_unique<GltfAccessor>(resolveAccessor(document, buffers, attributes.integer("TEXCOORD_0", 0)));
+                    bool supportedType = texCoords->componentType == GLTF_FLOAT || texCoords->componentType == GLTF_UNSIGNED_BYTE ||
+                                         texCoords->componentType == GLTF_UNSIGNED_SHORT;
+                    if(!supportedType || texCoords->componentCount != 2 || texCoords->count != positions.count)
+                        throw std::runtime_error("MeshConverter -> Only float and normalized unsigned byte/short VEC2 TEXCOORD_0 is supported!");
+                }
+
+                std::vector<Vertex> vertices(positions.count);
+                for(size_t i = 0; i < positions.count; i++){
+                    std::memcpy(&vertices[i].position, positions.data + i * positions.stride, sizeof(glm::vec2));
+                    vertices[i].color = glm::vec3(1.0f);
+                    if(colors)
+                        std::memcpy(&vertices[i].color, colors->data + i * colors->stride, sizeof(glm::vec3));
+                    if(texCoords)
+                        vertices[i].texCoord = readTexCoord(*texCoords, i);
+                }
+
+                std::vector<uint32_t> indices;
+                if(primitive.find("indices")){
+                    GltfAccessor indexAccessor = resolveAccessor(document, buffers, primitive.integer("indices", 0));
+                    indices.resize(indexAccessor.count);
+                    for(size_t i = 0; i < indexAccessor.count; i++){
+                        const char* element = indexAccessor.data + i * indexAccessor.stride;
+                        if(indexAccessor.componentType == GLTF_UNSIGNED_BYTE)
+                            indices[i] = static_cast<uint8_t>(*element);
+                        else if(indexAccessor.componentType == GLTF_UNSIGNED_SHORT){
+                            uint16_t index;
+                            std::memcpy(&index, element, sizeof(index));
+                            indices[i] = index;
+                        } else if(indexAccessor.componentType == GLTF_UNSIGNED_INT)
+                            std::memcpy(&indices[i], element, sizeof(uint32_t));
+                        else
+                            throw std::runtime_error("MeshConverter -> Unsupported index type!");
+                    }
+                } else {
+                    indices.resize(positions.count);
+                    for(size_t i = 0; i < positions.count; i++)
+                        indices[i] = static_cast<uint32_t>(i);
+                }
+
+                writer.AddMesh(vertices, indices);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if(argc != 3){
+        std::cerr << "usage: " << argv[0] << " <input.obj|input.gltf|input.glb> <output.vkm>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try{
+        MeshFileWriter writer;
+        std::string extension = extensionOf(argv[1]);
+        if(extension == "obj")
+            convertObj(argv[1], writer);
+        else if(extension == "gltf" || extension == "glb")
+            convertGltf(argv[1], writer);
+        else
+            throw std::runtime_error("MeshConverter -> Unsupported input format " + extension + "!");
+
+        writer.Write(argv[2]);
+        std::cout << "Wrote " << writer.GetMeshCount() << " meshes to " << argv[2] << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "MeshFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+void MeshFile::Open(const std::string& path) {
+    Close();
+    m_File.Open(path);
+
+    try {
+        validate(path);
+    } catch (...) {
+        Close();
+        throw;
+    }
+}
+
+void MeshFile::Close() {
+    m_File.Close();
+    m_Header = nullptr;
+    m_Meshes = nullptr;
+}
+
+const Vertex* MeshFile::GetVertices(uint32_t mesh) const {
+    return reinterpret_cast<const Vertex*>(m_File.GetData() + m_Header->vertexBlobOffset) + m_Meshes[mesh].firstVertex;
+}
+
+const uint32_t* MeshFile::GetIndices(uint32_t mesh) const {
+    return reinterpret_cast<const uint32_t*>(m_File.GetData() + m_Header->indexBlobOffset) + m_Meshes[mesh].firstIndex;
+}
+
+void MeshFile::validate(const std::string& path) {
+    if(m_File.GetSize() < sizeof(MeshFileHeader))
+        throw std::runtime_error("MeshFile::Open() -> " + path + " is too small!");
+
+    auto header = reinterpret_cast<const MeshFileHeader*>(m_File.GetData());
+    if(std::memcmp(header->magic, MeshFileHeader::MAGIC, sizeof(header->magic)) != 0)
+        throw std::runtime_error("MeshFile::Open() -> " + path + " is not a mesh file!");
+    if(header->version != MeshFileHeader::VERSION)
+        throw std::runtime_error("MeshFile::Open() -> " + path + " has unsupported version " + std::to_string(header->version) + "!");
+    if(header->vertexStride != sizeof(Vertex) || header->indexSize != sizeof(uint32_t))
+        throw std::runtime_error("MeshFile::Open() -> " + path + " has a different vertex or index layout!");
+
+    //every range has to lie inside the file
+    uint64_t meshTableSize = static_cast<uint64_t>(header->meshCount) * sizeof(MeshFileEntry);
+    if(!m_File.Contains(header->meshTableOffset, meshTableSize) ||
+       !m_File.Contains(header->vertexBlobOffset, header->vertexBlobSize) ||
+       !m_File.Contains(header->indexBlobOffset, header->indexBlobSize))
+        throw std::runtime_error("MeshFile::Open() -> " + path + " is truncated!");
+    if(header->meshTableOffset % alignof(MeshFileEntry) != 0 ||
+       header->vertexBlobOffset % MESH_FILE_ALIGNMENT != 0 || header->indexBlobOffset % MESH_FILE_ALIGNMENT != 0)
+        throw std::runtime_error("MeshFile::Open() -> " + path + " has misaligned sections!");
+
+    uint64_t vertexCount = header->vertexBlobSize / sizeof(Vertex);
+    uint64_t indexCount = header->indexBlobSize / sizeof(uint32_t);
+    auto meshes = reinterpret_cast<const MeshFileEntry*>(m_File.GetData() + header->meshTableOffset);
+    for(uint32_t i = 0; i < header->meshCount; i++){
+        if(static_cast<uint64_t>(meshes[i].firstVertex) + meshes[i].vertexCount > vertexCount ||
+           static_cast<uint64_t>(meshes[i].firstIndex) + meshes[i].indexCount > indexCount)
+            throw std::runtime_error("MeshFile::Open() -> " + path + " mesh " + std::to_string(i) + " is out of range!");
+    }
+
+    m_Header = header;
+    m_Meshes = meshes;
+}
+
+uint32_t MeshFileWriter::AddMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    for(uint32_t index : indices){
+        if(index >= vertices.size())
+            throw std::runtime_error("MeshFileWriter::AddMesh() -> Index out of range!");
+    }
+
+    MeshFileEntry entry{};
+    entry.vertexCount = static_cast<uint32_t>(vertices.size());
+    entry.indexCount = static_cast<uint32_t>(indices.size());
+    entry.firstVertex = static_cast<uint32_t>(m_Vertices.size());
+    entry.firstIndex = static_cast<uint32_t>(m_Indices.size());
+
+    //bounding box center with the farthest vertex as radius, same fit the renderer uses for the built-in mesh
+    if(!vertices.empty()){
+        float minPosition[2] = {vertices[0].position.x, vertices[0].position.y};
+        float maxPosition[2] = {vertices[0].position.x, vertices[0].position.y};
+        for(const auto& vertex : vertices){
+            minPosition[0] = std::min(minPosition[0], vertex.position.x);
+            minPosition[1] = std::min(minPosition[1], vertex.position.y);
+            maxPosition[0] = std::max(maxPosition[0], vertex.position.x);
+            maxPosition[1] = std::max(maxPosition[1], vertex.position.y);
+        }
+
+        entry.boundingSphere[0] = (minPosition[0] + maxPosition[0]) * 0.5f;
+        entry.boundingSphere[1] = (minPosition[1] + maxPosition[1]) * 0.5f;
+        for(const auto& vertex : vertices){
+            float dx = vertex.position.x - entry.boundingSphere[0];
+            float dy = vertex.position.y - entry.boundingSphere[1];
+            entry.boundingSphere[3] = std::max(entry.boundingSphere[3], std::sqrt(dx * dx + dy * dy));
+        }
+    }
+
+    m_Vertices.insert(m_Vertices.end(), vertices.begin(), vertices.end());
+    m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+    m_Meshes.push_back(entry);
+
+    return static_cast<uint32_t>(m_Meshes.size() - 1);
+}
+
+void MeshFileWriter::Write(const std::string& path) const {
+    MeshFileHeader header{};
+    std::memcpy(header.magic, MeshFileHeader::MAGIC, sizeof(header.magic));
+    header.version = MeshFileHeader::VERSION;
+    header.vertexStride = sizeof(Vertex);
+    header.indexSize = sizeof(uint32_t);
+    header.meshCount = static_cast<uint32_t>(m_Meshes.size());
+    header.meshTableOffset = sizeof(MeshFileHeader);
+    header.vertexBlobOffset = alignUp(header.meshTableOffset + m_Meshes.size() * sizeof(MeshFileEntry), MESH_FILE_ALIGNMENT);
+    header.vertexBlobSize = m_Vertices.size() * sizeof(Vertex);
+    header.indexBlobOffset = alignUp(header.vertexBlobOffset + header.vertexBlobSize, MESH_FILE_ALIGNMENT);
+    header.indexBlobSize = m_Indices.size() * sizeof(uint32_t);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+        throw std::runtime_error("MeshFileWriter::Write() -> Failed to open " + path + "!");
+
+    //padding up to the next section offset
+    auto pad = [&file](uint64_t offset){
+        static const char zeros[MESH_FILE_ALIGNMENT] = {};
+        auto position = static_cast<uint64_t>(file.tellp());
+        file.write(zeros, static_cast<std::streamsize>(offset - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_Meshes.data()), static_cast<std::streamsize>(m_Meshes.size() * sizeof(MeshFileEntry)));
+    pad(header.vertexBlobOffset);
+    file.write(reinterpret_cast<const char*>(m_Vertices.data()), static_cast<std::streamsize>(header.vertexBlobSize));
+    pad(header.indexBlobOffset);
+    file.write(reinterpret_cast<const char*>(m_Indices.data()), static_cast<std::streamsize>(header.indexBlobSize));
+
+    if(!file)
+        throw std::runtime_error("MeshFileWriter::Write() -> Failed to write " + path + "!");
+}
@@ -4,6 +4,16 @@
 
 #include "RenderEngine.h"
 
+#include <cstring>
+
+//set by CMake, fallbacks for builds running from the source tree
+#ifndef SHADER_SOURCE_DIR
+#define SHADER_SOURCE_DIR "shaders"
+#endif
+#ifndef GLSLC_EXECUTABLE
+#define GLSLC_EXECUTABLE "glslc"
+#endif
+
 MyRenderer::RenderEngine::RenderEngine(uint32_t width, uint32_t height, const std::string &title) {
     m_Width = width;
     m_Height = height;
@@ -11,15 +21,84 @@ MyRenderer::RenderEngine::RenderEngine(uint32_t width, uint32_t height, const st
 
     m_VulkanInstance = new VulkanInstance(ENABLE_VALIDATION_LAYERS);
     m_VulkanDebugMessenger = new VulkanDebugMessenger(ENABLE_VALIDATION_LAYERS);
+    m_VulkanPipelineCache = new VulkanPipelineCache("pipeline_cache.bin");
+    m_VulkanPipelineRegistry = new VulkanPipelineRegistry();
+    m_VulkanBindlessDescriptors = new VulkanBindlessDescriptors(65536, 65536);
+    m_VulkanMemoryAllocator = new VulkanMemoryAllocator();
+    //16k objects per frame with room to spare for uniform blocks
+    m_VulkanFrameData = new VulkanFrameData(m_VulkanMemoryAllocator, 16384 * sizeof(ObjectData) + 64 * 1024, sizeof(FrameUniforms));
+    m_VulkanUploader = new VulkanUploader(m_VulkanMemoryAllocator, 16 * 1024 * 1024);
+    m_AssetStreamer = new AssetStreamer(m_VulkanUploader);
+    m_VulkanTextureManager = new VulkanTextureManager(m_VulkanMemoryAllocator, m_AssetStreamer, m_VulkanBindlessDescriptors);
+    m_ThreadPool = new ThreadPool();
+    m_PipelineCompilePool = new ThreadPool();
+    m_VulkanCommandRecorder = new VulkanCommandRecorder(m_ThreadPool);
+    m_DrawPacketSorter = new DrawPacketSorter(m_ThreadPool);
+    m_VulkanProfiler = new VulkanProfiler();
+    m_VulkanDeletionQueue = new VulkanDeletionQueue();
+    m_ShaderManager = new ShaderManager(SHADER_SOURCE_DIR, "shaders", GLSLC_EXECUTABLE);
 }
 
 void MyRenderer::RenderEngine::Run() {
-    initWindow(); //initiate GLFW Window
+    m_StartTime = std::chrono::steady_clock::now();
+
+    if(!m_Headless)
+        initWindow(); //initiate GLFW Window
     initVulkan();
     mainLoop();
     cleanup();
 }
 
+void MyRenderer::RenderEngine::SetHeadless(bool headless, uint32_t frameCount) {
+    m_Headless = headless;
+    m_HeadlessFrameCount = frameCount;
+}
+
+void MyRenderer::RenderEngine::SetTraceOutput(const std::string& path) {
+    m_TraceOutputPath = path;
+}
+
+void MyRenderer::RenderEngine::SetFrameStatistics(FrameStatistics* frameStatistics, uint32_t warmupFrames) {
+    m_FrameStatistics = frameStatistics;
+    m_WarmupFrames = warmupFrames;
+}
+
+void MyRenderer::RenderEngine::SetLatencyMode(LatencyMode latencyMode) {
+    m_RequestedLatencyMode = latencyMode;
+}
+
+void MyRenderer::RenderEngine::SetTimelineSync(bool timelineSync) {
+    m_TimelineSync = timelineSync;
+}
+
+void MyRenderer::RenderEngine::SetMsaaSamples(uint32_t sampleCount) {
+    m_RequestedMsaaSamples = sampleCount;
+}
+
+void MyRenderer::RenderEngine::SetGpuCulling(bool gpuCulling) {
+    m_GpuCulling = gpuCulling;
+}
+
+void MyRenderer::RenderEngine::SetAsyncCompute(bool asyncCompute) {
+    m_AsyncCompute = asyncCompute;
+}
+
+void MyRenderer::RenderEngine::SetSceneFile(const std::string& path) {
+    m_SceneFilePath = path;
+}
+
+void MyRenderer::RenderEngine::SetTextureFile(const std::string& path) {
+    m_TextureFilePath = path;
+}
+
+void MyRenderer::RenderEngine::SetUploadBudget(VkDeviceSize bytesPerFrame) {
+    m_AssetStreamer->SetUploadBudget(bytesPerFrame);
+}
+
+void MyRenderer::RenderEngine::AddInstanceBatch(const InstanceBatch* instanceBatch) {
+    m_InstanceBatches.push_back(instanceBatch);
+}
+
 void MyRenderer::RenderEngine::initWindow() {
     glfwInit();
 
@@ -29,6 +108,7 @@ void MyRenderer::RenderEngine::initWindow() {
     m_Window = glfwCreateWindow((int)m_Width,(int)m_Height, m_Title.c_str(), nullptr, nullptr);
     glfwSetWindowUserPointer(m_Window, this);
     glfwSetFramebufferSizeCallback(m_Window, framebufferResizeCallback);
+    glfwSetKeyCallback(m_Window, keyCallback);
 }
 
 void MyRenderer::RenderEngine::initVulkan() {
@@ -36,17 +116,82 @@ void MyRenderer::RenderEngine::initVulkan() {
     m_VulkanInstance->SetEngineName("RenderEngine");
     m_VulkanInstance->AddExtensions(getRequiredExtensions());
     m_VulkanInstance->AddValidationLayers({"VK_LAYER_KHRONOS_validation"});
+    //descriptor indexing for the bindless set is core in 1.2
+    m_VulkanInstance->SetApiVersion(VK_API_VERSION_1_2);
     m_VulkanInstance->Create();
 
     m_VulkanDebugMessenger->Create(m_VulkanInstance->Instance);
 
-    if(createVkSurfaceKHR() != VK_SUCCESS)
-        throw std::runtime_error("Failed to create surface!");
+    m_LatencyMode = m_RequestedLatencyMode;
+    m_FramesInFlight = getLatencyPolicy(m_LatencyMode).framesInFlight;
+
+    if(!m_Headless) {
+        m_DeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+        if(createVkSurfaceKHR() != VK_SUCCESS)
+            throw std::runtime_error("Failed to create surface!");
+    }
     if(createVkPhysicalDevice() != VK_SUCCESS)
         throw std::runtime_error("Failed to create physical device!");
+    if(m_TimelineSync && !checkTimelineSemaphoreSupport(m_PhysicalDevice)){
+        std::cerr << "Timeline semaphores are not supported, falling back to frame fences" << std::endl;
+        m_TimelineSync = false;
+    }
+    if(m_GpuCulling && !VulkanGpuCuller::CheckSupport(m_PhysicalDevice)){
+        std::cerr << "Indirect count draws are not supported, falling back to CPU recorded draws" << std::endl;
+        m_GpuCulling = false;
+    }
+    //culling is the only async compute work so far
+    if(m_AsyncCompute && (!m_GpuCulling || !chooseAsyncComputeFamily(findQueueFamilies(m_PhysicalDevice)).has_value())){
+        std::cerr << "Async compute needs GPU culling and a second compute capable queue, culling stays on the graphics queue" << std::endl;
+        m_AsyncCompute = false;
+    }
     if(createVkLogicalDevice() != VK_SUCCESS)
         throw std::runtime_error("Failed to create logical device!");
-    if(createVkSwapChain() != VK_SUCCESS)
+
+    m_VulkanPipelineCache->Create(m_LogicalDevice, m_PhysicalDevice);
+    m_VulkanPipelineRegistry->Create(m_LogicalDevice, m_VulkanPipelineCache->PipelineCache);
+    m_VulkanBindlessDescriptors->Create(m_PhysicalDevice, m_LogicalDevice);
+    QueueFamilyIndices indices = findQueueFamilies(m_PhysicalDevice);
+
+    //frame data is read by both queues, a separate compute family shares the ring concurrently
+    std::vector<uint32_t> frameDataQueueFamilies;
+    if(m_AsyncCompute)
+        frameDataQueueFamilies = {indices.graphicsFamily.value(), chooseAsyncComputeFamily(indices).value()};
+    if(frameDataQueueFamilies.size() == 2 && frameDataQueueFamilies[0] == frameDataQueueFamilies[1])
+        frameDataQueueFamilies.pop_back();
+
+    //the frame data ring allocates through the allocator
+    m_VulkanMemoryAllocator->Create(m_PhysicalDevice, m_LogicalDevice);
+    m_VulkanFrameData->Create(m_PhysicalDevice, m_LogicalDevice, m_FramesInFlight, frameDataQueueFamilies);
+
+    m_MsaaSamples = chooseMsaaSampleCount();
+    m_DepthFormat = chooseDepthFormat();
+
+    m_VulkanUploader->Create(m_LogicalDevice, m_TransferQueue,
+                             indices.transferFamily.value_or(indices.graphicsFamily.value()),
+                             indices.graphicsFamily.value());
+    m_VulkanProfiler->Create(m_PhysicalDevice, m_LogicalDevice, indices.graphicsFamily.value(), m_FramesInFlight);
+    if(m_FrameStatistics){
+        m_VulkanProfiler->SetFrameCallback([this](const VulkanProfiler::FrameRecord& frameRecord){
+            if(frameRecord.frameNumber >= m_MeasureFromFrame)
+                m_FrameStatistics->AddFrame(frameRecord);
+        });
+    }
+    m_VulkanTextureManager->Create(m_PhysicalDevice, m_LogicalDevice, [this](VulkanDeletionQueue::Deleter deleter){
+        deferDestroy(std::move(deleter));
+    });
+    if(m_AsyncCompute){
+        m_VulkanAsyncCompute = new VulkanAsyncCompute();
+        m_VulkanAsyncCompute->Create(m_LogicalDevice, m_ComputeQueue, chooseAsyncComputeFamily(indices).value(),
+                                     indices.graphicsFamily.value(), m_FramesInFlight);
+    }
+
+    if(m_Headless) {
+        if(createVkOffscreenImages() != VK_SUCCESS)
+            throw std::runtime_error("Failed to create offscreen images!");
+    }
+    else if(createVkSwapChain() != VK_SUCCESS)
         throw std::runtime_error("Failed to create swap chain!");
     if(createVkSwapChainImageViews() != VK_SUCCESS)
         throw std::runtime_error("Failed to create swap chain image views!");
@@ -54,40 +199,139 @@ void MyRenderer::RenderEngine::initVulkan() {
         throw std::runtime_error("Failed to create render pass!");
     if(createVkGraphicsPipeline() != VK_SUCCESS)
         throw std::runtime_error("Failed to create graphics pipeline!");
+    buildRenderGraph();
     if(createVkFrameBuffers() != VK_SUCCESS)
         throw std::runtime_error("Failed to create framebuffers!");
     if(createVkCommandPool() != VK_SUCCESS)
         throw std::runtime_error("Failed to create command pool!");
+
+    //mapping and validating is cheap, the blobs are read by the asset streamer's I/O threads
+    auto sceneFile = std::make_shared<MeshFile>();
+    if(!m_SceneFilePath.empty())
+        sceneFile->Open(m_SceneFilePath);
+    if(createVkVertexBuffer(*sceneFile) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create vertex buffer!");
+    if(createVkIndexBuffer(*sceneFile) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create index buffer!");
+
+    m_Objects.push_back({glm::mat4(1.0f)});
+    DrawCommand triangleDraw{static_cast<uint32_t>(m_Indices.size()), 0, 0};
+    triangleDraw.boundingSphere = computeBoundingSphere(m_Vertices, m_Indices);
+    m_DrawList.push_back(triangleDraw);
+    m_ReadyDrawCount = 1;
+    streamSceneFile(sceneFile);
+    if(!m_TextureFilePath.empty()){
+        uint32_t textureId = m_VulkanTextureManager->Load(m_TextureFilePath);
+        for(auto& drawCommand : m_DrawList)
+            drawCommand.textureId = textureId;
+
+        if(ENABLE_VALIDATION_LAYERS){
+            VulkanTextureManager::MemoryStats memoryStats = m_VulkanTextureManager->GetMemoryStats();
+            std::cout << "Texture " << m_TextureFilePath << ": " << m_VulkanTextureManager->GetLevelCount(textureId) << " levels, "
+                      << memoryStats.deviceBytes / 1024 << " KiB on device, " << memoryStats.rgba8Bytes / 1024 << " KiB as RGBA8" << std::endl;
+        }
+    }
+    if(m_GpuCulling){
+        m_VulkanGpuCuller = new VulkanGpuCuller(m_VulkanMemoryAllocator, m_VulkanUploader);
+        m_VulkanGpuCuller->Create(m_LogicalDevice, m_VulkanPipelineCache->PipelineCache, m_VulkanFrameData->DescriptorSetLayout,
+                                  readFile("shaders/cull.comp.bin"), m_FramesInFlight);
+        m_VulkanGpuCuller->SetInstances(buildCullInstances());
+        m_VulkanGpuCuller->SetActiveInstanceCount(m_ReadyDrawCount);
+    }
+    m_VulkanCommandRecorder->Create(m_LogicalDevice, indices.graphicsFamily.value(), m_FramesInFlight);
     if(createVkCommandBuffers() != VK_SUCCESS)
         throw std::runtime_error("Failed to create command buffer!");
     if(createVkSynchronizationObjects() != VK_SUCCESS)
         throw std::runtime_error("Failed to create synchronization objects!");
+
+    //release builds ship the binaries built by CMake, only iterate on shaders in debug
+    if(ENABLE_VALIDATION_LAYERS && !m_Headless){
+        if(!m_ShaderManager->Start([this](const std::vector<std::string>& shaderNames){ onShadersReloaded(shaderNames); }))
+            std::cerr << "Shader hot reload is not available for " << SHADER_SOURCE_DIR << std::endl;
+    }
 }
 
 void MyRenderer::RenderEngine::recreateSwapChain() {
     int width = 0;
     int height = 0;
     glfwGetFramebufferSize(m_Window, &width, &height);
-    while(width == 0 || height == 0){
-        glfwGetFramebufferSize(m_Window, &width, &height);
-        glfwWaitEvents();
+
+    //minimized, mainLoop() waits for events until the window has a size again
+    if(width == 0 || height == 0){
+        m_FrameBufferResized = true;
+        return;
     }
 
-    vkDeviceWaitIdle(m_LogicalDevice);
+    //frames in flight may still render into the old framebuffers, they are destroyed once those frames completed
+    deferDestroy([device = m_LogicalDevice, swapChain = m_SwapChainKHR,
+                  imageViews = std::move(m_SwapChainImageViews), frameBuffers = std::move(m_SwapChainFrameBuffers)]{
+        for(auto& framebuffer : frameBuffers)
+            vkDestroyFramebuffer(device, framebuffer, nullptr);
+        for(auto& imageView : imageViews)
+            vkDestroyImageView(device, imageView, nullptr);
+        vkDestroySwapchainKHR(device, swapChain, nullptr);
+    });
 
-    cleanupSwapChain();
+    m_SwapChainImageViews.clear();
+    m_SwapChainFrameBuffers.clear();
 
+    //old swap chain is passed as oldSwapchain, so the driver can reuse its resources and no device wait is needed
     if(createVkSwapChain() != VK_SUCCESS)
         throw std::runtime_error("Failed to create swap chain!");
     if(createVkSwapChainImageViews() != VK_SUCCESS)
         throw std::runtime_error("Failed to create swap chain image views!");
+
+    //transient attachments follow the swap chain extent
+    deferDestroy([renderGraph = m_RenderGraph]{ delete renderGraph; });
+    buildRenderGraph();
+
     if(createVkFrameBuffers() != VK_SUCCESS)
         throw std::runtime_error("Failed to create framebuffers!");
 }
 
+void MyRenderer::RenderEngine::deferDestroy(VulkanDeletionQueue::Deleter deleter) {
+    //the frame being recorded has not been submitted yet, but may already reference the resource
+    m_VulkanDeletionQueue->Push(m_SubmittedFrameCount + 1, std::move(deleter));
+}
+
+void MyRenderer::RenderEngine::collectCompletedFrames() {
+    if(m_TimelineSync){
+        //timeline value is the last completed frame, which may be ahead of the slot just waited on
+        uint64_t timelineValue = 0;
+        vkGetSemaphoreCounterValue(m_LogicalDevice, m_FrameTimelineSemaphore, &timelineValue);
+        m_CompletedFrameCount = std::max(m_CompletedFrameCount, timelineValue);
+    }
+    else {
+        //frames complete in submission order, so every frame up to the one last submitted in this slot is done
+        m_CompletedFrameCount = std::max(m_CompletedFrameCount, m_FrameSlotSubmissions[m_CurrentFrame]);
+    }
+    m_VulkanDeletionQueue->Collect(m_CompletedFrameCount);
+}
+
 void MyRenderer::RenderEngine::mainLoop() {
-    while(!glfwWindowShouldClose(m_Window)){
+    if(m_Headless) {
+        uint32_t frame = 0;
+        while(frame < m_HeadlessFrameCount){
+            updateMeasuring();
+            drawHeadlessFrame();
+            if(m_VulkanProfiler->GetFrameNumber() >= m_MeasureFromFrame || !m_FrameStatistics)
+                frame++;
+        }
+    }
+
+    while(!m_Headless && !glfwWindowShouldClose(m_Window)){
+        int width = 0;
+        int height = 0;
+        glfwGetFramebufferSize(m_Window, &width, &height);
+
+        //nothing to present while minimized, block on events instead of spinning
+        if(width == 0 || height == 0){
+            glfwWaitEvents();
+            continue;
+        }
+
         glfwPollEvents();
+        updateMeasuring();
         drawFrame();
     }
 
@@ -95,30 +339,69 @@ void MyRenderer::RenderEngine::mainLoop() {
 }
 
 void MyRenderer::RenderEngine::cleanup() {
-    cleanupSwapChain();
+    //the watcher thread builds pipelines, stop it before anything it uses goes away
+    delete m_ShaderManager;
+    applyReloadedPipelines();
 
-    for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++){
-        vkDestroySemaphore(m_LogicalDevice, m_ImageAvailableSemaphores[i], nullptr);
-        vkDestroySemaphore(m_LogicalDevice, m_RenderFinishedSemaphores[i], nullptr);
-        vkDestroyFence(m_LogicalDevice, m_InFlightFences[i], nullptr);
-    }
+    //deleters may reference the allocator or device, run them while both are alive
+    m_VulkanDeletionQueue->Flush();
+    delete m_VulkanDeletionQueue;
+
+    cleanupSwapChain();
+    destroyVkSynchronizationObjects();
 
     vkDestroyCommandPool(m_LogicalDevice, m_CommandPool, nullptr);
-    vkDestroyPipeline(m_LogicalDevice, m_GraphicsPipeline, nullptr);
+    delete m_VulkanCommandRecorder;
+    delete m_RenderGraph;
+
+    //frames still in flight at exit reach the statistics too
+    m_VulkanProfiler->Flush();
+    if(!m_TraceOutputPath.empty())
+        m_VulkanProfiler->WriteChromeTrace(m_TraceOutputPath);
+    delete m_VulkanProfiler;
+
+    delete m_DrawPacketSorter;
+    delete m_ThreadPool;
+
+    //stops queued loads and joins the I/O threads before the uploader goes away
+    delete m_AssetStreamer;
+    delete m_VulkanTextureManager;
+    delete m_VulkanGpuCuller;
+    delete m_VulkanAsyncCompute;
+    delete m_InstanceRing;
+    delete m_VulkanUploader;
+    delete m_VulkanFrameData;
+    m_VulkanMemoryAllocator->DestroyBuffer(m_VertexBuffer, m_VertexBufferAllocation);
+    m_VulkanMemoryAllocator->DestroyBuffer(m_IndexBuffer, m_IndexBufferAllocation);
+
+    //waits for pipelines still compiling
+    delete m_VulkanPipelineRegistry;
+    delete m_PipelineCompilePool;
+    delete m_VulkanBindlessDescriptors;
     vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr);
     vkDestroyRenderPass(m_LogicalDevice, m_RenderPass, nullptr);
 
+    m_VulkanPipelineCache->Save();
+    delete m_VulkanPipelineCache;
+
+    if(ENABLE_VALIDATION_LAYERS)
+        m_VulkanMemoryAllocator->PrintStatistics();
+    delete m_VulkanMemoryAllocator;
+
     vkDestroyDevice(m_LogicalDevice, nullptr);
 
     if(ENABLE_VALIDATION_LAYERS)
         delete m_VulkanDebugMessenger;
 
-    vkDestroySurfaceKHR(m_VulkanInstance->Instance, m_SurfaceKHR, nullptr);
+    if(!m_Headless)
+        vkDestroySurfaceKHR(m_VulkanInstance->Instance, m_SurfaceKHR, nullptr);
 
     delete m_VulkanInstance;
 
-    glfwDestroyWindow(m_Window);
-    glfwTerminate();
+    if(!m_Headless) {
+        glfwDestroyWindow(m_Window);
+        glfwTerminate();
+    }
 }
 
 void MyRenderer::RenderEngine::cleanupSwapChain() {
@@ -128,19 +411,108 @@ void MyRenderer::RenderEngine::cleanupSwapChain() {
     for(auto& imageView : m_SwapChainImageViews)
         vkDestroyImageView(m_LogicalDevice, imageView, nullptr);
 
-    vkDestroySwapchainKHR(m_LogicalDevice, m_SwapChainKHR, nullptr);
+    m_SwapChainFrameBuffers.clear();
+    m_SwapChainImageViews.clear();
+
+    if(m_Headless) {
+        for(size_t i = 0; i < m_OffscreenImages.size(); i++)
+            m_VulkanMemoryAllocator->DestroyImage(m_OffscreenImages[i], m_OffscreenImageAllocations[i]);
+    }
+    else {
+        vkDestroySwapchainKHR(m_LogicalDevice, m_SwapChainKHR, nullptr);
+        m_SwapChainKHR = VK_NULL_HANDLE;
+    }
+}
+
+void MyRenderer::RenderEngine::applyLatencyMode() {
+    LatencyPolicy latencyPolicy = getLatencyPolicy(m_RequestedLatencyMode);
+
+    //mode switches are rare, a full wait keeps the per-frame resize simple
+    vkDeviceWaitIdle(m_LogicalDevice);
+
+    m_LatencyMode = m_RequestedLatencyMode;
+    m_FramesInFlight = latencyPolicy.framesInFlight;
+    m_CurrentFrame = 0;
+
+    m_CompletedFrameCount = m_SubmittedFrameCount;
+    m_FrameSlotSubmissions.assign(m_FramesInFlight, m_SubmittedFrameCount);
+    m_VulkanDeletionQueue->Flush();
+
+    //regrows for the new slot count on the next frame
+    delete m_InstanceRing;
+    m_InstanceRing = nullptr;
+    m_InstanceRingFrameSize = 0;
+
+    destroyVkSynchronizationObjects();
+    vkFreeCommandBuffers(m_LogicalDevice, m_CommandPool, static_cast<uint32_t>(m_CommandBuffers.size()), m_CommandBuffers.data());
+
+    if(createVkCommandBuffers() != VK_SUCCESS)
+        throw std::runtime_error("Failed to create command buffer!");
+    if(createVkSynchronizationObjects() != VK_SUCCESS)
+        throw std::runtime_error("Failed to create synchronization objects!");
+
+    m_VulkanCommandRecorder->SetFramesInFlight(m_FramesInFlight);
+    m_VulkanProfiler->SetFramesInFlight(m_FramesInFlight);
+    m_AssetStreamer->SetFramesInFlight(m_FramesInFlight);
+    m_VulkanFrameData->Resize(m_FramesInFlight);
+    if(m_VulkanGpuCuller)
+        m_VulkanGpuCuller->Resize(m_FramesInFlight);
+    if(m_VulkanAsyncCompute)
+        m_VulkanAsyncCompute->SetFramesInFlight(m_FramesInFlight);
+
+    //swap chain image count and present mode (or offscreen image count) depend on the mode
+    cleanupSwapChain();
+
+    if(m_Headless) {
+        if(createVkOffscreenImages() != VK_SUCCESS)
+            throw std::runtime_error("Failed to create offscreen images!");
+    }
+    else if(createVkSwapChain() != VK_SUCCESS)
+        throw std::runtime_error("Failed to create swap chain!");
+    if(createVkSwapChainImageViews() != VK_SUCCESS)
+        throw std::runtime_error("Failed to create swap chain image views!");
+
+    delete m_RenderGraph;
+    buildRenderGraph();
+
+    if(createVkFrameBuffers() != VK_SUCCESS)
+        throw std::runtime_error("Failed to create framebuffers!");
+
+    if(ENABLE_VALIDATION_LAYERS)
+        std::cout << "Latency mode: " << m_FramesInFlight << " frames in flight, "
+                  << (m_Headless ? m_OffscreenImages.size() : m_SwapChainImages.size()) << " images" << std::endl;
+}
+
+void MyRenderer::RenderEngine::updateMeasuring() {
+    if(!m_FrameStatistics || m_MeasureFromFrame != UINT64_MAX || !m_AssetStreamer->IsIdle())
+        return;
+
+    //the next frame is the first one with every asset resident
+    m_MeasureFromFrame = m_VulkanProfiler->GetFrameNumber() + 1 + m_WarmupFrames;
 }
 
 void MyRenderer::RenderEngine::drawFrame() {
-    vkWaitForFences(m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
-    vkResetFences(m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrame]);
+    if(m_RequestedLatencyMode != m_LatencyMode)
+        applyLatencyMode();
+    collectCompiledPipelines();
+    applyReloadedPipelines();
+
+    m_VulkanProfiler->BeginFrame(m_CurrentFrame);
+    VulkanProfiler::CpuScope frameScope(m_VulkanProfiler, "drawFrame");
+
+    waitForFrameSlot();
+    collectCompletedFrames();
 
     uint32_t imageIndex = 0;
-    VkResult result = vkAcquireNextImageKHR(m_LogicalDevice,
-                                            m_SwapChainKHR,
-                                            UINT64_MAX,
-                                            m_ImageAvailableSemaphores[m_CurrentFrame],
-                                            VK_NULL_HANDLE, &imageIndex);
+    VkResult result;
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "AcquireNextImage");
+        result = vkAcquireNextImageKHR(m_LogicalDevice,
+                                       m_SwapChainKHR,
+                                       UINT64_MAX,
+                                       m_ImageAvailableSemaphores[m_CurrentFrame],
+                                       VK_NULL_HANDLE, &imageIndex);
+    }
 
     if(result == VK_ERROR_OUT_OF_DATE_KHR) {
         recreateSwapChain();
@@ -149,34 +521,24 @@ void MyRenderer::RenderEngine::drawFrame() {
     else if(result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
         throw std::runtime_error("Failed to acquire swap chain image!");
 
-    vkResetFences(m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrame]);
-
-    vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
+    //only once the frame is known to be submitted, a second BeginFrame() on the same slot would release other slots' data
+    updateFrameData();
 
-    recordCommandBuffer(m_CommandBuffers[m_CurrentFrame], imageIndex);
+    std::vector<VkSemaphore> waitSemaphores = {m_ImageAvailableSemaphores[m_CurrentFrame]};
+    std::vector<VkPipelineStageFlags> waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    flushUploads(waitSemaphores, waitStages);
+    submitAsyncCompute(waitSemaphores, waitStages);
 
-    VkSemaphore waitSemaphores[] = {m_ImageAvailableSemaphores[m_CurrentFrame]};
-    VkSemaphore signalSemaphores[] = {m_RenderFinishedSemaphores[m_CurrentFrame]};
-
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "RecordCommandBuffer");
+        vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &m_CommandBuffers[m_CurrentFrame];
-
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-
-    submitInfo.pWaitDstStageMask = waitStages;
-
-    if(vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, m_InFlightFences[m_CurrentFrame]) != VK_SUCCESS){
-        throw std::runtime_error("Failed to submit draw command buffer!");
+        recordCommandBuffer(m_CommandBuffers[m_CurrentFrame], imageIndex);
     }
 
+    VkSemaphore signalSemaphores[] = {m_RenderFinishedSemaphores[m_CurrentFrame]};
+    submitFrame(waitSemaphores, waitStages, signalSemaphores[0]);
+
     VkSwapchainKHR swapChains[] = {m_SwapChainKHR};
 
     VkPresentInfoKHR presentInfoKhr{};
@@ -188,7 +550,10 @@ void MyRenderer::RenderEngine::drawFrame() {
     presentInfoKhr.pImageIndices = &imageIndex;
     presentInfoKhr.pResults = nullptr;
 
-    result = vkQueuePresentKHR(m_PresentQueue, &presentInfoKhr);
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "QueuePresent");
+        result = vkQueuePresentKHR(m_PresentQueue, &presentInfoKhr);
+    }
 
     if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || m_FrameBufferResized){
         m_FrameBufferResized = false;
@@ -197,7 +562,121 @@ void MyRenderer::RenderEngine::drawFrame() {
     else if(result != VK_SUCCESS)
         throw std::runtime_error("Failed to present queue!");
 
-    m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
+}
+
+void MyRenderer::RenderEngine::drawHeadlessFrame() {
+    if(m_RequestedLatencyMode != m_LatencyMode)
+        applyLatencyMode();
+
+    m_VulkanProfiler->BeginFrame(m_CurrentFrame);
+    VulkanProfiler::CpuScope frameScope(m_VulkanProfiler, "drawHeadlessFrame");
+
+    waitForFrameSlot();
+    collectCompletedFrames();
+    updateFrameData();
+
+    std::vector<VkSemaphore> waitSemaphores;
+    std::vector<VkPipelineStageFlags> waitStages;
+    flushUploads(waitSemaphores, waitStages);
+    submitAsyncCompute(waitSemaphores, waitStages);
+
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "RecordCommandBuffer");
+        vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
+
+        //every frame in flight owns one offscreen image, so no acquire is needed
+        recordCommandBuffer(m_CommandBuffers[m_CurrentFrame], m_CurrentFrame);
+    }
+
+    submitFrame(waitSemaphores, waitStages, VK_NULL_HANDLE);
+
+    m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
+}
+
+void MyRenderer::RenderEngine::waitForFrameSlot() {
+    VulkanProfiler::CpuScope scope(m_VulkanProfiler, "WaitForFrame");
+
+    if(m_TimelineSync){
+        VkSemaphoreWaitInfo semaphoreWaitInfo{};
+        semaphoreWaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        semaphoreWaitInfo.semaphoreCount = 1;
+        semaphoreWaitInfo.pSemaphores = &m_FrameTimelineSemaphore;
+        semaphoreWaitInfo.pValues = &m_FrameSlotSubmissions[m_CurrentFrame];
+
+        vkWaitSemaphores(m_LogicalDevice, &semaphoreWaitInfo, UINT64_MAX);
+    }
+    else
+        vkWaitForFences(m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+}
+
+void MyRenderer::RenderEngine::submitFrame(const std::vector<VkSemaphore>& waitSemaphores,
+                                           const std::vector<VkPipelineStageFlags>& waitStages,
+                                           VkSemaphore signalSemaphore) {
+    uint64_t frameNumber = m_SubmittedFrameCount + 1;
+
+    //values of binary semaphores are ignored, but the arrays have to match the semaphore counts
+    std::vector<VkSemaphore> signalSemaphores;
+    std::vector<uint64_t> signalValues;
+    if(signalSemaphore != VK_NULL_HANDLE){
+        signalSemaphores.push_back(signalSemaphore);
+        signalValues.push_back(0);
+    }
+    //buffers this frame released to the async compute queue
+    VkSemaphore handoffSemaphore = m_VulkanAsyncCompute ? m_VulkanAsyncCompute->TakeSignalSemaphore() : VK_NULL_HANDLE;
+    if(handoffSemaphore != VK_NULL_HANDLE){
+        signalSemaphores.push_back(handoffSemaphore);
+        signalValues.push_back(0);
+    }
+    if(m_TimelineSync){
+        signalSemaphores.push_back(m_FrameTimelineSemaphore);
+        signalValues.push_back(frameNumber);
+    }
+    std::vector<uint64_t> waitValues(waitSemaphores.size(), 0);
+
+    VkTimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo{};
+    timelineSemaphoreSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineSemaphoreSubmitInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+    timelineSemaphoreSubmitInfo.pWaitSemaphoreValues = waitValues.data();
+    timelineSemaphoreSubmitInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+    timelineSemaphoreSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = m_TimelineSync ? &timelineSemaphoreSubmitInfo : nullptr;
+
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &m_CommandBuffers[m_CurrentFrame];
+
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStages.data();
+
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+    submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+    //fence is reset only right before the submit which signals it again, an early return can't leave it unsignaled
+    VkFence fence = VK_NULL_HANDLE;
+    if(!m_TimelineSync){
+        fence = m_InFlightFences[m_CurrentFrame];
+        vkResetFences(m_LogicalDevice, 1, &fence);
+    }
+
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "QueueSubmit");
+        if(vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, fence) != VK_SUCCESS){
+            throw std::runtime_error("Failed to submit draw command buffer!");
+        }
+    }
+    m_VulkanProfiler->MarkSubmit();
+    m_FrameSlotSubmissions[m_CurrentFrame] = ++m_SubmittedFrameCount;
+
+    if(m_SubmittedFrameCount == 1){
+        auto timeToFirstFrame = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime);
+        std::cout << "Time to first frame: " << timeToFirstFrame.count() << " ms, "
+                  << m_VulkanPipelineRegistry->GetReadyPipelineCount() << "/" << m_VulkanPipelineRegistry->GetPipelineCount()
+                  << " pipelines ready" << std::endl;
+    }
 }
 
 bool MyRenderer::RenderEngine::checkDeviceExtensionsSupport(VkPhysicalDevice physicalDevice) {
@@ -217,13 +696,34 @@ bool MyRenderer::RenderEngine::checkDeviceExtensionsSupport(VkPhysicalDevice phy
     return requiredExtensions.empty();
 }
 
+bool MyRenderer::RenderEngine::checkTimelineSemaphoreSupport(VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    if(physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2)
+        return false;
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{};
+    physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    physicalDeviceFeatures2.pNext = &vulkan12Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+
+    return vulkan12Features.timelineSemaphore == VK_TRUE;
+}
+
 std::vector<const char *> MyRenderer::RenderEngine::getRequiredExtensions() const {
+    std::vector<const char*> extensions;
+
     /*get extensions required by glfw*/
-    uint32_t glfwExtensionsCount = 0;
-    auto glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionsCount);
-    /*get extensions required by glfw*/
+    if(!m_Headless) {
+        uint32_t glfwExtensionsCount = 0;
+        auto glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionsCount);
 
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions+glfwExtensionsCount);
+        extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionsCount);
+    }
+    /*get extensions required by glfw*/
 
     if(ENABLE_VALIDATION_LAYERS)
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -277,18 +777,38 @@ int MyRenderer::RenderEngine::ratePhysicalDevice(const VkPhysicalDevice& physica
     if(!checkDeviceExtensionsSupport(physicalDevice))
         return 0;
 
-    SwapChainSupportDetails swapChainSupportDetails = querySwapChainSupportDetails(physicalDevice);
-    if(swapChainSupportDetails.presentModes.empty() || swapChainSupportDetails.surfaceFormats.empty())
+    if(!VulkanBindlessDescriptors::CheckSupport(physicalDevice))
         return 0;
 
+    if(!m_Headless) {
+        SwapChainSupportDetails swapChainSupportDetails = querySwapChainSupportDetails(physicalDevice);
+        if(swapChainSupportDetails.presentModes.empty() || swapChainSupportDetails.surfaceFormats.empty())
+            return 0;
+    }
+
     QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+    if(!indices.graphicsFamily.has_value())
+        return 0;
+
     score += indices.isComplete() * 100;
 
     return score;
 }
 
+std::optional<uint32_t> MyRenderer::RenderEngine::chooseAsyncComputeFamily(const QueueFamilyIndices& indices) {
+    if(indices.computeFamily.has_value())
+        return indices.computeFamily;
+
+    //a second queue of the graphics family still overlaps, just without a dedicated engine behind it
+    if(indices.graphicsFamily.has_value() && indices.graphicsQueueCount > 1)
+        return indices.graphicsFamily;
+
+    return std::nullopt;
+}
+
 MyRenderer::RenderEngine::QueueFamilyIndices MyRenderer::RenderEngine::findQueueFamilies(VkPhysicalDevice physicalDevice) {
     QueueFamilyIndices indices;
+    indices.presentRequired = !m_Headless;
 
     uint32_t queueFamiliesCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamiliesCount, nullptr);
@@ -298,17 +818,32 @@ MyRenderer::RenderEngine::QueueFamilyIndices MyRenderer::RenderEngine::findQueue
 
     int i = 0;
     for(const auto& queueFamilyProperties : queueFamiliesProperties){
-        if(queueFamilyProperties.queueFlags & VK_QUEUE_GRAPHICS_BIT){
+        if((queueFamilyProperties.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value()){
             indices.graphicsFamily = i;
+            indices.graphicsQueueCount = queueFamilyProperties.queueCount;
         }
 
-        VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, m_SurfaceKHR, &presentSupport);
+        //compute without graphics runs on its own hardware queue, next to the graphics work
+        if((queueFamilyProperties.queueFlags & VK_QUEUE_COMPUTE_BIT) &&
+           !(queueFamilyProperties.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.computeFamily.has_value()){
+            indices.computeFamily = i;
+        }
 
-        if(presentSupport)
-            indices.presentFamily = i;
+        //family with transfer but without graphics and compute is usually backed by a dedicated DMA engine
+        if((queueFamilyProperties.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+           !(queueFamilyProperties.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))){
+            indices.transferFamily = i;
+        }
 
-        if(indices.isComplete())
+        if(!m_Headless && !indices.presentFamily.has_value()) {
+            VkBool32 presentSupport = false;
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, m_SurfaceKHR, &presentSupport);
+
+            if(presentSupport)
+                indices.presentFamily = i;
+        }
+
+        if(indices.isComplete() && indices.transferFamily.has_value() && indices.computeFamily.has_value())
             break; //all queue families found
         i++;
     }
@@ -347,15 +882,57 @@ VkSurfaceFormatKHR MyRenderer::RenderEngine::chooseSwapChainSurfaceFormat(const
     return availableSurfaceFormats[0];
 }
 
-VkPresentModeKHR MyRenderer::RenderEngine::chooseSwapChainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes){
-    for(const auto& presentMode : availablePresentModes){
-        if(presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-            return presentMode;
+VkPresentModeKHR MyRenderer::RenderEngine::chooseSwapChainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) const {
+    for(const auto& preferredPresentMode : getLatencyPolicy(m_LatencyMode).presentModes){
+        if(std::find(availablePresentModes.begin(), availablePresentModes.end(), preferredPresentMode) != availablePresentModes.end())
+            return preferredPresentMode;
     }
 
+    //FIFO is the only mode every implementation has to support
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
+MyRenderer::RenderEngine::LatencyPolicy MyRenderer::RenderEngine::getLatencyPolicy(LatencyMode latencyMode) {
+    switch(latencyMode){
+        case LatencyMode::LowLatency:
+            //CPU never runs ahead of the GPU, FIFO_RELAXED tears instead of waiting a whole vblank on a late frame
+            return {1, 0, {VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR}};
+        case LatencyMode::MaxThroughput:
+            return {3, 2, {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR}};
+        case LatencyMode::Balanced:
+        default:
+            return {2, 1, {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR}};
+    }
+}
+
+VkSampleCountFlagBits MyRenderer::RenderEngine::chooseMsaaSampleCount() const {
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+
+    VkSampleCountFlags supportedSampleCounts = physicalDeviceProperties.limits.framebufferColorSampleCounts &
+                                               physicalDeviceProperties.limits.framebufferDepthSampleCounts;
+
+    for(VkSampleCountFlagBits sampleCount : {VK_SAMPLE_COUNT_64_BIT, VK_SAMPLE_COUNT_32_BIT, VK_SAMPLE_COUNT_16_BIT,
+                                             VK_SAMPLE_COUNT_8_BIT, VK_SAMPLE_COUNT_4_BIT, VK_SAMPLE_COUNT_2_BIT}){
+        if(sampleCount <= m_RequestedMsaaSamples && (supportedSampleCounts & sampleCount))
+            return sampleCount;
+    }
+
+    return VK_SAMPLE_COUNT_1_BIT;
+}
+
+VkFormat MyRenderer::RenderEngine::chooseDepthFormat() const {
+    for(VkFormat format : {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT}){
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, format, &formatProperties);
+
+        if(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+            return format;
+    }
+
+    throw std::runtime_error("Failed to find supported depth format!");
+}
+
 VkExtent2D MyRenderer::RenderEngine::chooseSwapChainExtent2D(const VkSurfaceCapabilitiesKHR& surfaceCapabilities){
     if(surfaceCapabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()){
         return surfaceCapabilities.currentExtent;
@@ -390,6 +967,217 @@ VkShaderModule MyRenderer::RenderEngine::createShaderModule(const std::vector<ch
     return shaderModule;
 }
 
+void MyRenderer::RenderEngine::onShadersReloaded(const std::vector<std::string>& shaderNames) {
+    std::vector<std::string> shaderPaths;
+    for(const auto& shaderName : shaderNames)
+        shaderPaths.push_back("shaders/" + shaderName + ".bin");
+
+    //only pipelines built from a changed shader are rebuilt, the others keep their pipeline
+    auto replacements = m_VulkanPipelineRegistry->CreateReplacements(shaderPaths);
+
+    std::lock_guard<std::mutex> lock(m_PendingPipelineMutex);
+    for(const auto& [handle, pipeline] : replacements){
+        auto pending = std::find_if(m_PendingPipelines.begin(), m_PendingPipelines.end(), [handle = handle](const auto& pendingPipeline){
+            return pendingPipeline.first == handle;
+        });
+
+        //never bound by a command buffer, can go right away
+        if(pending != m_PendingPipelines.end()){
+            vkDestroyPipeline(m_LogicalDevice, pending->second, nullptr);
+            pending->second = pipeline;
+        }
+        else
+            m_PendingPipelines.emplace_back(handle, pipeline);
+    }
+}
+
+void MyRenderer::RenderEngine::applyReloadedPipelines() {
+    std::lock_guard<std::mutex> lock(m_PendingPipelineMutex);
+    for(const auto& [handle, pipeline] : m_PendingPipelines){
+        VkPipeline oldPipeline = m_VulkanPipelineRegistry->Replace(handle, pipeline);
+        deferDestroy([this, oldPipeline](){
+            vkDestroyPipeline(m_LogicalDevice, oldPipeline, nullptr);
+        });
+    }
+
+    m_PendingPipelines.clear();
+}
+
+void MyRenderer::RenderEngine::collectCompiledPipelines() {
+    if(m_VulkanPipelineRegistry->CollectCompiled() == 0 || m_VulkanPipelineRegistry->IsCompiling())
+        return;
+
+    auto compileTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartTime);
+    std::cout << "Pipelines ready after " << compileTime.count() << " ms ("
+              << m_VulkanPipelineRegistry->GetReadyPipelineCount() << "/" << m_VulkanPipelineRegistry->GetPipelineCount() << ")" << std::endl;
+}
+
+void MyRenderer::RenderEngine::updateFrameData() {
+    VulkanProfiler::CpuScope scope(m_VulkanProfiler, "UpdateFrameData");
+
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+
+    FrameUniforms frameUniforms{};
+    frameUniforms.viewProjection = glm::mat4(1.0f);
+
+    //Gribb-Hartmann extraction from the rows of the matrix, clip space depth is 0..1
+    const glm::mat4& m = frameUniforms.viewProjection;
+    glm::vec4 rows[4];
+    for(int i = 0; i < 4; i++)
+        rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+    frameUniforms.frustumPlanes[0] = rows[3] + rows[0];
+    frameUniforms.frustumPlanes[1] = rows[3] - rows[0];
+    frameUniforms.frustumPlanes[2] = rows[3] + rows[1];
+    frameUniforms.frustumPlanes[3] = rows[3] - rows[1];
+    frameUniforms.frustumPlanes[4] = rows[2];
+    frameUniforms.frustumPlanes[5] = rows[3] - rows[2];
+    //unit normals, the culling shader compares distances against sphere radii
+    for(auto& plane : frameUniforms.frustumPlanes)
+        plane /= glm::length(glm::vec3(plane));
+    frameUniforms.time = glm::vec4(static_cast<float>(time), static_cast<float>(time - m_LastFrameTime), 0.0f, 0.0f);
+    m_LastFrameTime = time;
+
+    updateTextureResidency(frameUniforms.viewProjection);
+
+    //the previous use of this slot completed, its ring space can be written again
+    m_VulkanFrameData->BeginFrame(m_CurrentFrame);
+    m_FrameUniformOffset = m_VulkanFrameData->PushUniform(frameUniforms);
+    m_ObjectTransformOffset = m_VulkanFrameData->PushStorage(m_Objects.data(), m_Objects.size() * sizeof(ObjectData));
+
+    updateInstanceData();
+    buildDrawPackets(frameUniforms.viewProjection);
+}
+
+void MyRenderer::RenderEngine::updateTextureResidency(const glm::mat4& viewProjection) {
+    auto viewportSize = static_cast<float>(std::max(m_SwapChainExtent2D.width, m_SwapChainExtent2D.height));
+
+    for(const auto& drawCommand : m_DrawList){
+        if(drawCommand.textureId == VulkanBindlessDescriptors::INVALID_INDEX)
+            continue;
+
+        ObjectData& object = m_Objects[drawCommand.transformIndex];
+        glm::mat4 objectToClip = viewProjection * object.transform;
+        glm::vec4 center = objectToClip * glm::vec4(drawCommand.boundingSphere.x, drawCommand.boundingSphere.y, drawCommand.boundingSphere.z, 1.0f);
+        //the largest axis scale bounds the projected radius
+        float scale = std::max({glm::length(glm::vec3(objectToClip[0])), glm::length(glm::vec3(objectToClip[1])), glm::length(glm::vec3(objectToClip[2]))});
+        float radius = drawCommand.boundingSphere.w * scale;
+
+        //a camera inside the sphere gets the full resolution, otherwise one texel per covered pixel
+        uint32_t level = 0;
+        if(center.w > radius){
+            float pixels = std::max(radius / center.w * viewportSize, 1.0f);
+            VkExtent2D extent = m_VulkanTextureManager->GetExtent(drawCommand.textureId);
+            float texels = static_cast<float>(std::max(extent.width, extent.height));
+            level = static_cast<uint32_t>(std::max(std::floor(std::log2(texels / pixels)), 0.0f));
+        }
+        m_VulkanTextureManager->RequestLevel(drawCommand.textureId, std::min(level, m_VulkanTextureManager->GetLevelCount(drawCommand.textureId) - 1));
+
+        object.textureIndex = m_VulkanTextureManager->GetBindlessIndex(drawCommand.textureId);
+    }
+}
+
+void MyRenderer::RenderEngine::submitAsyncCompute(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages) {
+    if(!m_VulkanAsyncCompute)
+        return;
+
+    VulkanProfiler::CpuScope scope(m_VulkanProfiler, "SubmitAsyncCompute");
+
+    //the profiler's queries belong to the graphics family, culling is not timed on the GPU here
+    m_VulkanAsyncCompute->Submit(m_CurrentFrame, [this](VkCommandBuffer commandBuffer){
+        if(m_CullInstancesOnCompute)
+            m_VulkanGpuCuller->RecordCulling(commandBuffer, m_CurrentFrame, m_VulkanFrameData, m_FrameUniformOffset, m_ObjectTransformOffset);
+        else
+            m_VulkanGpuCuller->RecordSkip(commandBuffer, m_CurrentFrame);
+    }, m_VulkanGpuCuller->GetDrawTransfers(m_CurrentFrame), VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+
+    for(const auto& waitSemaphore : m_VulkanAsyncCompute->TakeWaitSemaphores()){
+        waitSemaphores.push_back(waitSemaphore.semaphore);
+        waitStages.push_back(waitSemaphore.stageMask);
+    }
+}
+
+void MyRenderer::RenderEngine::updateInstanceData() {
+    m_InstanceBatchBindings.clear();
+    if(m_InstanceBatches.empty())
+        return;
+
+    VulkanProfiler::CpuScope scope(m_VulkanProfiler, "UpdateInstanceData");
+
+    constexpr VkDeviceSize INSTANCE_ALIGNMENT = 16;
+    constexpr VkDeviceSize INSTANCE_SIZE = sizeof(glm::mat4) + sizeof(glm::vec4) + sizeof(uint32_t);
+
+    //every array may need alignment padding
+    VkDeviceSize frameSize = 0;
+    for(const auto* instanceBatch : m_InstanceBatches)
+        frameSize += instanceBatch->Size() * INSTANCE_SIZE + 3 * INSTANCE_ALIGNMENT;
+
+    if(frameSize > m_InstanceRingFrameSize){
+        //frames in flight still read from the old ring, it goes away once they completed
+        if(m_InstanceRing)
+            deferDestroy([instanceRing = m_InstanceRing](){ delete instanceRing; });
+
+        //one extra frame of space covers what is skipped when an allocation wraps around the end of the ring
+        m_InstanceRingFrameSize = std::max(frameSize, m_InstanceRingFrameSize * 2);
+        m_InstanceRing = new VulkanRingArena(m_VulkanMemoryAllocator, m_InstanceRingFrameSize * (m_FramesInFlight + 1),
+                                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_FramesInFlight);
+    }
+
+    m_InstanceRing->BeginFrame(m_CurrentFrame);
+
+    //each attribute array is already packed, one copy per array, ring memory is host coherent
+    auto pushArray = [this](const void* data, VkDeviceSize size){
+        VkDeviceSize offset = 0;
+        if(!m_InstanceRing->Allocate(size, INSTANCE_ALIGNMENT, offset))
+            throw std::runtime_error("Instance ring is full!");
+
+        std::memcpy(m_InstanceRing->GetMappedData(offset), data, static_cast<size_t>(size));
+        return offset;
+    };
+
+    for(const auto* instanceBatch : m_InstanceBatches){
+        uint32_t instanceCount = instanceBatch->Size();
+        if(instanceCount == 0)
+            continue;
+
+        InstanceBatchBinding binding{};
+        binding.mesh = instanceBatch->Mesh;
+        binding.instanceCount = instanceCount;
+        binding.buffer = m_InstanceRing->Buffer;
+        binding.transformOffset = pushArray(instanceBatch->Transforms.data(), instanceCount * sizeof(glm::mat4));
+        binding.colorOffset = pushArray(instanceBatch->Colors.data(), instanceCount * sizeof(glm::vec4));
+        binding.materialOffset = pushArray(instanceBatch->MaterialIndices.data(), instanceCount * sizeof(uint32_t));
+
+        m_InstanceBatchBindings.push_back(binding);
+    }
+}
+
+void MyRenderer::RenderEngine::flushUploads(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages) {
+    {
+        VulkanProfiler::CpuScope scope(m_VulkanProfiler, "StreamAssets");
+        //levels requested by updateFrameData() join the streaming queue first
+        m_VulkanTextureManager->Update();
+        m_AssetStreamer->Update(m_CurrentFrame);
+    }
+    //meshes completed above are drawn by this frame, its submit waits for their copies
+    if(m_VulkanGpuCuller)
+        m_VulkanGpuCuller->SetActiveInstanceCount(m_ReadyDrawCount);
+
+    AssetStreamer::Stats streamingStats = m_AssetStreamer->GetStats();
+    m_VulkanProfiler->SetCounter("Streaming load queue", streamingStats.loadQueueDepth);
+    m_VulkanProfiler->SetCounter("Streaming upload queue", streamingStats.uploadQueueDepth);
+    m_VulkanProfiler->SetCounter("Streaming bytes in flight", static_cast<double>(streamingStats.bytesInFlight));
+    m_VulkanProfiler->SetCounter("Streaming bytes uploaded", static_cast<double>(streamingStats.bytesUploadedLastFrame));
+    m_VulkanProfiler->SetCounter("Texture resident bytes", static_cast<double>(m_VulkanTextureManager->GetMemoryStats().residentBytes));
+
+    m_VulkanUploader->Flush();
+
+    for(const auto& waitSemaphore : m_VulkanUploader->TakeWaitSemaphores()){
+        waitSemaphores.push_back(waitSemaphore.semaphore);
+        waitStages.push_back(waitSemaphore.stageMask);
+    }
+}
+
 void MyRenderer::RenderEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex){
     VkCommandBufferBeginInfo commandBufferBeginInfo{};
     commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -397,20 +1185,180 @@ void MyRenderer::RenderEngine::recordCommandBuffer(VkCommandBuffer commandBuffer
     if(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS)
         throw std::runtime_error("Failed to begin command buffer recording!");
 
-    VkRenderPassBeginInfo renderPassBeginInfo{};
-    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassBeginInfo.renderPass = m_RenderPass;
-    renderPassBeginInfo.framebuffer = m_SwapChainFrameBuffers[imageIndex];
+    m_VulkanProfiler->BeginCommandBuffer(commandBuffer);
+
+    {
+        VulkanProfiler::GpuScope frameScope(m_VulkanProfiler, commandBuffer, "Frame");
 
-    renderPassBeginInfo.renderArea.offset = {0, 0};
-    renderPassBeginInfo.renderArea.extent = m_SwapChainExtent2D;
+        m_VulkanUploader->RecordAcquireBarriers(commandBuffer);
 
-    VkClearValue clearValue = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-    renderPassBeginInfo.clearValueCount = 1;
-    renderPassBeginInfo.pClearValues = &clearValue;
+        if(m_VulkanAsyncCompute){
+            m_VulkanAsyncCompute->RecordAcquireBarriers(commandBuffer);
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline);
+            //the instance upload is acquired above, this frame hands it on and the next frame culls on the compute queue
+            if(!m_CullInstancesOnCompute){
+                m_VulkanAsyncCompute->ReleaseToCompute(commandBuffer, {m_VulkanGpuCuller->GetInstanceTransfer()},
+                                                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+                m_CullInstancesOnCompute = true;
+            }
+        }
+
+        m_ImageIndex = imageIndex;
+        const std::vector<VkImage>& images = m_Headless ? m_OffscreenImages : m_SwapChainImages;
+        m_RenderGraph->SetImportedImage(m_BackBufferResource, images[imageIndex], m_SwapChainImageViews[imageIndex]);
+
+        m_RenderGraph->Execute(commandBuffer);
+    }
+
+    if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("Failed to record command buffer!");
+}
+
+void MyRenderer::RenderEngine::buildRenderGraph() {
+    m_RenderGraph = new RenderGraph();
+
+    RenderGraph::ImportDescription backBufferDescription{};
+    backBufferDescription.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    backBufferDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    //swap chain image is only available once the acquire semaphore, waited on at this stage, signalled
+    backBufferDescription.initialStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    //headless frames are left ready for readback instead of presentation
+    backBufferDescription.finalAccess = m_Headless ? RenderGraph::AccessType::TransferRead : RenderGraph::AccessType::Present;
+    m_BackBufferResource = m_RenderGraph->ImportImage("BackBuffer", backBufferDescription);
+
+    //only live inside the render pass: multisampled color is resolved into the back buffer, depth is discarded
+    RenderGraph::ImageDescription depthDescription{};
+    depthDescription.format = m_DepthFormat;
+    depthDescription.extent = m_SwapChainExtent2D;
+    depthDescription.samples = m_MsaaSamples;
+    //combined formats have to be transitioned and viewed with both aspects
+    depthDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if(m_DepthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || m_DepthFormat == VK_FORMAT_D24_UNORM_S8_UINT)
+        depthDescription.aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    m_DepthResource = m_RenderGraph->CreateImage("Depth", depthDescription);
+
+    if(m_MsaaSamples != VK_SAMPLE_COUNT_1_BIT){
+        RenderGraph::ImageDescription colorDescription{};
+        colorDescription.format = m_SwapChainImageFormat;
+        colorDescription.extent = m_SwapChainExtent2D;
+        colorDescription.samples = m_MsaaSamples;
+        colorDescription.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+        m_ColorResource = m_RenderGraph->CreateImage("MultisampledColor", colorDescription);
+    }
+
+    //culling only touches its own buffers, the graph does not track them, so the pass must never be culled
+    if(m_GpuCulling && !m_AsyncCompute){
+        static_cast<void>(m_RenderGraph->AddPass("CullPass", [this](VkCommandBuffer commandBuffer){
+            VulkanProfiler::GpuScope cullScope(m_VulkanProfiler, commandBuffer, "Culling");
+            m_VulkanGpuCuller->RecordCulling(commandBuffer, m_CurrentFrame, m_VulkanFrameData, m_FrameUniformOffset, m_ObjectTransformOffset);
+        }, true));
+    }
+
+    uint32_t mainPass = m_RenderGraph->AddPass("MainRenderPass", [this](VkCommandBuffer commandBuffer){
+        VkRenderPassBeginInfo renderPassBeginInfo{};
+        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.renderPass = m_RenderPass;
+        renderPassBeginInfo.framebuffer = m_SwapChainFrameBuffers[m_ImageIndex];
+
+        renderPassBeginInfo.renderArea.offset = {0, 0};
+        renderPassBeginInfo.renderArea.extent = m_SwapChainExtent2D;
+
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+        clearValues[1].depthStencil = {1.0f, 0};
+        renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        renderPassBeginInfo.pClearValues = clearValues.data();
+
+        VulkanProfiler::GpuScope renderPassScope(m_VulkanProfiler, commandBuffer, "MainRenderPass");
+
+        //draws are recorded into secondary buffers by worker threads, frame index selects their command pools
+        vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        m_VulkanCommandRecorder->Record(m_CurrentFrame, commandBuffer, m_RenderPass, 0, renderPassBeginInfo.framebuffer,
+                                        static_cast<uint32_t>(m_DrawPackets.size()),
+                                        [this](VkCommandBuffer secondaryCommandBuffer, uint32_t firstDraw, uint32_t drawCount){
+                                            recordDrawSlice(secondaryCommandBuffer, firstDraw, drawCount);
+                                        });
+
+        vkCmdEndRenderPass(commandBuffer);
+    });
+    //resolve writes the back buffer at the color attachment output stage, same as a plain color attachment
+    m_RenderGraph->Write(mainPass, m_BackBufferResource, RenderGraph::AccessType::ColorAttachmentWrite);
+    m_RenderGraph->Write(mainPass, m_DepthResource, RenderGraph::AccessType::DepthStencilAttachmentWrite);
+    if(m_MsaaSamples != VK_SAMPLE_COUNT_1_BIT)
+        m_RenderGraph->Write(mainPass, m_ColorResource, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    m_RenderGraph->Compile();
+    m_RenderGraph->Realize(m_VulkanMemoryAllocator);
+}
+
+uint32_t MyRenderer::RenderEngine::getSceneDrawCount() const {
+    //the whole culled draw list is a single indirect draw, nothing to split across workers
+    return m_GpuCulling ? 1 : m_ReadyDrawCount;
+}
+
+void MyRenderer::RenderEngine::recordDrawSlice(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t drawCount) const {
+    uint32_t sceneDrawCount = m_PacketSceneDrawCount;
+    BoundDrawState boundDrawState;
+
+    for(uint32_t i = firstDraw; i < firstDraw + drawCount; i++){
+        uint32_t drawIndex = m_DrawPackets[i].drawIndex;
+
+        //instance batches follow the scene draws, one instanced draw each
+        if(drawIndex >= sceneDrawCount){
+            if(!bindDrawState(commandBuffer, boundDrawState, m_InstancedPipeline))
+                continue;
+
+            const InstanceBatchBinding& binding = m_InstanceBatchBindings[drawIndex - sceneDrawCount];
+
+            //attributes come from the vertex bindings, nothing per draw
+            pushDrawConstants(commandBuffer, boundDrawState, {VulkanBindlessDescriptors::INVALID_INDEX, VulkanBindlessDescriptors::INVALID_INDEX, 0});
+
+            VkDeviceSize instanceOffsets[] = {binding.transformOffset, binding.colorOffset, binding.materialOffset};
+            if(binding.buffer != boundDrawState.instanceBuffer || !std::equal(std::begin(instanceOffsets), std::end(instanceOffsets), boundDrawState.instanceOffsets)){
+                VkBuffer instanceBuffers[] = {binding.buffer, binding.buffer, binding.buffer};
+                vkCmdBindVertexBuffers(commandBuffer, InstanceBatch::TRANSFORM_BINDING, 3, instanceBuffers, instanceOffsets);
+
+                boundDrawState.instanceBuffer = binding.buffer;
+                std::copy(std::begin(instanceOffsets), std::end(instanceOffsets), boundDrawState.instanceOffsets);
+            }
+
+            vkCmdDrawIndexed(commandBuffer, binding.mesh.indexCount, binding.instanceCount, binding.mesh.firstIndex, binding.mesh.vertexOffset, 0);
+            continue;
+        }
+
+        if(!bindDrawState(commandBuffer, boundDrawState, m_TrianglePipeline))
+            continue;
+
+        if(m_GpuCulling){
+            //transform index comes in through firstInstance
+            pushDrawConstants(commandBuffer, boundDrawState, {VulkanBindlessDescriptors::INVALID_INDEX, VulkanBindlessDescriptors::INVALID_INDEX, 0});
+            m_VulkanGpuCuller->RecordDraws(commandBuffer, m_CurrentFrame);
+            continue;
+        }
+
+        const DrawCommand& drawCommand = m_DrawList[drawIndex];
+        pushDrawConstants(commandBuffer, boundDrawState, {drawCommand.textureIndex, drawCommand.materialBufferIndex, drawCommand.transformIndex});
+        vkCmdDrawIndexed(commandBuffer, drawCommand.indexCount, 1, drawCommand.firstIndex, drawCommand.vertexOffset, 0);
+    }
+}
+
+bool MyRenderer::RenderEngine::bindDrawState(VkCommandBuffer commandBuffer, BoundDrawState& boundDrawState,
+                                             VulkanPipelineRegistry::PipelineHandle pipelineHandle) const {
+    //still compiling in the background, the frame goes out without these draws
+    VkPipeline pipeline = m_VulkanPipelineRegistry->GetPipeline(pipelineHandle);
+    if(pipeline == VK_NULL_HANDLE)
+        return false;
+
+    if(pipeline != boundDrawState.pipeline){
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        boundDrawState.pipeline = pipeline;
+    }
+
+    //secondary command buffers do not inherit any state, the rest is bound once per slice
+    if(boundDrawState.sharedStateBound)
+        return true;
+    boundDrawState.sharedStateBound = true;
 
     VkViewport viewport{};
     viewport.x = 0.0f;
@@ -426,12 +1374,113 @@ void MyRenderer::RenderEngine::recordCommandBuffer(VkCommandBuffer commandBuffer
     scissors.extent = m_SwapChainExtent2D;
     vkCmdSetScissor(commandBuffer, 0, 1, &scissors);
 
-    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    VkBuffer vertexBuffers[] = {m_VertexBuffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    m_VulkanBindlessDescriptors->Bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout);
+    m_VulkanFrameData->Bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 1, m_FrameUniformOffset, m_ObjectTransformOffset);
 
-    vkCmdEndRenderPass(commandBuffer);
+    return true;
+}
 
-    if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
-        throw std::runtime_error("Failed to record command buffer!");
+void MyRenderer::RenderEngine::pushDrawConstants(VkCommandBuffer commandBuffer, BoundDrawState& boundDrawState, const DrawPushConstants& pushConstants) const {
+    //sorted draws sharing a material and transform push the same values
+    const std::optional<DrawPushConstants>& pushed = boundDrawState.pushConstants;
+    if(pushed && pushed->textureIndex == pushConstants.textureIndex && pushed->materialBufferIndex == pushConstants.materialBufferIndex &&
+       pushed->transformIndex == pushConstants.transformIndex)
+        return;
+
+    vkCmdPushConstants(commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                       0, sizeof(DrawPushConstants), &pushConstants);
+    boundDrawState.pushConstants = pushConstants;
+}
+
+void MyRenderer::RenderEngine::buildDrawPackets(const glm::mat4& viewProjection) {
+    VulkanProfiler::CpuScope scope(m_VulkanProfiler, "SortDraws");
+
+    //meshes finishing streaming in flushUploads() are drawn from the next frame on
+    uint32_t sceneDrawCount = getSceneDrawCount();
+    m_PacketSceneDrawCount = sceneDrawCount;
+    m_DrawPackets.resize(sceneDrawCount + m_InstanceBatchBindings.size());
+
+    m_MaterialIds.clear();
+    m_MeshIds.clear();
+
+    if(m_GpuCulling){
+        //order of the culled draws is decided on the GPU
+        m_DrawPackets[0] = {DrawPacketSorter::MakeKey(OPAQUE_PASS, m_TrianglePipeline, 0, 0, 0.0f), 0};
+    }
+    else {
+        for(uint32_t i = 0; i < sceneDrawCount; i++){
+            const DrawCommand& drawCommand = m_DrawList[i];
+            const ObjectData& object = m_Objects[drawCommand.transformIndex];
+
+            //the texture the vertex shader picks, updateTextureResidency() already published streamed ones
+            uint32_t textureIndex = drawCommand.textureIndex != VulkanBindlessDescriptors::INVALID_INDEX ? drawCommand.textureIndex : object.textureIndex;
+            //dense ids in order of first use, the bindless indices themselves do not fit into the key
+            uint64_t materialKey = static_cast<uint64_t>(textureIndex) << 32 | drawCommand.materialBufferIndex;
+            uint32_t material = m_MaterialIds.emplace(materialKey, static_cast<uint32_t>(m_MaterialIds.size())).first->second;
+
+            //mesh ids only group draws, so meshes past the last id share it instead of wrapping onto the first ones
+            uint32_t mesh = m_MeshIds.emplace(drawCommand.meshId, std::min(static_cast<uint32_t>(m_MeshIds.size()), MAX_MESH_ID)).first->second;
+
+            //clip space w of the bounding sphere center is its view depth
+            glm::vec4 center = viewProjection * object.transform * glm::vec4(glm::vec3(drawCommand.boundingSphere), 1.0f);
+
+            m_DrawPackets[i] = {DrawPacketSorter::MakeKey(OPAQUE_PASS, m_TrianglePipeline, material, mesh, center.w), i};
+        }
+    }
+
+    //materials are per instance, batches only need to stay grouped by pipeline
+    for(uint32_t i = 0; i < m_InstanceBatchBindings.size(); i++){
+        uint32_t drawIndex = sceneDrawCount + i;
+        m_DrawPackets[drawIndex] = {DrawPacketSorter::MakeKey(OPAQUE_PASS, m_InstancedPipeline, 0, i, 0.0f), drawIndex};
+    }
+
+    m_DrawPacketSorter->Sort(m_DrawPackets);
+
+    //workers bind each change once per slice on top of these
+    uint32_t pipelineChanges = 0;
+    uint32_t materialChanges = 0;
+    for(size_t i = 1; i < m_DrawPackets.size(); i++){
+        uint64_t previousKey = m_DrawPackets[i - 1].sortKey;
+        uint64_t sortKey = m_DrawPackets[i].sortKey;
+        pipelineChanges += DrawPacketSorter::GetPipeline(previousKey) != DrawPacketSorter::GetPipeline(sortKey);
+        materialChanges += DrawPacketSorter::GetMaterial(previousKey) != DrawPacketSorter::GetMaterial(sortKey);
+    }
+    m_VulkanProfiler->SetCounter("Draw packets", static_cast<double>(m_DrawPackets.size()));
+    m_VulkanProfiler->SetCounter("Draw pipeline changes", pipelineChanges);
+    m_VulkanProfiler->SetCounter("Draw material changes", materialChanges);
+}
+
+std::vector<VulkanGpuCuller::Instance> MyRenderer::RenderEngine::buildCullInstances() const {
+    std::vector<VulkanGpuCuller::Instance> instances;
+    instances.reserve(m_DrawList.size());
+
+    for(const auto& drawCommand : m_DrawList){
+        instances.push_back({drawCommand.boundingSphere, drawCommand.indexCount, drawCommand.firstIndex,
+                             drawCommand.vertexOffset, drawCommand.transformIndex});
+    }
+
+    return instances;
+}
+
+glm::vec4 MyRenderer::RenderEngine::computeBoundingSphere(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    glm::vec3 minPosition(std::numeric_limits<float>::max());
+    glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
+    for(uint32_t index : indices){
+        glm::vec3 position(vertices[index].position, 0.0f);
+        minPosition = glm::min(minPosition, position);
+        maxPosition = glm::max(maxPosition, position);
+    }
+
+    glm::vec3 center = (minPosition + maxPosition) * 0.5f;
+    float radius = 0.0f;
+    for(uint32_t index : indices)
+        radius = std::max(radius, glm::length(glm::vec3(vertices[index].position, 0.0f) - center));
+
+    return glm::vec4(center, radius);
 }
 
 VkResult MyRenderer::RenderEngine::createVkSurfaceKHR() {
@@ -470,17 +1519,29 @@ VkResult MyRenderer::RenderEngine::createVkPhysicalDevice() {
 VkResult MyRenderer::RenderEngine::createVkLogicalDevice() {
     QueueFamilyIndices indices = findQueueFamilies(m_PhysicalDevice);
 
-    std::vector<VkDeviceQueueCreateInfo> logicalDeviceQueueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
-
-    float queuePriority = 1.0f;
+    //one priority per queue of the family, frame critical queues get full priority, background work yields to them
+    std::map<uint32_t, std::vector<float>> queuePriorities;
+    queuePriorities[indices.graphicsFamily.value()].push_back(1.0f);
+    if(indices.presentFamily.has_value() && indices.presentFamily != indices.graphicsFamily)
+        queuePriorities[indices.presentFamily.value()].push_back(1.0f);
+    if(indices.transferFamily.has_value())
+        queuePriorities[indices.transferFamily.value()].push_back(0.5f);
+
+    //culling gates the frame's draws, so async compute sits just below the graphics queue
+    uint32_t computeQueueIndex = 0;
+    if(m_AsyncCompute){
+        std::vector<float>& computePriorities = queuePriorities[chooseAsyncComputeFamily(indices).value()];
+        computeQueueIndex = static_cast<uint32_t>(computePriorities.size());
+        computePriorities.push_back(0.75f);
+    }
 
-    for(auto queueFamily : uniqueQueueFamilies) {
+    std::vector<VkDeviceQueueCreateInfo> logicalDeviceQueueCreateInfos;
+    for(const auto& [queueFamily, priorities] : queuePriorities) {
         VkDeviceQueueCreateInfo logicalDeviceQueueCreateInfo{};
         logicalDeviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         logicalDeviceQueueCreateInfo.queueFamilyIndex = queueFamily;
-        logicalDeviceQueueCreateInfo.queueCount = 1;
-        logicalDeviceQueueCreateInfo.pQueuePriorities = &queuePriority;
+        logicalDeviceQueueCreateInfo.queueCount = static_cast<uint32_t>(priorities.size());
+        logicalDeviceQueueCreateInfo.pQueuePriorities = priorities.data();
 
         logicalDeviceQueueCreateInfos.push_back(logicalDeviceQueueCreateInfo);
     }
@@ -496,6 +1557,15 @@ VkResult MyRenderer::RenderEngine::createVkLogicalDevice() {
 
     logicalDeviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
 
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.timelineSemaphore = m_TimelineSync ? VK_TRUE : VK_FALSE;
+    VulkanBindlessDescriptors::EnableFeatures(vulkan12Features);
+    VulkanTextureManager::EnableFeatures(m_PhysicalDevice, physicalDeviceFeatures);
+    if(m_GpuCulling)
+        VulkanGpuCuller::EnableFeatures(physicalDeviceFeatures, vulkan12Features);
+    logicalDeviceCreateInfo.pNext = &vulkan12Features;
+
     logicalDeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
     logicalDeviceCreateInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
 
@@ -509,7 +1579,14 @@ VkResult MyRenderer::RenderEngine::createVkLogicalDevice() {
     VkResult result = vkCreateDevice(m_PhysicalDevice, &logicalDeviceCreateInfo, nullptr, &m_LogicalDevice);
     if(result == VK_SUCCESS) {
         vkGetDeviceQueue(m_LogicalDevice, indices.graphicsFamily.value(), 0, &m_GraphicsQueue);
-        vkGetDeviceQueue(m_LogicalDevice, indices.presentFamily.value(), 0, &m_PresentQueue);
+        if(indices.presentFamily.has_value())
+            vkGetDeviceQueue(m_LogicalDevice, indices.presentFamily.value(), 0, &m_PresentQueue);
+
+        //without a dedicated transfer family uploads go through the graphics queue
+        vkGetDeviceQueue(m_LogicalDevice, indices.transferFamily.value_or(indices.graphicsFamily.value()), 0, &m_TransferQueue);
+
+        if(m_AsyncCompute)
+            vkGetDeviceQueue(m_LogicalDevice, chooseAsyncComputeFamily(indices).value(), computeQueueIndex, &m_ComputeQueue);
     }
 
     return result;
@@ -522,9 +1599,10 @@ VkResult MyRenderer::RenderEngine::createVkSwapChain(){
     VkPresentModeKHR presentModeKhr = chooseSwapChainPresentMode(swapChainSupportDetails.presentModes);
     VkExtent2D extent2D = chooseSwapChainExtent2D(swapChainSupportDetails.surfaceCapabilities);
 
-    uint32_t imageCount = swapChainSupportDetails.surfaceCapabilities.minImageCount + 1;
+    uint32_t imageCount = swapChainSupportDetails.surfaceCapabilities.minImageCount + getLatencyPolicy(m_LatencyMode).extraSwapChainImages;
 
-    if(imageCount > swapChainSupportDetails.surfaceCapabilities.maxImageCount){
+    //maxImageCount of 0 means there is no limit
+    if(swapChainSupportDetails.surfaceCapabilities.maxImageCount > 0 && imageCount > swapChainSupportDetails.surfaceCapabilities.maxImageCount){
         imageCount  = swapChainSupportDetails.surfaceCapabilities.maxImageCount;
     }
 
@@ -557,7 +1635,8 @@ VkResult MyRenderer::RenderEngine::createVkSwapChain(){
     swapChainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     swapChainCreateInfo.clipped = VK_TRUE;
 
-    swapChainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
+    //retired swap chain (if any) is kept alive by recreateSwapChain() until its frames completed
+    swapChainCreateInfo.oldSwapchain = m_SwapChainKHR;
 
     VkResult result = vkCreateSwapchainKHR(m_LogicalDevice, &swapChainCreateInfo, nullptr, &m_SwapChainKHR);
     if(result == VK_SUCCESS){
@@ -571,13 +1650,43 @@ VkResult MyRenderer::RenderEngine::createVkSwapChain(){
     return result;
 }
 
+VkResult MyRenderer::RenderEngine::createVkOffscreenImages() {
+    //R8G8B8A8_UNORM is a mandatory color attachment format, so it also works on software ICDs like lavapipe
+    m_SwapChainImageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    m_SwapChainExtent2D = {m_Width, m_Height};
+
+    m_OffscreenImages.resize(m_FramesInFlight);
+    m_OffscreenImageAllocations.resize(m_FramesInFlight);
+
+    for(size_t i = 0; i < m_OffscreenImages.size(); i++){
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format = m_SwapChainImageFormat;
+        imageCreateInfo.extent = {m_SwapChainExtent2D.width, m_SwapChainExtent2D.height, 1};
+        imageCreateInfo.mipLevels = 1;
+        imageCreateInfo.arrayLayers = 1;
+        imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        m_VulkanMemoryAllocator->CreateImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                             m_OffscreenImages[i], m_OffscreenImageAllocations[i]);
+    }
+
+    return VK_SUCCESS;
+}
+
 VkResult MyRenderer::RenderEngine::createVkSwapChainImageViews() {
-    m_SwapChainImageViews.resize(m_SwapChainImages.size());
+    const std::vector<VkImage>& images = m_Headless ? m_OffscreenImages : m_SwapChainImages;
+    m_SwapChainImageViews.resize(images.size());
 
     for(size_t i = 0; i < m_SwapChainImageViews.size(); i++){
         VkImageViewCreateInfo imageViewCreateInfo{};
         imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        imageViewCreateInfo.image = m_SwapChainImages[i];
+        imageViewCreateInfo.image = images[i];
 
         imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
         imageViewCreateInfo.format = m_SwapChainImageFormat;
@@ -601,177 +1710,151 @@ VkResult MyRenderer::RenderEngine::createVkSwapChainImageViews() {
 }
 
 VkResult MyRenderer::RenderEngine::createRenderPass() {
+    bool multisampled = m_MsaaSamples != VK_SAMPLE_COUNT_1_BIT;
+
+    //attachment 0 - color (multisampled or the back buffer), 1 - depth, 2 - back buffer as resolve target with MSAA
+    std::vector<VkAttachmentDescription> attachmentDescriptions;
+
     VkAttachmentDescription colorAttachmentDescription{};
     colorAttachmentDescription.format = m_SwapChainImageFormat;
-    colorAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachmentDescription.samples = m_MsaaSamples;
 
     colorAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    //multisampled color is resolved at the end of the subpass and never written to memory
+    colorAttachmentDescription.storeOp = multisampled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    //layout transitions and the dependency on the acquire are recorded by the render graph around the pass
+    colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    attachmentDescriptions.push_back(colorAttachmentDescription);
+
+    VkAttachmentDescription depthAttachmentDescription{};
+    depthAttachmentDescription.format = m_DepthFormat;
+    depthAttachmentDescription.samples = m_MsaaSamples;
+    depthAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    attachmentDescriptions.push_back(depthAttachmentDescription);
+
+    if(multisampled){
+        VkAttachmentDescription resolveAttachmentDescription{};
+        resolveAttachmentDescription.format = m_SwapChainImageFormat;
+        resolveAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+        resolveAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        resolveAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        resolveAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        resolveAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        resolveAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        resolveAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachmentDescriptions.push_back(resolveAttachmentDescription);
+    }
 
     VkAttachmentReference colorAttachmentReference{};
     colorAttachmentReference.attachment = 0;
     colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+    VkAttachmentReference depthAttachmentReference{};
+    depthAttachmentReference.attachment = 1;
+    depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference resolveAttachmentReference{};
+    resolveAttachmentReference.attachment = 2;
+    resolveAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
     VkSubpassDescription subpassDescription{};
     subpassDescription.colorAttachmentCount = 1;
     subpassDescription.pColorAttachments = &colorAttachmentReference;
-
-    VkSubpassDependency subpassDependency{};
-    subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    subpassDependency.dstSubpass = 0;
-
-    subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    subpassDependency.srcAccessMask = 0;
-
-    subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    subpassDescription.pDepthStencilAttachment = &depthAttachmentReference;
+    subpassDescription.pResolveAttachments = multisampled ? &resolveAttachmentReference : nullptr;
 
     VkRenderPassCreateInfo renderPassCreateInfo{};
     renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassCreateInfo.attachmentCount = 1;
-    renderPassCreateInfo.pAttachments = &colorAttachmentDescription;
+    renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(attachmentDescriptions.size());
+    renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
     renderPassCreateInfo.subpassCount = 1;
     renderPassCreateInfo.pSubpasses = &subpassDescription;
-    renderPassCreateInfo.dependencyCount = 1;
-    renderPassCreateInfo.pDependencies = &subpassDependency;
+    renderPassCreateInfo.dependencyCount = 0;
+    renderPassCreateInfo.pDependencies = nullptr;
 
     return vkCreateRenderPass(m_LogicalDevice, &renderPassCreateInfo, nullptr, &m_RenderPass);
 }
 
 VkResult MyRenderer::RenderEngine::createVkGraphicsPipeline() {
-    auto vertexShaderCode = readFile("shaders/triangle.vert.bin");
-    auto fragmentShaderCode = readFile("shaders/triangle.frag.bin");
-
-    VkShaderModule vertexShaderModule = createShaderModule(vertexShaderCode);
-    VkShaderModule fragmentShaderModule = createShaderModule(fragmentShaderCode);
-
-    VkPipelineShaderStageCreateInfo vertexShaderStageCreateInfo{};
-    vertexShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertexShaderStageCreateInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-
-    vertexShaderStageCreateInfo.module = vertexShaderModule;
-    vertexShaderStageCreateInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragmentShaderStageCreateInfo{};
-    fragmentShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragmentShaderStageCreateInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    fragmentShaderStageCreateInfo.module = fragmentShaderModule;
-    fragmentShaderStageCreateInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStageCreateInfos[] = {vertexShaderStageCreateInfo, fragmentShaderStageCreateInfo};
-
-    VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
-    vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputStateCreateInfo.vertexAttributeDescriptionCount = 0;
-    vertexInputStateCreateInfo.pVertexAttributeDescriptions = nullptr;
-    vertexInputStateCreateInfo.vertexBindingDescriptionCount = 0;
-    vertexInputStateCreateInfo.pVertexBindingDescriptions = nullptr;
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo{};
-    inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssemblyStateCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
-
-    VkPipelineViewportStateCreateInfo viewportStateCreateInfo{};
-    viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportStateCreateInfo.scissorCount = 1;
-    viewportStateCreateInfo.viewportCount = 1;
-
-    std::vector<VkDynamicState> dynamicStates = {
-            VK_DYNAMIC_STATE_VIEWPORT,
-            VK_DYNAMIC_STATE_SCISSOR
-    };
-    VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo{};
-    dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
-
-    VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo{};
-    rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizationStateCreateInfo.depthClampEnable = VK_FALSE;
-    rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
-    rasterizationStateCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizationStateCreateInfo.lineWidth = 1.0f;
-    rasterizationStateCreateInfo.depthBiasEnable = VK_FALSE;
-    rasterizationStateCreateInfo.depthBiasConstantFactor = 0.0f;
-    rasterizationStateCreateInfo.depthBiasClamp = 0.0f;
-    rasterizationStateCreateInfo.depthBiasSlopeFactor = 0.0f;
-
-    VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo{};
-    multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
-    multisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-    multisampleStateCreateInfo.minSampleShading = 1.0f;
-    multisampleStateCreateInfo.pSampleMask = nullptr;
-    multisampleStateCreateInfo.alphaToCoverageEnable = VK_FALSE;
-    multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
-
-    VkPipelineColorBlendAttachmentState colorBlendAttachmentState{};
-    colorBlendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachmentState.blendEnable = VK_FALSE;
-
-    /*colorBlendAttachment.blendEnable = VK_TRUE;
-    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;*/
-
-    VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo{};
-    colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
-    colorBlendStateCreateInfo.attachmentCount = 1;
-    colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
+    //every pipeline shares the bindless set, draws only push their indices
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(DrawPushConstants);
 
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
     pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    //set 0 - bindless resources, set 1 - per-frame data
+    std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts = {m_VulkanBindlessDescriptors->DescriptorSetLayout, m_VulkanFrameData->DescriptorSetLayout};
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+    if(vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create pipeline layout!");
+
+    auto attributeDescriptions = Vertex::getAttributeDescriptions();
+
+    PipelineDescription pipelineDescription{};
+    pipelineDescription.vertexShader = "shaders/triangle.vert.bin";
+    pipelineDescription.fragmentShader = "shaders/triangle.frag.bin";
+    pipelineDescription.vertexBindings = {Vertex::getBindingDescription()};
+    pipelineDescription.vertexAttributes = {attributeDescriptions.begin(), attributeDescriptions.end()};
+    pipelineDescription.samples = m_MsaaSamples;
+    pipelineDescription.depthCompareOp = VK_COMPARE_OP_LESS;
+    pipelineDescription.renderPass = m_RenderPass;
+    pipelineDescription.layout = m_PipelineLayout;
+
+    m_TrianglePipeline = m_VulkanPipelineRegistry->Request(pipelineDescription);
+
+    //same mesh vertex input plus the per-instance bindings of InstanceBatch
+    auto instanceBindingDescriptions = InstanceBatch::getBindingDescriptions();
+    auto instanceAttributeDescriptions = InstanceBatch::getAttributeDescriptions();
+    pipelineDescription.vertexShader = "shaders/instanced.vert.bin";
+    pipelineDescription.fragmentShader = "shaders/instanced.frag.bin";
+    pipelineDescription.vertexBindings.insert(pipelineDescription.vertexBindings.end(),
+                                              instanceBindingDescriptions.begin(), instanceBindingDescriptions.end());
+    pipelineDescription.vertexAttributes.insert(pipelineDescription.vertexAttributes.end(),
+                                                instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
+
+    m_InstancedPipeline = m_VulkanPipelineRegistry->Request(pipelineDescription);
+
+    //every pipeline requested so far compiles on the workers while the rest of the startup continues,
+    //frames are rendered with whatever is ready
+    m_VulkanPipelineRegistry->CompileAsync(m_PipelineCompilePool);
+
+    //headless output is compared between runs, it has to contain every draw
+    if(m_Headless)
+        m_VulkanPipelineRegistry->WaitIdle();
 
-   if(vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS)
-       throw std::runtime_error("Failed to create pipeline layout!");
-
-    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
-    graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-
-    graphicsPipelineCreateInfo.stageCount = 2;
-    graphicsPipelineCreateInfo.pStages = shaderStageCreateInfos;
-
-    graphicsPipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
-    graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
-    graphicsPipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
-    graphicsPipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
-    graphicsPipelineCreateInfo.pMultisampleState = &multisampleStateCreateInfo;
-    graphicsPipelineCreateInfo.pDepthStencilState = nullptr;
-    graphicsPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
-    graphicsPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
-
-    graphicsPipelineCreateInfo.layout = m_PipelineLayout;
-
-    graphicsPipelineCreateInfo.renderPass = m_RenderPass;
-    graphicsPipelineCreateInfo.subpass = 0;
-
-    VkResult result = vkCreateGraphicsPipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &graphicsPipelineCreateInfo, nullptr, &m_GraphicsPipeline);
-
-    vkDestroyShaderModule(m_LogicalDevice, vertexShaderModule, nullptr);
-    vkDestroyShaderModule(m_LogicalDevice, fragmentShaderModule, nullptr);
-
-    return result;
+    return VK_SUCCESS;
 }
 
 VkResult MyRenderer::RenderEngine::createVkFrameBuffers(){
     m_SwapChainFrameBuffers.resize(m_SwapChainImageViews.size());
 
     for(size_t i = 0; i < m_SwapChainFrameBuffers.size(); i++){
-        VkImageView attachments[] = { m_SwapChainImageViews[i]};
+        //transient attachments are shared by every framebuffer, same order as in createRenderPass()
+        std::vector<VkImageView> attachments;
+        if(m_MsaaSamples != VK_SAMPLE_COUNT_1_BIT)
+            attachments = {m_RenderGraph->GetImageView(m_ColorResource), m_RenderGraph->GetImageView(m_DepthResource), m_SwapChainImageViews[i]};
+        else
+            attachments = {m_SwapChainImageViews[i], m_RenderGraph->GetImageView(m_DepthResource)};
 
         VkFramebufferCreateInfo framebufferCreateInfo{};
         framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebufferCreateInfo.renderPass = m_RenderPass;
-        framebufferCreateInfo.attachmentCount = 1;
-        framebufferCreateInfo.pAttachments = attachments;
+        framebufferCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        framebufferCreateInfo.pAttachments = attachments.data();
         framebufferCreateInfo.width = m_SwapChainExtent2D.width;
         framebufferCreateInfo.height = m_SwapChainExtent2D.height;
         framebufferCreateInfo.layers = 1;
@@ -794,8 +1877,83 @@ VkResult MyRenderer::RenderEngine::createVkCommandPool() {
     return vkCreateCommandPool(m_LogicalDevice, &commandPoolCreateInfo, nullptr, &m_CommandPool);
 }
 
+VkResult MyRenderer::RenderEngine::createVkVertexBuffer(const MeshFile& sceneFile) {
+    VkDeviceSize triangleSize = sizeof(m_Vertices[0]) * m_Vertices.size();
+    VkDeviceSize sceneSize = sceneFile.GetMeshCount() > 0 ? sceneFile.GetVertexBlobSize() : 0;
+    VkDeviceSize bufferSize = triangleSize + sceneSize;
+
+    m_VulkanMemoryAllocator->CreateBuffer(bufferSize,
+                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                          m_VertexBuffer, m_VertexBufferAllocation);
+
+    m_VulkanUploader->UploadBuffer(m_VertexBuffer, 0, m_Vertices.data(), triangleSize,
+                                   VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+    return VK_SUCCESS;
+}
+
+VkResult MyRenderer::RenderEngine::createVkIndexBuffer(const MeshFile& sceneFile) {
+    VkDeviceSize triangleSize = sizeof(m_Indices[0]) * m_Indices.size();
+    VkDeviceSize sceneSize = sceneFile.GetMeshCount() > 0 ? sceneFile.GetIndexBlobSize() : 0;
+    VkDeviceSize bufferSize = triangleSize + sceneSize;
+
+    m_VulkanMemoryAllocator->CreateBuffer(bufferSize,
+                                          VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                          m_IndexBuffer, m_IndexBufferAllocation);
+
+    m_VulkanUploader->UploadBuffer(m_IndexBuffer, 0, m_Indices.data(), triangleSize,
+                                   VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+    return VK_SUCCESS;
+}
+
+void MyRenderer::RenderEngine::streamSceneFile(const std::shared_ptr<MeshFile>& sceneFile) {
+    VkDeviceSize vertexBase = sizeof(m_Vertices[0]) * m_Vertices.size();
+    VkDeviceSize indexBase = sizeof(m_Indices[0]) * m_Indices.size();
+
+    //scene meshes follow the triangle in both buffers, their ranges translate directly into draw offsets
+    for(uint32_t i = 0; i < sceneFile->GetMeshCount(); i++){
+        const MeshFileEntry& mesh = sceneFile->GetMesh(i);
+
+        DrawCommand drawCommand{mesh.indexCount, static_cast<uint32_t>(m_Indices.size()) + mesh.firstIndex,
+                                static_cast<int32_t>(m_Vertices.size() + mesh.firstVertex)};
+        drawCommand.boundingSphere = glm::vec4(mesh.boundingSphere[0], mesh.boundingSphere[1], mesh.boundingSphere[2], mesh.boundingSphere[3]);
+        //the triangle is mesh 0
+        drawCommand.meshId = i + 1;
+        m_DrawList.push_back(drawCommand);
+
+        //ranges point into the mapping, the I/O thread takes the page faults and the file stays mapped until staged
+        AssetStreamer::Request vertexRequest;
+        vertexRequest.load = [sceneFile, i](){
+            AssetStreamer::AssetData assetData{sceneFile->GetVertices(i), sceneFile->GetMesh(i).vertexCount * sizeof(Vertex), sceneFile};
+            AssetStreamer::Prefault(assetData.data, assetData.size);
+            return assetData;
+        };
+        vertexRequest.dstBuffer = m_VertexBuffer;
+        vertexRequest.dstOffset = vertexBase + static_cast<VkDeviceSize>(mesh.firstVertex) * sizeof(Vertex);
+        vertexRequest.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        m_AssetStreamer->Submit(std::move(vertexRequest));
+
+        //requests complete in order, the index range finishing means the whole mesh is resident
+        AssetStreamer::Request indexRequest;
+        indexRequest.load = [sceneFile, i](){
+            AssetStreamer::AssetData assetData{sceneFile->GetIndices(i), sceneFile->GetMesh(i).indexCount * sizeof(uint32_t), sceneFile};
+            AssetStreamer::Prefault(assetData.data, assetData.size);
+            return assetData;
+        };
+        indexRequest.dstBuffer = m_IndexBuffer;
+        indexRequest.dstOffset = indexBase + static_cast<VkDeviceSize>(mesh.firstIndex) * sizeof(uint32_t);
+        indexRequest.dstAccessMask = VK_ACCESS_INDEX_READ_BIT;
+        uint32_t drawIndex = static_cast<uint32_t>(m_DrawList.size() - 1);
+        indexRequest.onReady = [this, drawIndex](){ m_ReadyDrawCount = drawIndex + 1; };
+        m_AssetStreamer->Submit(std::move(indexRequest));
+    }
+}
+
 VkResult MyRenderer::RenderEngine::createVkCommandBuffers(){
-    m_CommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    m_CommandBuffers.resize(m_FramesInFlight);
 
     VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
     commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -807,28 +1965,64 @@ VkResult MyRenderer::RenderEngine::createVkCommandBuffers(){
 }
 
 VkResult MyRenderer::RenderEngine::createVkSynchronizationObjects() {
-    m_ImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    m_RenderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    m_InFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+    m_FrameSlotSubmissions.assign(m_FramesInFlight, m_SubmittedFrameCount);
+    m_ImageAvailableSemaphores.resize(m_FramesInFlight);
+    m_RenderFinishedSemaphores.resize(m_FramesInFlight);
 
     VkSemaphoreCreateInfo semaphoreCreateInfo{};
     semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    VkFenceCreateInfo fenceCreateInfo{};
-    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-    for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++){
+    for(size_t i = 0; i < m_FramesInFlight; i++){
         if(vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &m_ImageAvailableSemaphores[i]) != VK_SUCCESS)
             return VK_ERROR_INITIALIZATION_FAILED;
         if(vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &m_RenderFinishedSemaphores[i]) != VK_SUCCESS)
             return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    //swap chain acquire and present only take binary semaphores, so those stay per frame in both modes
+    if(m_TimelineSync){
+        VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo{};
+        semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        semaphoreTypeCreateInfo.initialValue = m_SubmittedFrameCount;
+
+        VkSemaphoreCreateInfo timelineSemaphoreCreateInfo{};
+        timelineSemaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        timelineSemaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+
+        return vkCreateSemaphore(m_LogicalDevice, &timelineSemaphoreCreateInfo, nullptr, &m_FrameTimelineSemaphore);
+    }
+
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    m_InFlightFences.resize(m_FramesInFlight);
+    for(size_t i = 0; i < m_FramesInFlight; i++){
         if(vkCreateFence(m_LogicalDevice, &fenceCreateInfo, nullptr, &m_InFlightFences[i]) != VK_SUCCESS)
             return VK_ERROR_INITIALIZATION_FAILED;
     }
     return VK_SUCCESS;
 }
 
+void MyRenderer::RenderEngine::destroyVkSynchronizationObjects() {
+    for(size_t i = 0; i < m_ImageAvailableSemaphores.size(); i++){
+        vkDestroySemaphore(m_LogicalDevice, m_ImageAvailableSemaphores[i], nullptr);
+        vkDestroySemaphore(m_LogicalDevice, m_RenderFinishedSemaphores[i], nullptr);
+    }
+    for(auto& fence : m_InFlightFences)
+        vkDestroyFence(m_LogicalDevice, fence, nullptr);
+
+    if(m_FrameTimelineSemaphore != VK_NULL_HANDLE){
+        vkDestroySemaphore(m_LogicalDevice, m_FrameTimelineSemaphore, nullptr);
+        m_FrameTimelineSemaphore = VK_NULL_HANDLE;
+    }
+
+    m_ImageAvailableSemaphores.clear();
+    m_RenderFinishedSemaphores.clear();
+    m_InFlightFences.clear();
+}
+
 VkBool32 MyRenderer::RenderEngine::debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
                                                  VkDebugUtilsMessageTypeFlagsEXT messageType,
                                                  const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
@@ -844,4 +2038,18 @@ void MyRenderer::RenderEngine::framebufferResizeCallback(GLFWwindow *window, int
     app->m_FrameBufferResized = true;
 }
 
+void MyRenderer::RenderEngine::keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    auto app = reinterpret_cast<RenderEngine*>(glfwGetWindowUserPointer(window));
+    if(action != GLFW_PRESS)
+        return;
+
+    //F1 - F3 switch latency mode at runtime
+    if(key == GLFW_KEY_F1)
+        app->SetLatencyMode(LatencyMode::LowLatency);
+    else if(key == GLFW_KEY_F2)
+        app->SetLatencyMode(LatencyMode::Balanced);
+    else if(key == GLFW_KEY_F3)
+        app->SetLatencyMode(LatencyMode::MaxThroughput);
+}
+
 
@@ -0,0 +1,548 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+RenderGraph::~RenderGraph() {
+    destroyImages();
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateImage(const std::string& name, const ImageDescription& imageDescription) {
+    Resource resource{};
+    resource.name = name;
+    resource.imported = false;
+    resource.description = imageDescription;
+
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportImage(const std::string& name, const ImportDescription& importDescription) {
+    Resource resource{};
+    resource.name = name;
+    resource.imported = true;
+    resource.importDescription = importDescription;
+
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void RenderGraph::SetImportedImage(ResourceHandle resource, VkImage image, VkImageView imageView) {
+    if(!m_Resources.at(resource).imported)
+        throw std::runtime_error("RenderGraph::SetImportedImage() -> " + m_Resources[resource].name + " is not an imported image!");
+
+    m_Resources[resource].image = image;
+    m_Resources[resource].imageView = imageView;
+}
+
+uint32_t RenderGraph::AddPass(const std::string& name, ExecuteFunction execute, bool hasSideEffects) {
+    Pass pass{};
+    pass.name = name;
+    pass.execute = std::move(execute);
+    pass.hasSideEffects = hasSideEffects;
+
+    m_Passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(m_Passes.size() - 1);
+}
+
+void RenderGraph::Read(uint32_t pass, ResourceHandle resource, AccessType accessType) {
+    addAccess(pass, resource, accessType, false);
+}
+
+void RenderGraph::Write(uint32_t pass, ResourceHandle resource, AccessType accessType) {
+    addAccess(pass, resource, accessType, true);
+}
+
+void RenderGraph::addAccess(uint32_t pass, ResourceHandle resource, AccessType accessType, bool write) {
+    if(pass >= m_Passes.size() || resource >= m_Resources.size())
+        throw std::runtime_error("RenderGraph::addAccess() -> Invalid pass or resource handle!");
+
+    AccessInfo accessInfo = getAccessInfo(accessType);
+    m_Resources[resource].usage |= accessInfo.usage;
+
+    //read and write of the same image in one pass (attachment load) become one access, so only one barrier is needed
+    for(auto& access : m_Passes[pass].accesses){
+        if(access.resource != resource)
+            continue;
+
+        if(access.layout != accessInfo.layout)
+            throw std::runtime_error("RenderGraph::addAccess() -> " + m_Resources[resource].name
+                                     + " is used with two layouts in pass " + m_Passes[pass].name + "!");
+
+        access.stage |= accessInfo.stage;
+        access.access |= accessInfo.access;
+        access.write = access.write || write;
+        return;
+    }
+
+    m_Passes[pass].accesses.push_back({resource, accessInfo.stage, accessInfo.access, accessInfo.layout, write});
+}
+
+void RenderGraph::Compile() {
+    cullPasses();
+    assignAliasSlots();
+    scheduleBarriers();
+}
+
+void RenderGraph::cullPasses() {
+    //walk backwards from the outputs, a pass is live when it writes something a live pass or an output needs
+    std::vector<bool> needed(m_Resources.size(), false);
+    for(size_t resource = 0; resource < m_Resources.size(); resource++)
+        needed[resource] = m_Resources[resource].imported && m_Resources[resource].importDescription.finalAccess != AccessType::None;
+
+    for(size_t pass = m_Passes.size(); pass-- > 0;){
+        Pass& currentPass = m_Passes[pass];
+
+        currentPass.culled = !currentPass.hasSideEffects;
+        for(const auto& access : currentPass.accesses){
+            if(access.write && needed[access.resource])
+                currentPass.culled = false;
+        }
+
+        if(currentPass.culled)
+            continue;
+
+        for(const auto& access : currentPass.accesses){
+            if(!access.write)
+                needed[access.resource] = true;
+        }
+    }
+}
+
+void RenderGraph::assignAliasSlots() {
+    for(auto& resource : m_Resources){
+        resource.firstPass = UINT32_MAX;
+        resource.lastPass = UINT32_MAX;
+        resource.aliasSlot = UINT32_MAX;
+    }
+
+    for(uint32_t pass = 0; pass < m_Passes.size(); pass++){
+        if(m_Passes[pass].culled)
+            continue;
+
+        for(const auto& access : m_Passes[pass].accesses){
+            Resource& resource = m_Resources[access.resource];
+            if(resource.firstPass == UINT32_MAX)
+                resource.firstPass = pass;
+            resource.lastPass = pass;
+        }
+    }
+
+    std::vector<ResourceHandle> transientResources;
+    for(ResourceHandle resource = 0; resource < m_Resources.size(); resource++){
+        if(!m_Resources[resource].imported && m_Resources[resource].firstPass != UINT32_MAX)
+            transientResources.push_back(resource);
+    }
+
+    std::sort(transientResources.begin(), transientResources.end(), [this](ResourceHandle a, ResourceHandle b){
+        return m_Resources[a].firstPass < m_Resources[b].firstPass;
+    });
+
+    //first fit, an image reuses the slot of an image whose last use was in an earlier pass
+    m_AliasSlots.clear();
+    for(ResourceHandle resource : transientResources){
+        uint32_t firstPass = m_Resources[resource].firstPass;
+
+        uint32_t slot = 0;
+        for(; slot < m_AliasSlots.size(); slot++){
+            if(m_Resources[m_AliasSlots[slot].resources.back()].lastPass < firstPass)
+                break;
+        }
+
+        if(slot == m_AliasSlots.size())
+            m_AliasSlots.emplace_back();
+
+        m_AliasSlots[slot].resources.push_back(resource);
+        m_Resources[resource].aliasSlot = slot;
+    }
+}
+
+void RenderGraph::scheduleBarriers() {
+    m_CompiledPasses.clear();
+    m_FinalBarriers.clear();
+
+    std::vector<ResourceState> states(m_Resources.size());
+    for(size_t resource = 0; resource < m_Resources.size(); resource++){
+        if(!m_Resources[resource].imported)
+            continue;
+
+        //initial stage only orders against whatever made the image available, there is nothing to make visible
+        states[resource].layout = m_Resources[resource].importDescription.initialLayout;
+        states[resource].writeStage = m_Resources[resource].importDescription.initialStage;
+    }
+
+    for(auto& aliasSlot : m_AliasSlots){
+        aliasSlot.lastStages = 0;
+        aliasSlot.lastWriteAccess = 0;
+    }
+
+    for(uint32_t pass = 0; pass < m_Passes.size(); pass++){
+        if(m_Passes[pass].culled)
+            continue;
+
+        CompiledPass compiledPass{};
+        compiledPass.pass = pass;
+
+        for(const auto& access : m_Passes[pass].accesses){
+            Resource& resource = m_Resources[access.resource];
+            ResourceState& state = states[access.resource];
+
+            //contents of a transient image are undefined on first use, it only has to wait for the previous slot owner
+            if(!resource.imported && resource.firstPass == pass){
+                const AliasSlot& aliasSlot = m_AliasSlots[resource.aliasSlot];
+                state = ResourceState{};
+                state.writeStage = aliasSlot.lastStages;
+                state.writeAccess = aliasSlot.lastWriteAccess;
+            }
+
+            bool layoutChange = state.layout != access.layout;
+
+            if(layoutChange || access.write){
+                //write after read/write, or a transition which itself is a write
+                ImageBarrier imageBarrier{};
+                imageBarrier.resource = access.resource;
+                imageBarrier.srcStage = state.writeStage | state.readStages;
+                imageBarrier.srcAccess = state.writeAccess;
+                imageBarrier.dstStage = access.stage;
+                imageBarrier.dstAccess = access.access;
+                imageBarrier.oldLayout = state.layout;
+                imageBarrier.newLayout = access.layout;
+
+                if(imageBarrier.srcStage == 0)
+                    imageBarrier.srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+                //first write into an image nobody touched before needs neither ordering nor a transition
+                bool redundant = !layoutChange && state.writeStage == 0 && state.readStages == 0;
+                if(!redundant)
+                    compiledPass.barriers.push_back(imageBarrier);
+
+                state.layout = access.layout;
+                state.writeStage = access.stage;
+                state.writeAccess = access.write ? access.access & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                                                   VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                                   VK_ACCESS_SHADER_WRITE_BIT |
+                                                                   VK_ACCESS_TRANSFER_WRITE_BIT) : 0;
+                state.readStages = access.write ? 0 : access.stage;
+                state.visibleStages = access.stage;
+            }
+            else {
+                //read after read in the same layout is free, read after write only once per stage
+                if(state.writeAccess != 0 && (access.stage & ~state.visibleStages) != 0){
+                    ImageBarrier imageBarrier{};
+                    imageBarrier.resource = access.resource;
+                    imageBarrier.srcStage = state.writeStage;
+                    imageBarrier.srcAccess = state.writeAccess;
+                    imageBarrier.dstStage = access.stage;
+                    imageBarrier.dstAccess = access.access;
+                    imageBarrier.oldLayout = state.layout;
+                    imageBarrier.newLayout = state.layout;
+
+                    compiledPass.barriers.push_back(imageBarrier);
+                    state.visibleStages |= access.stage;
+                }
+
+                state.readStages |= access.stage;
+            }
+
+            if(!resource.imported && resource.lastPass == pass){
+                AliasSlot& aliasSlot = m_AliasSlots[resource.aliasSlot];
+                aliasSlot.lastStages = state.writeStage | state.readStages;
+                aliasSlot.lastWriteAccess = state.writeAccess;
+            }
+        }
+
+        m_CompiledPasses.push_back(std::move(compiledPass));
+    }
+
+    //transient images are reused by the next frame, whose first use may overlap on the GPU with the end of this one
+    for(const auto& aliasSlot : m_AliasSlots){
+        ResourceHandle firstResource = aliasSlot.resources.front();
+
+        for(auto& compiledPass : m_CompiledPasses){
+            if(compiledPass.pass != m_Resources[firstResource].firstPass)
+                continue;
+
+            for(auto& barrier : compiledPass.barriers){
+                if(barrier.resource != firstResource)
+                    continue;
+
+                barrier.srcStage |= aliasSlot.lastStages;
+                barrier.srcAccess |= aliasSlot.lastWriteAccess;
+            }
+        }
+    }
+
+    for(ResourceHandle resource = 0; resource < m_Resources.size(); resource++){
+        const ImportDescription& importDescription = m_Resources[resource].importDescription;
+        if(!m_Resources[resource].imported || importDescription.finalAccess == AccessType::None)
+            continue;
+
+        const ResourceState& state = states[resource];
+        AccessInfo finalAccess = getAccessInfo(importDescription.finalAccess);
+
+        if(state.layout == finalAccess.layout && state.writeAccess == 0)
+            continue;
+
+        ImageBarrier imageBarrier{};
+        imageBarrier.resource = resource;
+        imageBarrier.srcStage = state.writeStage | state.readStages;
+        imageBarrier.srcAccess = state.writeAccess;
+        imageBarrier.dstStage = finalAccess.stage;
+        imageBarrier.dstAccess = finalAccess.access;
+        imageBarrier.oldLayout = state.layout;
+        imageBarrier.newLayout = finalAccess.layout;
+
+        if(imageBarrier.srcStage == 0)
+            imageBarrier.srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+        m_FinalBarriers.push_back(imageBarrier);
+    }
+}
+
+void RenderGraph::Realize(VulkanMemoryAllocator* allocator) {
+    destroyImages();
+    m_Allocator = allocator;
+
+    VkDevice device = m_Allocator->GetDevice();
+
+    std::vector<VkMemoryRequirements> memoryRequirements(m_Resources.size());
+    for(ResourceHandle handle = 0; handle < m_Resources.size(); handle++){
+        Resource& resource = m_Resources[handle];
+        if(resource.imported || resource.aliasSlot == UINT32_MAX)
+            continue;
+
+        VkImageCreateInfo imageCreateInfo{};
+        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format = resource.description.format;
+        imageCreateInfo.extent = {resource.description.extent.width, resource.description.extent.height, 1};
+        imageCreateInfo.mipLevels = 1;
+        imageCreateInfo.arrayLayers = 1;
+        imageCreateInfo.samples = resource.description.samples;
+        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage = resource.usage;
+        //contents never leave the render pass, so tilers can keep them in on-chip memory
+        if(isAttachmentOnly(resource.usage))
+            imageCreateInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if(vkCreateImage(device, &imageCreateInfo, nullptr, &resource.image) != VK_SUCCESS)
+            throw std::runtime_error("RenderGraph::Realize() -> Failed to create image " + resource.name + "!");
+
+        vkGetImageMemoryRequirements(device, resource.image, &memoryRequirements[handle]);
+    }
+
+    //lazily allocated memory has no physical pages to share, those images get their own (mostly uncommitted) allocation
+    for(ResourceHandle handle = 0; handle < m_Resources.size(); handle++){
+        Resource& resource = m_Resources[handle];
+        if(resource.image == VK_NULL_HANDLE || resource.imported || !isAttachmentOnly(resource.usage))
+            continue;
+
+        uint32_t memoryTypeIndex = findLazilyAllocatedMemoryType(memoryRequirements[handle].memoryTypeBits);
+        if(memoryTypeIndex == UINT32_MAX)
+            continue;
+
+        resource.lazilyAllocated = true;
+        resource.allocation = m_Allocator->AllocateDedicated(memoryRequirements[handle].size, memoryTypeIndex);
+        if(vkBindImageMemory(device, resource.image, resource.allocation.Memory, resource.allocation.Offset) != VK_SUCCESS)
+            throw std::runtime_error("RenderGraph::Realize() -> Failed to bind lazily allocated memory of " + resource.name + "!");
+
+        std::vector<ResourceHandle>& slotResources = m_AliasSlots[resource.aliasSlot].resources;
+        slotResources.erase(std::find(slotResources.begin(), slotResources.end(), handle));
+    }
+
+    //images which can't share the memory type of their slot get a slot of their own
+    for(size_t slot = 0; slot < m_AliasSlots.size(); slot++){
+        if(m_AliasSlots[slot].resources.empty())
+            continue;
+
+        std::vector<ResourceHandle> slotResources;
+        std::vector<ResourceHandle> splitResources;
+
+        VkMemoryRequirements slotRequirements = memoryRequirements[m_AliasSlots[slot].resources.front()];
+        for(ResourceHandle handle : m_AliasSlots[slot].resources){
+            const VkMemoryRequirements& requirements = memoryRequirements[handle];
+
+            if((slotRequirements.memoryTypeBits & requirements.memoryTypeBits) == 0){
+                splitResources.push_back(handle);
+                continue;
+            }
+
+            slotRequirements.size = std::max(slotRequirements.size, requirements.size);
+            slotRequirements.alignment = std::max(slotRequirements.alignment, requirements.alignment);
+            slotRequirements.memoryTypeBits &= requirements.memoryTypeBits;
+            slotResources.push_back(handle);
+        }
+
+        m_AliasSlots[slot].resources = slotResources;
+        m_AliasSlots[slot].allocation = m_Allocator->Allocate(slotRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                              VulkanMemoryAllocator::ResourceType::Optimal);
+
+        for(ResourceHandle handle : slotResources){
+            if(vkBindImageMemory(device, m_Resources[handle].image, m_AliasSlots[slot].allocation.Memory,
+                                 m_AliasSlots[slot].allocation.Offset) != VK_SUCCESS)
+                throw std::runtime_error("RenderGraph::Realize() -> Failed to bind memory of " + m_Resources[handle].name + "!");
+        }
+
+        //split images are visited again as their own slot later in this loop
+        for(ResourceHandle handle : splitResources){
+            AliasSlot aliasSlot{};
+            aliasSlot.resources.push_back(handle);
+            m_Resources[handle].aliasSlot = static_cast<uint32_t>(m_AliasSlots.size());
+            m_AliasSlots.push_back(std::move(aliasSlot));
+        }
+    }
+
+    for(auto& resource : m_Resources){
+        if(resource.image == VK_NULL_HANDLE || resource.imported)
+            continue;
+
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        imageViewCreateInfo.image = resource.image;
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewCreateInfo.format = resource.description.format;
+        imageViewCreateInfo.subresourceRange.aspectMask = resource.description.aspect;
+        imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+        imageViewCreateInfo.subresourceRange.levelCount = 1;
+        imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+        imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+        if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &resource.imageView) != VK_SUCCESS)
+            throw std::runtime_error("RenderGraph::Realize() -> Failed to create image view of " + resource.name + "!");
+    }
+}
+
+void RenderGraph::Execute(VkCommandBuffer commandBuffer) const {
+    std::vector<VkImageMemoryBarrier> imageMemoryBarriers;
+
+    auto recordBarriers = [&](const std::vector<ImageBarrier>& barriers){
+        if(barriers.empty())
+            return;
+
+        //one call per pass, stage masks of all its barriers are merged
+        VkPipelineStageFlags srcStageMask = 0;
+        VkPipelineStageFlags dstStageMask = 0;
+        imageMemoryBarriers.clear();
+
+        for(const auto& barrier : barriers){
+            const Resource& resource = m_Resources[barrier.resource];
+
+            VkImageMemoryBarrier imageMemoryBarrier{};
+            imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            imageMemoryBarrier.srcAccessMask = barrier.srcAccess;
+            imageMemoryBarrier.dstAccessMask = barrier.dstAccess;
+            imageMemoryBarrier.oldLayout = barrier.oldLayout;
+            imageMemoryBarrier.newLayout = barrier.newLayout;
+            imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.image = resource.image;
+            imageMemoryBarrier.subresourceRange.aspectMask = resource.imported ? resource.importDescription.aspect : resource.description.aspect;
+            imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+            imageMemoryBarrier.subresourceRange.levelCount = 1;
+            imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+            imageMemoryBarrier.subresourceRange.layerCount = 1;
+
+            imageMemoryBarriers.push_back(imageMemoryBarrier);
+            srcStageMask |= barrier.srcStage;
+            dstStageMask |= barrier.dstStage;
+        }
+
+        vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0,
+                             0, nullptr, 0, nullptr,
+                             static_cast<uint32_t>(imageMemoryBarriers.size()), imageMemoryBarriers.data());
+    };
+
+    for(const auto& compiledPass : m_CompiledPasses){
+        recordBarriers(compiledPass.barriers);
+        m_Passes[compiledPass.pass].execute(commandBuffer);
+    }
+
+    recordBarriers(m_FinalBarriers);
+}
+
+void RenderGraph::destroyImages() {
+    if(m_Allocator == nullptr)
+        return;
+
+    VkDevice device = m_Allocator->GetDevice();
+    for(auto& resource : m_Resources){
+        if(resource.imported)
+            continue;
+
+        vkDestroyImageView(device, resource.imageView, nullptr);
+        vkDestroyImage(device, resource.image, nullptr);
+        resource.imageView = VK_NULL_HANDLE;
+        resource.image = VK_NULL_HANDLE;
+
+        if(resource.lazilyAllocated)
+            m_Allocator->Free(resource.allocation);
+        resource.lazilyAllocated = false;
+        resource.allocation = VulkanAllocation{};
+    }
+
+    for(auto& aliasSlot : m_AliasSlots){
+        if(aliasSlot.allocation.Memory != VK_NULL_HANDLE)
+            m_Allocator->Free(aliasSlot.allocation);
+        aliasSlot.allocation = VulkanAllocation{};
+    }
+}
+
+uint32_t RenderGraph::findLazilyAllocatedMemoryType(uint32_t typeFilter) const {
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = m_Allocator->GetMemoryProperties();
+
+    for(uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++){
+        if((typeFilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+            return i;
+    }
+
+    return UINT32_MAX;
+}
+
+bool RenderGraph::isAttachmentOnly(VkImageUsageFlags usage) {
+    VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                        VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    return usage != 0 && (usage & ~attachmentUsage) == 0;
+}
+
+RenderGraph::AccessInfo RenderGraph::getAccessInfo(AccessType accessType) {
+    switch(accessType){
+        case AccessType::ColorAttachmentWrite:
+            return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, true};
+        case AccessType::DepthStencilAttachmentWrite:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, true};
+        case AccessType::DepthStencilAttachmentRead:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, false};
+        case AccessType::FragmentShaderRead:
+            return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, false};
+        case AccessType::ComputeShaderRead:
+            return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, false};
+        case AccessType::ComputeShaderWrite:
+            return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT, true};
+        case AccessType::TransferRead:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT, false};
+        case AccessType::TransferWrite:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT, true};
+        case AccessType::Present:
+            //presentation engine synchronizes through the semaphore, only the layout matters
+            return {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0, false};
+        case AccessType::None:
+        default:
+            return {VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED, 0, false};
+    }
+}
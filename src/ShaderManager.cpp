@@ -0,0 +1,172 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "ShaderManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ShaderManager::ShaderManager(std::string sourceDirectory, std::string outputDirectory, std::string compilerPath)
+    : m_SourceDirectory(std::move(sourceDirectory)), m_OutputDirectory(std::move(outputDirectory)), m_CompilerPath(std::move(compilerPath)) {
+}
+
+ShaderManager::~ShaderManager() {
+    Stop();
+}
+
+bool ShaderManager::Start(ReloadFunction reloadFunction) {
+#ifdef __linux__
+    if(IsRunning())
+        return true;
+
+    m_InotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(m_InotifyDescriptor < 0)
+        return false;
+
+    //editors either rewrite the file in place or write a temporary one and rename it over the source
+    if(inotify_add_watch(m_InotifyDescriptor, m_SourceDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0){
+        close(m_InotifyDescriptor);
+        m_InotifyDescriptor = -1;
+        return false;
+    }
+
+    m_ReloadFunction = std::move(reloadFunction);
+    m_Stopping = false;
+    m_Thread = std::thread(&ShaderManager::watchLoop, this);
+    return true;
+#else
+    (void)reloadFunction;
+    return false;
+#endif
+}
+
+void ShaderManager::Stop() {
+    if(!IsRunning())
+        return;
+
+    m_Stopping = true;
+    m_Thread.join();
+
+#ifdef __linux__
+    close(m_InotifyDescriptor);
+#endif
+    m_InotifyDescriptor = -1;
+}
+
+void ShaderManager::watchLoop() {
+#ifdef __linux__
+    while(!m_Stopping){
+        //short timeout, the thread has to notice Stop() without an extra wake up descriptor
+        pollfd pollDescriptor{m_InotifyDescriptor, POLLIN, 0};
+        if(poll(&pollDescriptor, 1, 100) <= 0)
+            continue;
+
+        std::vector<std::string> changedFiles;
+        readEvents(changedFiles);
+
+        //a save usually produces a burst of events, give it a moment to settle and compile once
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        readEvents(changedFiles);
+
+        std::vector<std::string> shaderNames;
+        for(const auto& fileName : changedFiles){
+            if(isShaderStage(fileName))
+                shaderNames.push_back(fileName);
+            else if(fileName.size() > 5 && fileName.compare(fileName.size() - 5, 5, ".glsl") == 0){
+                //included file changed, every stage may depend on it
+                shaderNames = listShaderStages();
+                break;
+            }
+        }
+
+        std::sort(shaderNames.begin(), shaderNames.end());
+        shaderNames.erase(std::unique(shaderNames.begin(), shaderNames.end()), shaderNames.end());
+
+        std::vector<std::string> compiledShaders;
+        for(const auto& shaderName : shaderNames)
+            if(compileShader(shaderName))
+                compiledShaders.push_back(shaderName);
+
+        if(compiledShaders.empty())
+            continue;
+
+        try{
+            m_ReloadFunction(compiledShaders);
+        } catch (const std::exception& e) {
+            std::cerr << "Shader reload failed: " << e.what() << std::endl;
+        }
+    }
+#endif
+}
+
+void ShaderManager::readEvents(std::vector<std::string>& changedFiles) const {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    ssize_t length;
+    while((length = read(m_InotifyDescriptor, buffer, sizeof(buffer))) > 0){
+        for(char* event = buffer; event < buffer + length; event += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(event)->len){
+            auto* inotifyEvent = reinterpret_cast<inotify_event*>(event);
+            if(inotifyEvent->len > 0)
+                changedFiles.emplace_back(inotifyEvent->name);
+        }
+    }
+#else
+    (void)changedFiles;
+#endif
+}
+
+bool ShaderManager::compileShader(const std::string& shaderName) const {
+    const std::string sourcePath = m_SourceDirectory + "/" + shaderName;
+    const std::string outputPath = m_OutputDirectory + "/" + shaderName + ".bin";
+    const std::string temporaryPath = outputPath + ".tmp";
+
+    //same flags as compile_shader() in CMakeLists.txt
+    const std::string command = "\"" + m_CompilerPath + "\" --target-env=vulkan1.1 -o \"" + temporaryPath + "\" \"" + sourcePath + "\"";
+    if(std::system(command.c_str()) != 0){
+        std::cerr << "Failed to compile shader " << shaderName << ", keeping the previous binary" << std::endl;
+        return false;
+    }
+
+    //rename is atomic, a pipeline build reading the binary never sees a partially written file
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, outputPath, errorCode);
+    if(errorCode){
+        std::cerr << "Failed to replace " << outputPath << ": " << errorCode.message() << std::endl;
+        return false;
+    }
+
+    std::cout << "Recompiled shader " << shaderName << std::endl;
+    return true;
+}
+
+bool ShaderManager::isShaderStage(const std::string& fileName) {
+    static const std::vector<std::string> stageExtensions = {".vert", ".frag", ".comp", ".geom", ".tesc", ".tese"};
+
+    return std::any_of(stageExtensions.begin(), stageExtensions.end(), [&fileName](const std::string& extension){
+        return fileName.size() > extension.size() && fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+    });
+}
+
+std::vector<std::string> ShaderManager::listShaderStages() const {
+    std::vector<std::string> shaderNames;
+
+    std::error_code errorCode;
+    for(const auto& entry : std::filesystem::directory_iterator(m_SourceDirectory, errorCode)){
+        std::string fileName = entry.path().filename().string();
+        if(isShaderStage(fileName))
+            shaderNames.push_back(fileName);
+    }
+
+    return shaderNames;
+}
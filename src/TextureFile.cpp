@@ -0,0 +1,389 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    struct FormatTableEntry {
+        VkFormat format;
+        TextureFormatInfo info;
+    };
+
+    const FormatTableEntry FORMAT_TABLE[] = {
+        {VK_FORMAT_R8G8B8A8_UNORM, {1, 1, 4, false}},
+        {VK_FORMAT_R8G8B8A8_SRGB, {1, 1, 4, true}},
+        {VK_FORMAT_B8G8R8A8_UNORM, {1, 1, 4, false}},
+        {VK_FORMAT_B8G8R8A8_SRGB, {1, 1, 4, true}},
+
+        {VK_FORMAT_BC1_RGB_UNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_BC1_RGB_SRGB_BLOCK, {4, 4, 8, true}},
+        {VK_FORMAT_BC1_RGBA_UNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_BC1_RGBA_SRGB_BLOCK, {4, 4, 8, true}},
+        {VK_FORMAT_BC2_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC2_SRGB_BLOCK, {4, 4, 16, true}},
+        {VK_FORMAT_BC3_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC3_SRGB_BLOCK, {4, 4, 16, true}},
+        {VK_FORMAT_BC4_UNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_BC4_SNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_BC5_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC5_SNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC6H_UFLOAT_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC6H_SFLOAT_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC7_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_BC7_SRGB_BLOCK, {4, 4, 16, true}},
+
+        {VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK, {4, 4, 8, true}},
+        {VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK, {4, 4, 8, false}},
+        {VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK, {4, 4, 8, true}},
+        {VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, {4, 4, 16, true}},
+
+        {VK_FORMAT_ASTC_4x4_UNORM_BLOCK, {4, 4, 16, false}},
+        {VK_FORMAT_ASTC_4x4_SRGB_BLOCK, {4, 4, 16, true}},
+        {VK_FORMAT_ASTC_5x4_UNORM_BLOCK, {5, 4, 16, false}},
+        {VK_FORMAT_ASTC_5x4_SRGB_BLOCK, {5, 4, 16, true}},
+        {VK_FORMAT_ASTC_5x5_UNORM_BLOCK, {5, 5, 16, false}},
+        {VK_FORMAT_ASTC_5x5_SRGB_BLOCK, {5, 5, 16, true}},
+        {VK_FORMAT_ASTC_6x5_UNORM_BLOCK, {6, 5, 16, false}},
+        {VK_FORMAT_ASTC_6x5_SRGB_BLOCK, {6, 5, 16, true}},
+        {VK_FORMAT_ASTC_6x6_UNORM_BLOCK, {6, 6, 16, false}},
+        {VK_FORMAT_ASTC_6x6_SRGB_BLOCK, {6, 6, 16, true}},
+        {VK_FORMAT_ASTC_8x5_UNORM_BLOCK, {8, 5, 16, false}},
+        {VK_FORMAT_ASTC_8x5_SRGB_BLOCK, {8, 5, 16, true}},
+        {VK_FORMAT_ASTC_8x6_UNORM_BLOCK, {8, 6, 16, false}},
+        {VK_FORMAT_ASTC_8x6_SRGB_BLOCK, {8, 6, 16, true}},
+        {VK_FORMAT_ASTC_8x8_UNORM_BLOCK, {8, 8, 16, false}},
+        {VK_FORMAT_ASTC_8x8_SRGB_BLOCK, {8, 8, 16, true}},
+        {VK_FORMAT_ASTC_10x5_UNORM_BLOCK, {10, 5, 16, false}},
+        {VK_FORMAT_ASTC_10x5_SRGB_BLOCK, {10, 5, 16, true}},
+        {VK_FORMAT_ASTC_10x6_UNORM_BLOCK, {10, 6, 16, false}},
+        {VK_FORMAT_ASTC_10x6_SRGB_BLOCK, {10, 6, 16, true}},
+        {VK_FORMAT_ASTC_10x8_UNORM_BLOCK, {10, 8, 16, false}},
+        {VK_FORMAT_ASTC_10x8_SRGB_BLOCK, {10, 8, 16, true}},
+        {VK_FORMAT_ASTC_10x10_UNORM_BLOCK, {10, 10, 16, false}},
+        {VK_FORMAT_ASTC_10x10_SRGB_BLOCK, {10, 10, 16, true}},
+        {VK_FORMAT_ASTC_12x10_UNORM_BLOCK, {12, 10, 16, false}},
+        {VK_FORMAT_ASTC_12x10_SRGB_BLOCK, {12, 10, 16, true}},
+        {VK_FORMAT_ASTC_12x12_UNORM_BLOCK, {12, 12, 16, false}},
+        {VK_FORMAT_ASTC_12x12_SRGB_BLOCK, {12, 12, 16, true}},
+    };
+
+    uint16_t readU16(const unsigned char* data) {
+        return static_cast<uint16_t>(data[0] | (data[1] << 8));
+    }
+
+    uint32_t readU32(const unsigned char* data) {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+               (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+
+    std::array<unsigned char, 4> expand565(uint16_t color) {
+        auto r = static_cast<unsigned char>((color >> 11) & 31);
+        auto g = static_cast<unsigned char>((color >> 5) & 63);
+        auto b = static_cast<unsigned char>(color & 31);
+        return {static_cast<unsigned char>((r << 3) | (r >> 2)),
+                static_cast<unsigned char>((g << 2) | (g >> 4)),
+                static_cast<unsigned char>((b << 3) | (b >> 2)),
+                255};
+    }
+
+    ///@brief decodes the color half of a BC1 - BC3 block into 16 RGBA texels
+    void decodeColorBlock(const unsigned char* block, bool fourColorsOnly, unsigned char* texels) {
+        uint16_t color0 = readU16(block);
+        uint16_t color1 = readU16(block + 2);
+        uint32_t indices = readU32(block + 4);
+
+        std::array<std::array<unsigned char, 4>, 4> palette{};
+        palette[0] = expand565(color0);
+        palette[1] = expand565(color1);
+        for(int channel = 0; channel < 3; channel++){
+            int c0 = palette[0][channel];
+            int c1 = palette[1][channel];
+            if(color0 > color1 || fourColorsOnly){
+                palette[2][channel] = static_cast<unsigned char>((2 * c0 + c1) / 3);
+                palette[3][channel] = static_cast<unsigned char>((c0 + 2 * c1) / 3);
+            }
+            else {
+                palette[2][channel] = static_cast<unsigned char>((c0 + c1) / 2);
+                palette[3][channel] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        //three color mode of BC1 encodes transparent black
+        palette[3][3] = (color0 > color1 || fourColorsOnly) ? 255 : 0;
+
+        for(int texel = 0; texel < 16; texel++)
+            std::memcpy(texels + texel * 4, palette[(indices >> (texel * 2)) & 3].data(), 4);
+    }
+
+    void decodeExplicitAlphaBlock(const unsigned char* block, unsigned char* texels) {
+        for(int texel = 0; texel < 16; texel++){
+            int nibble = (block[texel / 2] >> ((texel % 2) * 4)) & 15;
+            texels[texel * 4 + 3] = static_cast<unsigned char>(nibble * 17);
+        }
+    }
+
+    void decodeInterpolatedAlphaBlock(const unsigned char* block, unsigned char* texels) {
+        int alpha0 = block[0];
+        int alpha1 = block[1];
+
+        std::array<unsigned char, 8> palette{};
+        palette[0] = static_cast<unsigned char>(alpha0);
+        palette[1] = static_cast<unsigned char>(alpha1);
+        if(alpha0 > alpha1){
+            for(int i = 1; i < 7; i++)
+                palette[i + 1] = static_cast<unsigned char>(((7 - i) * alpha0 + i * alpha1) / 7);
+        }
+        else {
+            for(int i = 1; i < 5; i++)
+                palette[i + 1] = static_cast<unsigned char>(((5 - i) * alpha0 + i * alpha1) / 5);
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for(int i = 0; i < 6; i++)
+            indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+
+        for(int texel = 0; texel < 16; texel++)
+            texels[texel * 4 + 3] = palette[(indices >> (texel * 3)) & 7];
+    }
+
+    float srgbToLinear(float value) {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linearToSrgb(float value) {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    ///@brief 2x2 box filter over 4 byte texels, color averaged in linear space for sRGB formats
+    std::vector<char> downsample(const char* source, VkExtent2D sourceExtent, VkExtent2D extent, bool srgb) {
+        static const std::array<float, 256> SRGB_TO_LINEAR = [](){
+            std::array<float, 256> table{};
+            for(size_t i = 0; i < table.size(); i++)
+                table[i] = srgbToLinear(static_cast<float>(i) / 255.0f);
+            return table;
+        }();
+
+        auto texels = reinterpret_cast<const unsigned char*>(source);
+        std::vector<char> result(static_cast<size_t>(extent.width) * extent.height * 4);
+
+        for(uint32_t y = 0; y < extent.height; y++){
+            //odd sizes fold the last row and column into the previous texel
+            uint32_t y0 = std::min(y * 2, sourceExtent.height - 1);
+            uint32_t y1 = std::min(y * 2 + 1, sourceExtent.height - 1);
+            for(uint32_t x = 0; x < extent.width; x++){
+                uint32_t x0 = std::min(x * 2, sourceExtent.width - 1);
+                uint32_t x1 = std::min(x * 2 + 1, sourceExtent.width - 1);
+                const unsigned char* quad[4] = {
+                    texels + (static_cast<size_t>(y0) * sourceExtent.width + x0) * 4,
+                    texels + (static_cast<size_t>(y0) * sourceExtent.width + x1) * 4,
+                    texels + (static_cast<size_t>(y1) * sourceExtent.width + x0) * 4,
+                    texels + (static_cast<size_t>(y1) * sourceExtent.width + x1) * 4,
+                };
+
+                char* target = result.data() + (static_cast<size_t>(y) * extent.width + x) * 4;
+                for(int channel = 0; channel < 4; channel++){
+                    float value;
+                    //alpha is always linear
+                    if(srgb && channel < 3){
+                        float sum = 0.0f;
+                        for(const unsigned char* texel : quad)
+                            sum += SRGB_TO_LINEAR[texel[channel]];
+                        value = linearToSrgb(sum / 4.0f);
+                    }
+                    else {
+                        float sum = 0.0f;
+                        for(const unsigned char* texel : quad)
+                            sum += static_cast<float>(texel[channel]) / 255.0f;
+                        value = sum / 4.0f;
+                    }
+                    target[channel] = static_cast<char>(static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f));
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+void TextureFile::Open(const std::string& path) {
+    Close();
+    m_File.Open(path);
+
+    try {
+        validate(path);
+    } catch (...) {
+        Close();
+        throw;
+    }
+}
+
+void TextureFile::Close() {
+    m_File.Close();
+    m_Header = nullptr;
+    m_Levels = nullptr;
+    m_Format = VK_FORMAT_UNDEFINED;
+    m_LevelCount = 0;
+
+    std::lock_guard<std::mutex> lock(m_GenerateMutex);
+    m_Generated = false;
+    m_GeneratedLevels.clear();
+}
+
+VkExtent2D TextureFile::GetLevelExtent(uint32_t level) const {
+    return {std::max(m_Header->pixelWidth >> level, 1u), std::max(m_Header->pixelHeight >> level, 1u)};
+}
+
+size_t TextureFile::GetLevelSize(uint32_t level) const {
+    VkExtent2D extent = GetLevelExtent(level);
+    size_t blocksX = (extent.width + m_FormatInfo.blockWidth - 1) / m_FormatInfo.blockWidth;
+    size_t blocksY = (extent.height + m_FormatInfo.blockHeight - 1) / m_FormatInfo.blockHeight;
+    return blocksX * blocksY * m_FormatInfo.blockSize;
+}
+
+const char* TextureFile::GetLevelData(uint32_t level) const {
+    if(level >= m_LevelCount)
+        throw std::runtime_error("TextureFile::GetLevelData() -> Level " + std::to_string(level) + " is out of range!");
+
+    if(level == 0 || m_Header->levelCount != 0)
+        return m_File.GetData() + m_Levels[level].byteOffset;
+
+    generateLevels();
+    return m_GeneratedLevels[level - 1].data();
+}
+
+std::vector<char> TextureFile::DecodeLevel(uint32_t level) const {
+    bool explicitAlpha = m_Format == VK_FORMAT_BC2_UNORM_BLOCK || m_Format == VK_FORMAT_BC2_SRGB_BLOCK;
+    bool interpolatedAlpha = m_Format == VK_FORMAT_BC3_UNORM_BLOCK || m_Format == VK_FORMAT_BC3_SRGB_BLOCK;
+    if(GetDecodedFormat(m_Format) == VK_FORMAT_UNDEFINED)
+        throw std::runtime_error("TextureFile::DecodeLevel() -> Format can not be decoded!");
+
+    VkExtent2D extent = GetLevelExtent(level);
+    auto blocks = reinterpret_cast<const unsigned char*>(GetLevelData(level));
+    uint32_t blocksX = (extent.width + 3) / 4;
+    uint32_t blocksY = (extent.height + 3) / 4;
+
+    std::vector<char> result(static_cast<size_t>(extent.width) * extent.height * 4);
+    unsigned char texels[16 * 4];
+    for(uint32_t blockY = 0; blockY < blocksY; blockY++){
+        for(uint32_t blockX = 0; blockX < blocksX; blockX++){
+            const unsigned char* block = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * m_FormatInfo.blockSize;
+
+            //alpha blocks come first, BC2 and BC3 always use the four color palette
+            if(explicitAlpha || interpolatedAlpha){
+                decodeColorBlock(block + 8, true, texels);
+                if(explicitAlpha)
+                    decodeExplicitAlphaBlock(block, texels);
+                else
+                    decodeInterpolatedAlphaBlock(block, texels);
+            }
+            else
+                decodeColorBlock(block, false, texels);
+
+            //blocks on the right and bottom edge may reach past the level
+            for(uint32_t y = 0; y < 4 && blockY * 4 + y < extent.height; y++){
+                uint32_t width = std::min(4u, extent.width - blockX * 4);
+                std::memcpy(result.data() + ((static_cast<size_t>(blockY) * 4 + y) * extent.width + blockX * 4) * 4,
+                            texels + y * 4 * 4, width * 4);
+            }
+        }
+    }
+
+    return result;
+}
+
+bool TextureFile::GetFormatInfo(VkFormat format, TextureFormatInfo& info) {
+    for(const auto& entry : FORMAT_TABLE){
+        if(entry.format == format){
+            info = entry.info;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+VkFormat TextureFile::GetDecodedFormat(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+            return VK_FORMAT_R8G8B8A8_SRGB;
+        default:
+            return VK_FORMAT_UNDEFINED;
+    }
+}
+
+void TextureFile::validate(const std::string& path) {
+    if(m_File.GetSize() < sizeof(TextureFileHeader))
+        throw std::runtime_error("TextureFile::Open() -> " + path + " is too small!");
+
+    auto header = reinterpret_cast<const TextureFileHeader*>(m_File.GetData());
+    if(std::memcmp(header->identifier, TextureFileHeader::IDENTIFIER, sizeof(header->identifier)) != 0)
+        throw std::runtime_error("TextureFile::Open() -> " + path + " is not a KTX2 file!");
+    if(header->supercompressionScheme != 0)
+        throw std::runtime_error("TextureFile::Open() -> " + path + " is supercompressed, transcode it offline!");
+    if(header->pixelDepth > 1 || header->layerCount > 1 || header->faceCount != 1 || header->pixelHeight == 0)
+        throw std::runtime_error("TextureFile::Open() -> " + path + " is not a single 2D texture!");
+
+    auto format = static_cast<VkFormat>(header->vkFormat);
+    TextureFormatInfo formatInfo;
+    if(!GetFormatInfo(format, formatInfo))
+        throw std::runtime_error("TextureFile::Open() -> " + path + " has unsupported format " + std::to_string(header->vkFormat) + "!");
+
+    uint32_t storedLevelCount = std::max(header->levelCount, 1u);
+    uint32_t fullLevelCount = 1;
+    while((std::max(header->pixelWidth, header->pixelHeight) >> fullLevelCount) > 0)
+        fullLevelCount++;
+    if(storedLevelCount > fullLevelCount)
+        throw std::runtime_error("TextureFile::Open() -> " + path + " has too many levels!");
+
+    if(!m_File.Contains(sizeof(TextureFileHeader), static_cast<uint64_t>(storedLevelCount) * sizeof(TextureFileLevel)))
+        throw std::runtime_error("TextureFile::Open() -> " + path + " is truncated!");
+
+    m_Header = header;
+    m_Levels = reinterpret_cast<const TextureFileLevel*>(m_File.GetData() + sizeof(TextureFileHeader));
+    m_Format = format;
+    m_FormatInfo = formatInfo;
+
+    //every level has to be tightly packed blocks inside the file
+    for(uint32_t level = 0; level < storedLevelCount; level++){
+        if(m_Levels[level].byteLength != GetLevelSize(level) || !m_File.Contains(m_Levels[level].byteOffset, m_Levels[level].byteLength))
+            throw std::runtime_error("TextureFile::Open() -> " + path + " level " + std::to_string(level) + " is out of range!");
+    }
+
+    //the chain can only be generated for plain 4 byte texels
+    m_LevelCount = storedLevelCount;
+    if(header->levelCount == 0 && formatInfo.blockWidth == 1 && formatInfo.blockSize == 4)
+        m_LevelCount = fullLevelCount;
+}
+
+void TextureFile::generateLevels() const {
+    std::lock_guard<std::mutex> lock(m_GenerateMutex);
+    if(m_Generated)
+        return;
+
+    //each level is filtered from the previous one
+    const char* source = GetLevelData(0);
+    for(uint32_t level = 1; level < m_LevelCount; level++){
+        m_GeneratedLevels.push_back(downsample(source, GetLevelExtent(level - 1), GetLevelExtent(level), m_FormatInfo.srgb));
+        source = m_GeneratedLevels.back().data();
+    }
+
+    m_Generated = true;
+}
@@ -0,0 +1,78 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+    if(threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_Threads.reserve(threadCount);
+    for(uint32_t i = 0; i < threadCount; i++)
+        m_Threads.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_JobAvailable.notify_all();
+
+    for(auto& thread : m_Threads)
+        thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push(std::move(job));
+    }
+    m_JobAvailable.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobsFinished.wait(lock, [this]{ return m_Jobs.empty() && m_ActiveJobs == 0; });
+
+    if(m_Exception){
+        std::exception_ptr exception = m_Exception;
+        m_Exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while(true){
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_JobAvailable.wait(lock, [this]{ return m_Stopping || !m_Jobs.empty(); });
+
+            if(m_Stopping && m_Jobs.empty())
+                return;
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop();
+            m_ActiveJobs++;
+        }
+
+        try {
+            job();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(!m_Exception)
+                m_Exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ActiveJobs--;
+            if(m_Jobs.empty() && m_ActiveJobs == 0)
+                m_JobsFinished.notify_all();
+        }
+    }
+}
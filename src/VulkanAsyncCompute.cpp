@@ -0,0 +1,232 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanAsyncCompute.h"
+
+VulkanAsyncCompute::~VulkanAsyncCompute() {
+    if(m_Device == VK_NULL_HANDLE)
+        return;
+
+    destroyFrameSlots();
+    vkDestroySemaphore(m_Device, m_HandoffSemaphore, nullptr);
+    vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+}
+
+void VulkanAsyncCompute::Create(VkDevice device, VkQueue computeQueue, uint32_t computeFamily, uint32_t graphicsFamily,
+                                uint32_t framesInFlight) {
+    m_Device = device;
+    m_ComputeQueue = computeQueue;
+    m_ComputeFamily = computeFamily;
+    m_GraphicsFamily = graphicsFamily;
+
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = m_ComputeFamily;
+
+    if(vkCreateCommandPool(m_Device, &commandPoolCreateInfo, nullptr, &m_CommandPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanAsyncCompute::Create() -> Failed to create compute command pool!");
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    if(vkCreateSemaphore(m_Device, &semaphoreCreateInfo, nullptr, &m_HandoffSemaphore) != VK_SUCCESS)
+        throw std::runtime_error("VulkanAsyncCompute::Create() -> Failed to create semaphore!");
+
+    createFrameSlots(framesInFlight);
+}
+
+void VulkanAsyncCompute::SetFramesInFlight(uint32_t framesInFlight) {
+    destroyFrameSlots();
+    createFrameSlots(framesInFlight);
+}
+
+void VulkanAsyncCompute::Submit(uint32_t frameSlot, const RecordFunction& record, const std::vector<BufferTransfer>& releaseToGraphics,
+                                VkPipelineStageFlags graphicsWaitStage) {
+    FrameSlot& slot = m_FrameSlots[frameSlot];
+
+    //the graphics frame waiting on this slot's semaphore already completed, this only blocks on a skipped frame
+    vkWaitForFences(m_Device, 1, &slot.fence, VK_TRUE, UINT64_MAX);
+    vkResetCommandBuffer(slot.commandBuffer, 0);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if(vkBeginCommandBuffer(slot.commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS)
+        throw std::runtime_error("VulkanAsyncCompute::Submit() -> Failed to begin compute command buffer!");
+
+    std::vector<VkSemaphore> waitSemaphores;
+    std::vector<VkPipelineStageFlags> waitStages;
+    if(m_HandoffSignalled){
+        waitSemaphores.push_back(m_HandoffSemaphore);
+        waitStages.push_back(m_SignalledHandoffStageMask);
+
+        //source stage matches the semaphore wait stage, same as the graphics side acquires
+        if(!m_SignalledHandoffBarriers.empty())
+            vkCmdPipelineBarrier(slot.commandBuffer,
+                                 m_SignalledHandoffStageMask, m_SignalledHandoffStageMask, 0,
+                                 0, nullptr,
+                                 static_cast<uint32_t>(m_SignalledHandoffBarriers.size()), m_SignalledHandoffBarriers.data(),
+                                 0, nullptr);
+
+        m_SignalledHandoffBarriers.clear();
+        m_SignalledHandoffStageMask = 0;
+        m_HandoffSignalled = false;
+    }
+
+    record(slot.commandBuffer);
+
+    //a shared family needs no ownership transfer, the semaphore alone orders and makes the writes visible
+    if(!IsSameFamily() && !releaseToGraphics.empty()){
+        std::vector<VkBufferMemoryBarrier> releaseBarriers;
+        for(const auto& transfer : releaseToGraphics){
+            VkBufferMemoryBarrier bufferMemoryBarrier{};
+            bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferMemoryBarrier.srcAccessMask = transfer.srcAccessMask;
+            bufferMemoryBarrier.dstAccessMask = 0;
+            bufferMemoryBarrier.srcQueueFamilyIndex = m_ComputeFamily;
+            bufferMemoryBarrier.dstQueueFamilyIndex = m_GraphicsFamily;
+            bufferMemoryBarrier.buffer = transfer.buffer;
+            bufferMemoryBarrier.offset = transfer.offset;
+            bufferMemoryBarrier.size = transfer.size;
+            releaseBarriers.push_back(bufferMemoryBarrier);
+
+            bufferMemoryBarrier.srcAccessMask = 0;
+            bufferMemoryBarrier.dstAccessMask = transfer.dstAccessMask;
+            m_PendingAcquireBarriers.push_back(bufferMemoryBarrier);
+        }
+
+        vkCmdPipelineBarrier(slot.commandBuffer,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(releaseBarriers.size()), releaseBarriers.data(),
+                             0, nullptr);
+        m_PendingAcquireStageMask |= graphicsWaitStage;
+    }
+
+    if(vkEndCommandBuffer(slot.commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("VulkanAsyncCompute::Submit() -> Failed to record compute command buffer!");
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStages.data();
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &slot.commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &slot.semaphore;
+
+    vkResetFences(m_Device, 1, &slot.fence);
+    if(vkQueueSubmit(m_ComputeQueue, 1, &submitInfo, slot.fence) != VK_SUCCESS)
+        throw std::runtime_error("VulkanAsyncCompute::Submit() -> Failed to submit compute command buffer!");
+
+    m_PendingWaitSemaphores.push_back({slot.semaphore, graphicsWaitStage});
+}
+
+void VulkanAsyncCompute::RecordAcquireBarriers(VkCommandBuffer commandBuffer) {
+    if(m_PendingAcquireBarriers.empty())
+        return;
+
+    //source stage matches the semaphore wait stage of the same submit
+    vkCmdPipelineBarrier(commandBuffer,
+                         m_PendingAcquireStageMask, m_PendingAcquireStageMask, 0,
+                         0, nullptr,
+                         static_cast<uint32_t>(m_PendingAcquireBarriers.size()), m_PendingAcquireBarriers.data(),
+                         0, nullptr);
+    m_PendingAcquireBarriers.clear();
+    m_PendingAcquireStageMask = 0;
+}
+
+std::vector<VulkanAsyncCompute::WaitSemaphore> VulkanAsyncCompute::TakeWaitSemaphores() {
+    std::vector<WaitSemaphore> waitSemaphores;
+    waitSemaphores.swap(m_PendingWaitSemaphores);
+    return waitSemaphores;
+}
+
+void VulkanAsyncCompute::ReleaseToCompute(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer>& transfers,
+                                          VkPipelineStageFlags graphicsSrcStage, VkPipelineStageFlags computeDstStage) {
+    m_HandoffRecorded = true;
+    m_RecordedHandoffStageMask |= computeDstStage;
+
+    if(IsSameFamily() || transfers.empty())
+        return;
+
+    std::vector<VkBufferMemoryBarrier> releaseBarriers;
+    for(const auto& transfer : transfers){
+        VkBufferMemoryBarrier bufferMemoryBarrier{};
+        bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferMemoryBarrier.srcAccessMask = transfer.srcAccessMask;
+        bufferMemoryBarrier.dstAccessMask = 0;
+        bufferMemoryBarrier.srcQueueFamilyIndex = m_GraphicsFamily;
+        bufferMemoryBarrier.dstQueueFamilyIndex = m_ComputeFamily;
+        bufferMemoryBarrier.buffer = transfer.buffer;
+        bufferMemoryBarrier.offset = transfer.offset;
+        bufferMemoryBarrier.size = transfer.size;
+        releaseBarriers.push_back(bufferMemoryBarrier);
+
+        bufferMemoryBarrier.srcAccessMask = 0;
+        bufferMemoryBarrier.dstAccessMask = transfer.dstAccessMask;
+        m_RecordedHandoffBarriers.push_back(bufferMemoryBarrier);
+    }
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         graphicsSrcStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                         0, nullptr,
+                         static_cast<uint32_t>(releaseBarriers.size()), releaseBarriers.data(),
+                         0, nullptr);
+}
+
+VkSemaphore VulkanAsyncCompute::TakeSignalSemaphore() {
+    //a binary semaphore can not be signalled again before the wait, later releases go with the next graphics submit
+    if(!m_HandoffRecorded || m_HandoffSignalled)
+        return VK_NULL_HANDLE;
+
+    m_SignalledHandoffBarriers.swap(m_RecordedHandoffBarriers);
+    m_SignalledHandoffStageMask = m_RecordedHandoffStageMask;
+    m_RecordedHandoffBarriers.clear();
+    m_RecordedHandoffStageMask = 0;
+
+    m_HandoffRecorded = false;
+    m_HandoffSignalled = true;
+
+    return m_HandoffSemaphore;
+}
+
+void VulkanAsyncCompute::createFrameSlots(uint32_t framesInFlight) {
+    m_FrameSlots.resize(framesInFlight);
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = m_CommandPool;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for(auto& slot : m_FrameSlots){
+        if(vkAllocateCommandBuffers(m_Device, &commandBufferAllocateInfo, &slot.commandBuffer) != VK_SUCCESS)
+            throw std::runtime_error("VulkanAsyncCompute::createFrameSlots() -> Failed to allocate compute command buffer!");
+        if(vkCreateSemaphore(m_Device, &semaphoreCreateInfo, nullptr, &slot.semaphore) != VK_SUCCESS)
+            throw std::runtime_error("VulkanAsyncCompute::createFrameSlots() -> Failed to create semaphore!");
+        if(vkCreateFence(m_Device, &fenceCreateInfo, nullptr, &slot.fence) != VK_SUCCESS)
+            throw std::runtime_error("VulkanAsyncCompute::createFrameSlots() -> Failed to create fence!");
+    }
+}
+
+void VulkanAsyncCompute::destroyFrameSlots() {
+    for(auto& slot : m_FrameSlots){
+        vkWaitForFences(m_Device, 1, &slot.fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(m_Device, slot.fence, nullptr);
+        vkDestroySemaphore(m_Device, slot.semaphore, nullptr);
+        vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &slot.commandBuffer);
+    }
+    m_FrameSlots.clear();
+}
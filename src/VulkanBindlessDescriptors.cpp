@@ -0,0 +1,208 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanBindlessDescriptors.h"
+
+#include <algorithm>
+#include <array>
+
+VulkanBindlessDescriptors::VulkanBindlessDescriptors(uint32_t maxSampledImages, uint32_t maxStorageBuffers) {
+    m_SampledImageSlots.SetCapacity(maxSampledImages);
+    m_StorageBufferSlots.SetCapacity(maxStorageBuffers);
+}
+
+VulkanBindlessDescriptors::~VulkanBindlessDescriptors() {
+    //the set is freed together with its pool
+    vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(m_Device, DescriptorSetLayout, nullptr);
+}
+
+bool VulkanBindlessDescriptors::CheckSupport(VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    if(physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2)
+        return false;
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{};
+    physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    physicalDeviceFeatures2.pNext = &vulkan12Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+
+    return vulkan12Features.descriptorIndexing &&
+           vulkan12Features.runtimeDescriptorArray &&
+           vulkan12Features.descriptorBindingPartiallyBound &&
+           vulkan12Features.descriptorBindingSampledImageUpdateAfterBind &&
+           vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind &&
+           vulkan12Features.shaderSampledImageArrayNonUniformIndexing &&
+           vulkan12Features.shaderStorageBufferArrayNonUniformIndexing;
+}
+
+void VulkanBindlessDescriptors::EnableFeatures(VkPhysicalDeviceVulkan12Features& vulkan12Features) {
+    vulkan12Features.descriptorIndexing = VK_TRUE;
+    vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+    vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+    vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    vulkan12Features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+}
+
+void VulkanBindlessDescriptors::Create(VkPhysicalDevice physicalDevice, VkDevice device) {
+    m_Device = device;
+
+    VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+    vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 physicalDeviceProperties2{};
+    physicalDeviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    physicalDeviceProperties2.pNext = &vulkan12Properties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &physicalDeviceProperties2);
+
+    //both arrays are visible to every stage, so the per-stage limit applies as well
+    m_SampledImageSlots.SetCapacity(std::min({m_SampledImageSlots.GetCapacity(),
+                                              vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages,
+                                              vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages}));
+    m_StorageBufferSlots.SetCapacity(std::min({m_StorageBufferSlots.GetCapacity(),
+                                               vulkan12Properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                               vulkan12Properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers}));
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding = SAMPLED_IMAGE_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = m_SampledImageSlots.GetCapacity();
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+    bindings[1].binding = STORAGE_BUFFER_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = m_StorageBufferSlots.GetCapacity();
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+    //slots are written while the set is bound and most of them stay empty
+    const VkDescriptorBindingFlags bindlessFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+    std::array<VkDescriptorBindingFlags, 2> bindingFlags = {bindlessFlags, bindlessFlags};
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{};
+    bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsCreateInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsCreateInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+    descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptorSetLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+    descriptorSetLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+    if(vkCreateDescriptorSetLayout(m_Device, &descriptorSetLayoutCreateInfo, nullptr, &DescriptorSetLayout) != VK_SUCCESS)
+        throw std::runtime_error("VulkanBindlessDescriptors::Create() -> Failed to create descriptor set layout!");
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[0].descriptorCount = m_SampledImageSlots.GetCapacity();
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = m_StorageBufferSlots.GetCapacity();
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    descriptorPoolCreateInfo.maxSets = 1;
+    descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+
+    if(vkCreateDescriptorPool(m_Device, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanBindlessDescriptors::Create() -> Failed to create descriptor pool!");
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.descriptorPool = m_DescriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &DescriptorSetLayout;
+
+    if(vkAllocateDescriptorSets(m_Device, &descriptorSetAllocateInfo, &DescriptorSet) != VK_SUCCESS)
+        throw std::runtime_error("VulkanBindlessDescriptors::Create() -> Failed to allocate descriptor set!");
+}
+
+uint32_t VulkanBindlessDescriptors::AddSampledImage(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    uint32_t index = m_SampledImageSlots.Allocate();
+
+    VkDescriptorImageInfo descriptorImageInfo{};
+    descriptorImageInfo.imageView = imageView;
+    descriptorImageInfo.sampler = sampler;
+    descriptorImageInfo.imageLayout = imageLayout;
+
+    VkWriteDescriptorSet writeDescriptorSet{};
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.dstSet = DescriptorSet;
+    writeDescriptorSet.dstBinding = SAMPLED_IMAGE_BINDING;
+    writeDescriptorSet.dstArrayElement = index;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeDescriptorSet.pImageInfo = &descriptorImageInfo;
+
+    //the set is externally synchronized, writes are serialized by the same lock as the slots
+    vkUpdateDescriptorSets(m_Device, 1, &writeDescriptorSet, 0, nullptr);
+
+    return index;
+}
+
+uint32_t VulkanBindlessDescriptors::AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    uint32_t index = m_StorageBufferSlots.Allocate();
+
+    VkDescriptorBufferInfo descriptorBufferInfo{};
+    descriptorBufferInfo.buffer = buffer;
+    descriptorBufferInfo.offset = offset;
+    descriptorBufferInfo.range = range;
+
+    VkWriteDescriptorSet writeDescriptorSet{};
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.dstSet = DescriptorSet;
+    writeDescriptorSet.dstBinding = STORAGE_BUFFER_BINDING;
+    writeDescriptorSet.dstArrayElement = index;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+    vkUpdateDescriptorSets(m_Device, 1, &writeDescriptorSet, 0, nullptr);
+
+    return index;
+}
+
+void VulkanBindlessDescriptors::RemoveSampledImage(uint32_t index) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_SampledImageSlots.Free(index);
+}
+
+void VulkanBindlessDescriptors::RemoveStorageBuffer(uint32_t index) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StorageBufferSlots.Free(index);
+}
+
+void VulkanBindlessDescriptors::Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t set) const {
+    vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, set, 1, &DescriptorSet, 0, nullptr);
+}
+
+uint32_t VulkanBindlessDescriptors::SlotAllocator::Allocate() {
+    if(!m_FreeSlots.empty()){
+        uint32_t index = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        return index;
+    }
+
+    if(m_NextSlot >= m_Capacity)
+        throw std::runtime_error("VulkanBindlessDescriptors::SlotAllocator::Allocate() -> Out of descriptor slots!");
+
+    return m_NextSlot++;
+}
+
+void VulkanBindlessDescriptors::SlotAllocator::Free(uint32_t index) {
+    if(index == INVALID_INDEX)
+        return;
+
+    m_FreeSlots.push_back(index);
+}
@@ -0,0 +1,112 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanCommandRecorder.h"
+
+#include <algorithm>
+
+VulkanCommandRecorder::~VulkanCommandRecorder() {
+    for(auto& frameContexts : m_FrameContexts)
+        for(auto& workerContext : frameContexts)
+            vkDestroyCommandPool(m_Device, workerContext.commandPool, nullptr);
+}
+
+void VulkanCommandRecorder::Create(VkDevice device, uint32_t queueFamilyIndex, uint32_t framesInFlight) {
+    m_Device = device;
+    m_QueueFamilyIndex = queueFamilyIndex;
+
+    SetFramesInFlight(framesInFlight);
+}
+
+void VulkanCommandRecorder::SetFramesInFlight(uint32_t framesInFlight) {
+    for(size_t frame = framesInFlight; frame < m_FrameContexts.size(); frame++)
+        for(auto& workerContext : m_FrameContexts[frame])
+            vkDestroyCommandPool(m_Device, workerContext.commandPool, nullptr);
+
+    size_t createdFrames = std::min<size_t>(m_FrameContexts.size(), framesInFlight);
+    m_FrameContexts.resize(framesInFlight);
+
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
+
+    for(size_t frame = createdFrames; frame < m_FrameContexts.size(); frame++){
+        std::vector<WorkerContext>& frameContexts = m_FrameContexts[frame];
+        frameContexts.resize(m_ThreadPool->GetThreadCount());
+
+        for(auto& workerContext : frameContexts){
+            if(vkCreateCommandPool(m_Device, &commandPoolCreateInfo, nullptr, &workerContext.commandPool) != VK_SUCCESS)
+                throw std::runtime_error("VulkanCommandRecorder::SetFramesInFlight() -> Failed to create worker command pool!");
+
+            VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+            commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            commandBufferAllocateInfo.commandPool = workerContext.commandPool;
+            commandBufferAllocateInfo.commandBufferCount = 1;
+            commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+            if(vkAllocateCommandBuffers(m_Device, &commandBufferAllocateInfo, &workerContext.commandBuffer) != VK_SUCCESS)
+                throw std::runtime_error("VulkanCommandRecorder::SetFramesInFlight() -> Failed to allocate secondary command buffer!");
+        }
+    }
+}
+
+void VulkanCommandRecorder::Record(uint32_t frameIndex, VkCommandBuffer primaryCommandBuffer,
+                                   VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer,
+                                   uint32_t drawCount, const RecordFunction& recordFunction) {
+    std::vector<WorkerContext>& frameContexts = m_FrameContexts[frameIndex];
+
+    uint32_t jobCount = std::clamp((drawCount + MIN_DRAWS_PER_JOB - 1) / MIN_DRAWS_PER_JOB,
+                                   1u, static_cast<uint32_t>(frameContexts.size()));
+    uint32_t drawsPerJob = (drawCount + jobCount - 1) / jobCount;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass;
+    inheritanceInfo.subpass = subpass;
+    inheritanceInfo.framebuffer = framebuffer;
+
+    if(jobCount == 1){
+        //not worth waking up the workers
+        recordSlice(frameContexts[0], inheritanceInfo, 0, drawCount, recordFunction);
+    }
+    else {
+        for(uint32_t job = 0; job < jobCount; job++){
+            uint32_t firstDraw = job * drawsPerJob;
+            uint32_t sliceSize = std::min(drawsPerJob, drawCount - std::min(drawCount, firstDraw));
+
+            m_ThreadPool->Submit([this, &frameContexts, &inheritanceInfo, &recordFunction, job, firstDraw, sliceSize]{
+                recordSlice(frameContexts[job], inheritanceInfo, firstDraw, sliceSize, recordFunction);
+            });
+        }
+        m_ThreadPool->Wait();
+    }
+
+    //slices are executed in submission order so the draw order of the list is kept
+    m_ExecuteBuffers.clear();
+    for(uint32_t job = 0; job < jobCount; job++)
+        m_ExecuteBuffers.push_back(frameContexts[job].commandBuffer);
+
+    vkCmdExecuteCommands(primaryCommandBuffer, static_cast<uint32_t>(m_ExecuteBuffers.size()), m_ExecuteBuffers.data());
+}
+
+void VulkanCommandRecorder::recordSlice(WorkerContext& workerContext, const VkCommandBufferInheritanceInfo& inheritanceInfo,
+                                        uint32_t firstDraw, uint32_t drawCount, const RecordFunction& recordFunction) {
+    //the frame fence was waited on by the caller, so everything allocated from this pool is free to reuse
+    vkResetCommandPool(m_Device, workerContext.commandPool, 0);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if(vkBeginCommandBuffer(workerContext.commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS)
+        throw std::runtime_error("VulkanCommandRecorder::recordSlice() -> Failed to begin secondary command buffer!");
+
+    if(drawCount > 0)
+        recordFunction(workerContext.commandBuffer, firstDraw, drawCount);
+
+    if(vkEndCommandBuffer(workerContext.commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("VulkanCommandRecorder::recordSlice() -> Failed to record secondary command buffer!");
+}
@@ -0,0 +1,45 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanDeletionQueue.h"
+
+#include <algorithm>
+#include <iterator>
+
+VulkanDeletionQueue::~VulkanDeletionQueue() {
+    Flush();
+}
+
+void VulkanDeletionQueue::Push(uint64_t lastUsedFrame, Deleter deleter) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.push_back({lastUsedFrame, std::move(deleter)});
+}
+
+void VulkanDeletionQueue::Collect(uint64_t completedFrame) {
+    std::vector<Entry> readyEntries;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        //pushes from other threads may arrive slightly out of frame order, so split instead of popping the front
+        auto firstPending = std::stable_partition(m_Entries.begin(), m_Entries.end(), [completedFrame](const Entry& entry){
+            return entry.lastUsedFrame <= completedFrame;
+        });
+
+        std::move(m_Entries.begin(), firstPending, std::back_inserter(readyEntries));
+        m_Entries.erase(m_Entries.begin(), firstPending);
+    }
+
+    //deleters run outside of the lock, they are free to push new entries
+    for(auto& entry : readyEntries)
+        entry.deleter();
+}
+
+void VulkanDeletionQueue::Flush() {
+    Collect(UINT64_MAX);
+}
+
+size_t VulkanDeletionQueue::GetPendingCount() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
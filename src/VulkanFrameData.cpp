@@ -0,0 +1,148 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanFrameData.h"
+
+#include <array>
+#include <cstring>
+
+VulkanFrameData::VulkanFrameData(VulkanMemoryAllocator* allocator, VkDeviceSize frameSize, VkDeviceSize uniformRange)
+    : m_Allocator(allocator), m_FrameSize(frameSize), m_UniformRange(uniformRange) {
+}
+
+VulkanFrameData::~VulkanFrameData() {
+    m_Ring.reset();
+
+    vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(m_Device, DescriptorSetLayout, nullptr);
+}
+
+void VulkanFrameData::Create(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t framesInFlight, const std::vector<uint32_t>& queueFamilies) {
+    m_Device = device;
+    m_QueueFamilies = queueFamilies;
+
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    m_UniformAlignment = physicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
+    m_StorageAlignment = physicalDeviceProperties.limits.minStorageBufferOffsetAlignment;
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+    bindings[0].binding = UNIFORM_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+    bindings[1].binding = STORAGE_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+    descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+    if(vkCreateDescriptorSetLayout(m_Device, &descriptorSetLayoutCreateInfo, nullptr, &DescriptorSetLayout) != VK_SUCCESS)
+        throw std::runtime_error("VulkanFrameData::Create() -> Failed to create descriptor set layout!");
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    poolSizes[1].descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.maxSets = 1;
+    descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+
+    if(vkCreateDescriptorPool(m_Device, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanFrameData::Create() -> Failed to create descriptor pool!");
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.descriptorPool = m_DescriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &DescriptorSetLayout;
+
+    if(vkAllocateDescriptorSets(m_Device, &descriptorSetAllocateInfo, &DescriptorSet) != VK_SUCCESS)
+        throw std::runtime_error("VulkanFrameData::Create() -> Failed to allocate descriptor set!");
+
+    Resize(framesInFlight);
+}
+
+void VulkanFrameData::Resize(uint32_t framesInFlight) {
+    m_Ring.reset();
+    m_Ring = std::make_unique<VulkanRingArena>(m_Allocator, m_FrameSize * framesInFlight,
+                                               VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                               framesInFlight, m_QueueFamilies);
+
+    //new buffer, the set is not used by any frame while the GPU is idle
+    writeDescriptorSet();
+}
+
+void VulkanFrameData::BeginFrame(uint32_t frameSlot) {
+    m_Ring->BeginFrame(frameSlot);
+}
+
+uint32_t VulkanFrameData::PushUniform(const void* data, VkDeviceSize size) {
+    if(size != m_UniformRange)
+        throw std::runtime_error("VulkanFrameData::PushUniform() -> Size does not match the uniform range!");
+
+    return push(data, size, m_UniformAlignment);
+}
+
+uint32_t VulkanFrameData::PushStorage(const void* data, VkDeviceSize size) {
+    return push(data, size, m_StorageAlignment);
+}
+
+void VulkanFrameData::Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t set,
+                           uint32_t uniformOffset, uint32_t storageOffset) const {
+    //dynamic offsets are consumed in binding order
+    std::array<uint32_t, 2> dynamicOffsets = {uniformOffset, storageOffset};
+    vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, set, 1, &DescriptorSet,
+                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+}
+
+uint32_t VulkanFrameData::push(const void* data, VkDeviceSize size, VkDeviceSize alignment) {
+    VkDeviceSize offset = 0;
+    if(!m_Ring->Allocate(size, alignment, offset))
+        throw std::runtime_error("VulkanFrameData::push() -> Frame data ring is full!");
+
+    //ring memory is host coherent, no flush needed
+    std::memcpy(m_Ring->GetMappedData(offset), data, static_cast<size_t>(size));
+
+    return static_cast<uint32_t>(offset);
+}
+
+void VulkanFrameData::writeDescriptorSet() {
+    VkDescriptorBufferInfo uniformBufferInfo{};
+    uniformBufferInfo.buffer = m_Ring->Buffer;
+    uniformBufferInfo.offset = 0;
+    uniformBufferInfo.range = m_UniformRange;
+
+    //whole size, the effective range ends at the end of the ring whatever dynamic offset is bound
+    VkDescriptorBufferInfo storageBufferInfo{};
+    storageBufferInfo.buffer = m_Ring->Buffer;
+    storageBufferInfo.offset = 0;
+    storageBufferInfo.range = VK_WHOLE_SIZE;
+
+    std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+    writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSets[0].dstSet = DescriptorSet;
+    writeDescriptorSets[0].dstBinding = UNIFORM_BINDING;
+    writeDescriptorSets[0].descriptorCount = 1;
+    writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writeDescriptorSets[0].pBufferInfo = &uniformBufferInfo;
+
+    writeDescriptorSets[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSets[1].dstSet = DescriptorSet;
+    writeDescriptorSets[1].dstBinding = STORAGE_BINDING;
+    writeDescriptorSets[1].descriptorCount = 1;
+    writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    writeDescriptorSets[1].pBufferInfo = &storageBufferInfo;
+
+    vkUpdateDescriptorSets(m_Device, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+}
@@ -0,0 +1,274 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanGpuCuller.h"
+
+#include <algorithm>
+#include <array>
+
+VulkanGpuCuller::~VulkanGpuCuller() {
+    destroyDrawBuffers();
+    m_Allocator->DestroyBuffer(m_InstanceBuffer, m_InstanceBufferAllocation);
+
+    vkDestroyPipeline(m_Device, m_Pipeline, nullptr);
+    vkDestroyPipelineLayout(m_Device, m_PipelineLayout, nullptr);
+    vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(m_Device, m_DescriptorSetLayout, nullptr);
+}
+
+bool VulkanGpuCuller::CheckSupport(VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{};
+    physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    physicalDeviceFeatures2.pNext = &vulkan12Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+
+    return vulkan12Features.drawIndirectCount && physicalDeviceFeatures2.features.multiDrawIndirect;
+}
+
+void VulkanGpuCuller::EnableFeatures(VkPhysicalDeviceFeatures& physicalDeviceFeatures, VkPhysicalDeviceVulkan12Features& vulkan12Features) {
+    physicalDeviceFeatures.multiDrawIndirect = VK_TRUE;
+    vulkan12Features.drawIndirectCount = VK_TRUE;
+}
+
+void VulkanGpuCuller::Create(VkDevice device, VkPipelineCache pipelineCache, VkDescriptorSetLayout frameDataSetLayout,
+                             const std::vector<char>& shaderCode, uint32_t framesInFlight) {
+    m_Device = device;
+
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    for(uint32_t i = 0; i < bindings.size(); i++){
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+    descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+    if(vkCreateDescriptorSetLayout(m_Device, &descriptorSetLayoutCreateInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to create descriptor set layout!");
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = static_cast<uint32_t>(bindings.size());
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.maxSets = 1;
+    descriptorPoolCreateInfo.poolSizeCount = 1;
+    descriptorPoolCreateInfo.pPoolSizes = &poolSize;
+
+    if(vkCreateDescriptorPool(m_Device, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to create descriptor pool!");
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.descriptorPool = m_DescriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+
+    if(vkAllocateDescriptorSets(m_Device, &descriptorSetAllocateInfo, &m_DescriptorSet) != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to allocate descriptor set!");
+
+    //set 0 - culling buffers, set 1 - frame data shared with the graphics pipelines
+    std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts = {m_DescriptorSetLayout, frameDataSetLayout};
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(CullPushConstants);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+    if(vkCreatePipelineLayout(m_Device, &pipelineLayoutCreateInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to create pipeline layout!");
+
+    VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+    shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shaderModuleCreateInfo.codeSize = shaderCode.size();
+    shaderModuleCreateInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    if(vkCreateShaderModule(m_Device, &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to create shader module!");
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    computePipelineCreateInfo.stage.module = shaderModule;
+    computePipelineCreateInfo.stage.pName = "main";
+    computePipelineCreateInfo.layout = m_PipelineLayout;
+
+    VkResult result = vkCreateComputePipelines(m_Device, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &m_Pipeline);
+    vkDestroyShaderModule(m_Device, shaderModule, nullptr);
+
+    if(result != VK_SUCCESS)
+        throw std::runtime_error("VulkanGpuCuller::Create() -> Failed to create compute pipeline!");
+
+    createDrawBuffers(framesInFlight);
+}
+
+void VulkanGpuCuller::SetInstances(const std::vector<Instance>& instances) {
+    m_Allocator->DestroyBuffer(m_InstanceBuffer, m_InstanceBufferAllocation);
+    m_InstanceCount = static_cast<uint32_t>(instances.size());
+    m_ActiveInstanceCount = m_InstanceCount;
+
+    //empty buffers are not allowed, keep one element around
+    VkDeviceSize bufferSize = sizeof(Instance) * std::max<size_t>(instances.size(), 1);
+    m_Allocator->CreateBuffer(bufferSize,
+                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                              m_InstanceBuffer, m_InstanceBufferAllocation);
+
+    if(!instances.empty())
+        m_Uploader->UploadBuffer(m_InstanceBuffer, 0, instances.data(), sizeof(Instance) * instances.size(),
+                                 VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    //command regions hold one command per instance
+    createDrawBuffers(m_FramesInFlight);
+}
+
+void VulkanGpuCuller::Resize(uint32_t framesInFlight) {
+    createDrawBuffers(framesInFlight);
+}
+
+void VulkanGpuCuller::RecordCulling(VkCommandBuffer commandBuffer, uint32_t frameSlot, const VulkanFrameData* frameData,
+                                    uint32_t uniformOffset, uint32_t transformOffset) const {
+    recordReset(commandBuffer, frameSlot);
+
+    if(m_ActiveInstanceCount > 0){
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 0, 1, &m_DescriptorSet, 0, nullptr);
+        frameData->Bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, 1, uniformOffset, transformOffset);
+
+        CullPushConstants pushConstants{m_ActiveInstanceCount, frameSlot * m_InstanceCount, frameSlot};
+        vkCmdPushConstants(commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pushConstants);
+
+        vkCmdDispatch(commandBuffer, (m_ActiveInstanceCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    }
+
+    recordDrawBarrier(commandBuffer, frameSlot);
+}
+
+void VulkanGpuCuller::RecordSkip(VkCommandBuffer commandBuffer, uint32_t frameSlot) const {
+    recordReset(commandBuffer, frameSlot);
+    recordDrawBarrier(commandBuffer, frameSlot);
+}
+
+void VulkanGpuCuller::RecordDraws(VkCommandBuffer commandBuffer, uint32_t frameSlot) const {
+    if(m_InstanceCount == 0)
+        return;
+
+    vkCmdDrawIndexedIndirectCount(commandBuffer,
+                                  m_DrawCommandBuffer, static_cast<VkDeviceSize>(frameSlot) * m_InstanceCount * sizeof(VkDrawIndexedIndirectCommand),
+                                  m_DrawCountBuffer, frameSlot * sizeof(uint32_t),
+                                  m_InstanceCount, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+std::vector<VulkanAsyncCompute::BufferTransfer> VulkanGpuCuller::GetDrawTransfers(uint32_t frameSlot) const {
+    VkAccessFlags srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    return {
+        {m_DrawCommandBuffer, static_cast<VkDeviceSize>(frameSlot) * m_InstanceCount * sizeof(VkDrawIndexedIndirectCommand),
+         std::max<VkDeviceSize>(m_InstanceCount, 1) * sizeof(VkDrawIndexedIndirectCommand), srcAccessMask, VK_ACCESS_INDIRECT_COMMAND_READ_BIT},
+        {m_DrawCountBuffer, frameSlot * sizeof(uint32_t), sizeof(uint32_t), srcAccessMask, VK_ACCESS_INDIRECT_COMMAND_READ_BIT}
+    };
+}
+
+VulkanAsyncCompute::BufferTransfer VulkanGpuCuller::GetInstanceTransfer() const {
+    return {m_InstanceBuffer, 0, VK_WHOLE_SIZE, VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_SHADER_READ_BIT};
+}
+
+void VulkanGpuCuller::recordReset(VkCommandBuffer commandBuffer, uint32_t frameSlot) const {
+    vkCmdFillBuffer(commandBuffer, m_DrawCountBuffer, frameSlot * sizeof(uint32_t), sizeof(uint32_t), 0);
+
+    //the previous use of this slot's regions completed before the frame started, only the reset has to be ordered
+    VkBufferMemoryBarrier resetBarrier{};
+    resetBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    resetBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    resetBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    resetBarrier.buffer = m_DrawCountBuffer;
+    resetBarrier.offset = frameSlot * sizeof(uint32_t);
+    resetBarrier.size = sizeof(uint32_t);
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         0, nullptr, 1, &resetBarrier, 0, nullptr);
+}
+
+void VulkanGpuCuller::recordDrawBarrier(VkCommandBuffer commandBuffer, uint32_t frameSlot) const {
+    std::vector<VulkanAsyncCompute::BufferTransfer> drawTransfers = GetDrawTransfers(frameSlot);
+
+    std::array<VkBufferMemoryBarrier, 2> indirectBarriers{};
+    for(size_t i = 0; i < indirectBarriers.size(); i++){
+        indirectBarriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        indirectBarriers[i].srcAccessMask = drawTransfers[i].srcAccessMask;
+        indirectBarriers[i].dstAccessMask = drawTransfers[i].dstAccessMask;
+        indirectBarriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        indirectBarriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        indirectBarriers[i].buffer = drawTransfers[i].buffer;
+        indirectBarriers[i].offset = drawTransfers[i].offset;
+        indirectBarriers[i].size = drawTransfers[i].size;
+    }
+
+    //draw indirect is a valid stage on compute queues too, it is where indirect dispatches read their parameters
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0,
+                         0, nullptr, static_cast<uint32_t>(indirectBarriers.size()), indirectBarriers.data(), 0, nullptr);
+}
+
+void VulkanGpuCuller::createDrawBuffers(uint32_t framesInFlight) {
+    destroyDrawBuffers();
+    m_FramesInFlight = framesInFlight;
+
+    VkDeviceSize commandCount = static_cast<VkDeviceSize>(framesInFlight) * std::max<uint32_t>(m_InstanceCount, 1);
+    m_Allocator->CreateBuffer(commandCount * sizeof(VkDrawIndexedIndirectCommand),
+                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                              m_DrawCommandBuffer, m_DrawCommandBufferAllocation);
+
+    m_Allocator->CreateBuffer(framesInFlight * sizeof(uint32_t),
+                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                              m_DrawCountBuffer, m_DrawCountBufferAllocation);
+
+    if(m_InstanceBuffer != VK_NULL_HANDLE)
+        writeDescriptorSet();
+}
+
+void VulkanGpuCuller::destroyDrawBuffers() {
+    if(m_DrawCommandBuffer != VK_NULL_HANDLE)
+        m_Allocator->DestroyBuffer(m_DrawCommandBuffer, m_DrawCommandBufferAllocation);
+    if(m_DrawCountBuffer != VK_NULL_HANDLE)
+        m_Allocator->DestroyBuffer(m_DrawCountBuffer, m_DrawCountBufferAllocation);
+}
+
+void VulkanGpuCuller::writeDescriptorSet() {
+    std::array<VkDescriptorBufferInfo, 3> bufferInfos{};
+    bufferInfos[0] = {m_InstanceBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[1] = {m_DrawCommandBuffer, 0, VK_WHOLE_SIZE};
+    bufferInfos[2] = {m_DrawCountBuffer, 0, VK_WHOLE_SIZE};
+
+    std::array<VkWriteDescriptorSet, 3> writeDescriptorSets{};
+    for(uint32_t i = 0; i < writeDescriptorSets.size(); i++){
+        writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeDescriptorSets[i].dstSet = m_DescriptorSet;
+        writeDescriptorSets[i].dstBinding = i;
+        writeDescriptorSets[i].descriptorCount = 1;
+        writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writeDescriptorSets[i].pBufferInfo = &bufferInfos[i];
+    }
+
+    vkUpdateDescriptorSets(m_Device, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+}
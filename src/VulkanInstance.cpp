@@ -14,7 +14,7 @@ void VulkanInstance::Create() {
     applicationInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     applicationInfo.pEngineName = m_EngineName.c_str();
     applicationInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    applicationInfo.apiVersion = VK_API_VERSION_1_0;
+    applicationInfo.apiVersion = m_ApiVersion;
     applicationInfo.pNext = nullptr;
 
     VkInstanceCreateInfo instanceCreateInfo{};
@@ -54,6 +54,10 @@ void VulkanInstance::SetEngineName(const std::string &name) {
     m_EngineName = name;
 }
 
+void VulkanInstance::SetApiVersion(uint32_t apiVersion) {
+    m_ApiVersion = apiVersion;
+}
+
 bool VulkanInstance::checkValidationLayersSupport() {
     uint32_t layerCount = 0;
     vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
@@ -0,0 +1,389 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanMemoryAllocator.h"
+
+#include <algorithm>
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static uint32_t log2Ceil(VkDeviceSize value) {
+    uint32_t result = 0;
+    while((VkDeviceSize(1) << result) < value)
+        result++;
+    return result;
+}
+
+VulkanMemoryBlock::VulkanMemoryBlock(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, void* mappedData)
+    : Memory(memory), Size(size), MemoryTypeIndex(memoryTypeIndex), MappedData(mappedData) {
+    uint32_t maxOrder = log2Ceil(size) - MIN_ORDER;
+
+    m_FreeLists.resize(maxOrder + 1);
+    m_FreeLists[maxOrder].insert(0);
+}
+
+bool VulkanMemoryBlock::Allocate(VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation& allocation) {
+    //buddy of order k is always aligned to its own size inside the block
+    VkDeviceSize requiredSize = std::max({size, alignment, orderSize(0)});
+    uint32_t order = log2Ceil(requiredSize) - MIN_ORDER;
+
+    if(order >= m_FreeLists.size())
+        return false;
+
+    uint32_t freeOrder = order;
+    while(freeOrder < m_FreeLists.size() && m_FreeLists[freeOrder].empty())
+        freeOrder++;
+
+    if(freeOrder == m_FreeLists.size())
+        return false;
+
+    VkDeviceSize offset = *m_FreeLists[freeOrder].begin();
+    m_FreeLists[freeOrder].erase(m_FreeLists[freeOrder].begin());
+
+    //split until the buddy has the requested order, upper halves go back to free lists
+    while(freeOrder > order){
+        freeOrder--;
+        m_FreeLists[freeOrder].insert(offset + orderSize(freeOrder));
+    }
+
+    m_UsedSize += orderSize(order);
+
+    allocation.Memory = Memory;
+    allocation.Offset = offset;
+    allocation.Size = size;
+    allocation.MappedData = MappedData ? static_cast<char*>(MappedData) + offset : nullptr;
+    allocation.Block = this;
+    allocation.Order = order;
+
+    return true;
+}
+
+void VulkanMemoryBlock::Free(const VulkanAllocation& allocation) {
+    VkDeviceSize offset = allocation.Offset;
+    uint32_t order = allocation.Order;
+
+    m_UsedSize -= orderSize(order);
+
+    //merge with free buddies as far as possible
+    while(order + 1 < m_FreeLists.size()){
+        VkDeviceSize buddy = offset ^ orderSize(order);
+
+        auto it = m_FreeLists[order].find(buddy);
+        if(it == m_FreeLists[order].end())
+            break;
+
+        m_FreeLists[order].erase(it);
+        offset = std::min(offset, buddy);
+        order++;
+    }
+
+    m_FreeLists[order].insert(offset);
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    for(auto& pool : m_Pools)
+        for(auto& block : pool.blocks)
+            freeDeviceMemory(block.get());
+
+    for(auto& block : m_DedicatedBlocks)
+        freeDeviceMemory(block.get());
+}
+
+void VulkanMemoryAllocator::Create(VkPhysicalDevice physicalDevice, VkDevice device) {
+    m_Device = device;
+
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_MemoryProperties);
+
+    m_MaxMemoryAllocationCount = physicalDeviceProperties.limits.maxMemoryAllocationCount;
+
+    m_Pools.resize(m_MemoryProperties.memoryTypeCount * 2);
+    m_HeapStatistics.resize(m_MemoryProperties.memoryHeapCount);
+
+    for(uint32_t i = 0; i < m_MemoryProperties.memoryHeapCount; i++)
+        m_HeapStatistics[i].heapSize = m_MemoryProperties.memoryHeaps[i].size;
+}
+
+VulkanAllocation VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& memoryRequirements,
+                                                 VkMemoryPropertyFlags properties, ResourceType resourceType) {
+    uint32_t memoryTypeIndex = FindMemoryType(memoryRequirements.memoryTypeBits, properties);
+    VkDeviceSize blockSize = blockSizeForType(memoryTypeIndex);
+
+    //big resources would waste most of a shared block
+    if(memoryRequirements.size > blockSize / 2)
+        return AllocateDedicated(memoryRequirements.size, memoryTypeIndex);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    VulkanAllocation allocation{};
+    allocation.MemoryTypeIndex = memoryTypeIndex;
+
+    HeapStatistics& heapStatistics = m_HeapStatistics[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+    uint32_t memoryPoolIndex = poolIndex(memoryTypeIndex, resourceType);
+    Pool& memoryPool = m_Pools[memoryPoolIndex];
+
+    for(auto& block : memoryPool.blocks){
+        if(block->Allocate(memoryRequirements.size, memoryRequirements.alignment, allocation)){
+            heapStatistics.usedBytes += allocation.Size;
+            heapStatistics.allocationCount++;
+            return allocation;
+        }
+    }
+
+    void* mappedData = nullptr;
+    VkDeviceMemory memory = allocateDeviceMemory(blockSize, memoryTypeIndex, &mappedData);
+    memoryPool.blocks.push_back(std::make_unique<VulkanMemoryBlock>(memory, blockSize, memoryTypeIndex, mappedData));
+    memoryPool.blocks.back()->PoolIndex = memoryPoolIndex;
+
+    if(!memoryPool.blocks.back()->Allocate(memoryRequirements.size, memoryRequirements.alignment, allocation))
+        throw std::runtime_error("VulkanMemoryAllocator::Allocate() -> Allocation does not fit in a new block!");
+
+    heapStatistics.usedBytes += allocation.Size;
+    heapStatistics.allocationCount++;
+
+    return allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    void* mappedData = nullptr;
+    VkDeviceMemory memory = allocateDeviceMemory(size, memoryTypeIndex, &mappedData);
+
+    m_DedicatedBlocks.push_back(std::make_unique<VulkanMemoryBlock>(memory, size, memoryTypeIndex, mappedData));
+
+    VulkanAllocation allocation{};
+    allocation.Memory = memory;
+    allocation.Offset = 0;
+    allocation.Size = size;
+    allocation.MemoryTypeIndex = memoryTypeIndex;
+    allocation.MappedData = mappedData;
+    allocation.Block = m_DedicatedBlocks.back().get();
+
+    HeapStatistics& heapStatistics = m_HeapStatistics[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+    heapStatistics.usedBytes += size;
+    heapStatistics.allocationCount++;
+
+    return allocation;
+}
+
+void VulkanMemoryAllocator::Free(VulkanAllocation& allocation) {
+    if(allocation.Block == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    HeapStatistics& heapStatistics = m_HeapStatistics[m_MemoryProperties.memoryTypes[allocation.MemoryTypeIndex].heapIndex];
+    heapStatistics.usedBytes -= allocation.Size;
+    heapStatistics.allocationCount--;
+
+    VulkanMemoryBlock* block = allocation.Block;
+
+    if(block->PoolIndex == UINT32_MAX){
+        auto it = std::find_if(m_DedicatedBlocks.begin(), m_DedicatedBlocks.end(),
+                               [block](const auto& dedicatedBlock){ return dedicatedBlock.get() == block; });
+        freeDeviceMemory(block);
+        m_DedicatedBlocks.erase(it);
+    }
+    else {
+        block->Free(allocation);
+
+        //keep one empty block per pool around, release the rest back to the driver
+        auto& blocks = m_Pools[block->PoolIndex].blocks;
+        if(block->IsEmpty() && std::count_if(blocks.begin(), blocks.end(), [](const auto& poolBlock){ return poolBlock->IsEmpty(); }) > 1){
+            auto it = std::find_if(blocks.begin(), blocks.end(), [block](const auto& poolBlock){ return poolBlock.get() == block; });
+            freeDeviceMemory(block);
+            blocks.erase(it);
+        }
+    }
+
+    allocation = VulkanAllocation{};
+}
+
+void VulkanMemoryAllocator::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                                         VkBuffer& buffer, VulkanAllocation& allocation, const std::vector<uint32_t>& queueFamilies) {
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.size = size;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if(queueFamilies.size() > 1){
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferCreateInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+        bufferCreateInfo.pQueueFamilyIndices = queueFamilies.data();
+    }
+
+    if(vkCreateBuffer(m_Device, &bufferCreateInfo, nullptr, &buffer) != VK_SUCCESS)
+        throw std::runtime_error("VulkanMemoryAllocator::CreateBuffer() -> Failed to create buffer!");
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(m_Device, buffer, &memoryRequirements);
+
+    allocation = Allocate(memoryRequirements, properties, ResourceType::Linear);
+
+    if(vkBindBufferMemory(m_Device, buffer, allocation.Memory, allocation.Offset) != VK_SUCCESS)
+        throw std::runtime_error("VulkanMemoryAllocator::CreateBuffer() -> Failed to bind buffer memory!");
+}
+
+void VulkanMemoryAllocator::DestroyBuffer(VkBuffer& buffer, VulkanAllocation& allocation) {
+    vkDestroyBuffer(m_Device, buffer, nullptr);
+    Free(allocation);
+
+    buffer = VK_NULL_HANDLE;
+}
+
+void VulkanMemoryAllocator::CreateImage(const VkImageCreateInfo& imageCreateInfo, VkMemoryPropertyFlags properties,
+                                        VkImage& image, VulkanAllocation& allocation) {
+    if(vkCreateImage(m_Device, &imageCreateInfo, nullptr, &image) != VK_SUCCESS)
+        throw std::runtime_error("VulkanMemoryAllocator::CreateImage() -> Failed to create image!");
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(m_Device, image, &memoryRequirements);
+
+    ResourceType resourceType = imageCreateInfo.tiling == VK_IMAGE_TILING_LINEAR ? ResourceType::Linear : ResourceType::Optimal;
+    allocation = Allocate(memoryRequirements, properties, resourceType);
+
+    if(vkBindImageMemory(m_Device, image, allocation.Memory, allocation.Offset) != VK_SUCCESS)
+        throw std::runtime_error("VulkanMemoryAllocator::CreateImage() -> Failed to bind image memory!");
+}
+
+void VulkanMemoryAllocator::DestroyImage(VkImage& image, VulkanAllocation& allocation) {
+    vkDestroyImage(m_Device, image, nullptr);
+    Free(allocation);
+
+    image = VK_NULL_HANDLE;
+}
+
+uint32_t VulkanMemoryAllocator::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+    for(uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++){
+        if((typeFilter & (1 << i)) && (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            return i;
+    }
+
+    throw std::runtime_error("VulkanMemoryAllocator::FindMemoryType() -> Failed to find suitable memory type!");
+}
+
+std::vector<VulkanMemoryAllocator::HeapStatistics> VulkanMemoryAllocator::GetHeapStatistics() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_HeapStatistics;
+}
+
+void VulkanMemoryAllocator::PrintStatistics() {
+    auto heapStatistics = GetHeapStatistics();
+
+    std::cout << "Device memory allocations: " << m_DeviceMemoryCount << " / " << m_MaxMemoryAllocationCount << std::endl;
+    for(size_t i = 0; i < heapStatistics.size(); i++){
+        std::cout << "\tHeap " << i << ": "
+                  << heapStatistics[i].usedBytes / 1024 << " KiB used in "
+                  << heapStatistics[i].allocationCount << " allocations, "
+                  << heapStatistics[i].blockBytes / 1024 << " KiB in "
+                  << heapStatistics[i].blockCount << " blocks, heap size "
+                  << heapStatistics[i].heapSize / (1024 * 1024) << " MiB" << std::endl;
+    }
+}
+
+VkDeviceSize VulkanMemoryAllocator::blockSizeForType(uint32_t memoryTypeIndex) const {
+    VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+
+    //small heaps (e.g. 256 MiB BAR) get blocks of 1/8 of the heap, rounded down to a power of two
+    VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE;
+    while(blockSize > heapSize / 8 && blockSize > VkDeviceSize(1024) * 1024)
+        blockSize /= 2;
+
+    return blockSize;
+}
+
+VkDeviceMemory VulkanMemoryAllocator::allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void** mappedData) {
+    if(m_DeviceMemoryCount >= m_MaxMemoryAllocationCount)
+        throw std::runtime_error("VulkanMemoryAllocator::allocateDeviceMemory() -> maxMemoryAllocationCount reached!");
+
+    VkMemoryAllocateInfo memoryAllocateInfo{};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.allocationSize = size;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory;
+    if(vkAllocateMemory(m_Device, &memoryAllocateInfo, nullptr, &memory) != VK_SUCCESS)
+        throw std::runtime_error("VulkanMemoryAllocator::allocateDeviceMemory() -> Failed to allocate device memory!");
+
+    *mappedData = nullptr;
+    if(m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT){
+        if(vkMapMemory(m_Device, memory, 0, VK_WHOLE_SIZE, 0, mappedData) != VK_SUCCESS)
+            throw std::runtime_error("VulkanMemoryAllocator::allocateDeviceMemory() -> Failed to map device memory!");
+    }
+
+    HeapStatistics& heapStatistics = m_HeapStatistics[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+    heapStatistics.blockBytes += size;
+    heapStatistics.blockCount++;
+
+    m_DeviceMemoryCount++;
+
+    return memory;
+}
+
+void VulkanMemoryAllocator::freeDeviceMemory(VulkanMemoryBlock* block) {
+    uint32_t heapIndex = m_MemoryProperties.memoryTypes[block->MemoryTypeIndex].heapIndex;
+
+    if(block->MappedData)
+        vkUnmapMemory(m_Device, block->Memory);
+    vkFreeMemory(m_Device, block->Memory, nullptr);
+
+    m_HeapStatistics[heapIndex].blockBytes -= block->Size;
+    m_HeapStatistics[heapIndex].blockCount--;
+
+    m_DeviceMemoryCount--;
+}
+
+VulkanRingArena::VulkanRingArena(VulkanMemoryAllocator* allocator, VkDeviceSize size, VkBufferUsageFlags usage, uint32_t frameSlots,
+                                 const std::vector<uint32_t>& queueFamilies)
+    : Size(size), m_Allocator(allocator) {
+    m_Allocator->CreateBuffer(size, usage,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              Buffer, m_Allocation, queueFamilies);
+
+    m_FrameEnds.resize(frameSlots, 0);
+}
+
+VulkanRingArena::~VulkanRingArena() {
+    m_Allocator->DestroyBuffer(Buffer, m_Allocation);
+}
+
+void VulkanRingArena::BeginFrame(uint32_t frameSlot) {
+    if(m_CurrentFrameSlot != UINT32_MAX)
+        m_FrameEnds[m_CurrentFrameSlot] = m_Head;
+
+    //previous use of this slot has finished on the GPU, so has everything allocated before it
+    m_Tail = std::max(m_Tail, m_FrameEnds[frameSlot]);
+    m_CurrentFrameSlot = frameSlot;
+}
+
+bool VulkanRingArena::Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) {
+    if(size > Size)
+        return false;
+
+    VkDeviceSize position = m_Head % Size;
+    VkDeviceSize alignedPosition = alignUp(position, std::max<VkDeviceSize>(alignment, 1));
+
+    //allocations never wrap around the end, skip to the start of the next lap instead
+    VkDeviceSize start = m_Head - position + alignedPosition;
+    if(alignedPosition + size > Size)
+        start = m_Head - position + Size;
+
+    if(start + size - m_Tail > Size)
+        return false;
+
+    m_Head = start + size;
+    offset = start % Size;
+
+    return true;
+}
+
+void VulkanRingArena::Reset() {
+    m_Head = 0;
+    m_Tail = 0;
+    std::fill(m_FrameEnds.begin(), m_FrameEnds.end(), 0);
+}
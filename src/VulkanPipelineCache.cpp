@@ -0,0 +1,175 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanPipelineCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define PIPELINE_CACHE_FSYNC
+#endif
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+    if(PipelineCache != VK_NULL_HANDLE)
+        vkDestroyPipelineCache(m_Device, PipelineCache, nullptr);
+}
+
+void VulkanPipelineCache::Create(VkDevice device, VkPhysicalDevice physicalDevice) {
+    m_Device = device;
+    vkGetPhysicalDeviceProperties(physicalDevice, &m_PhysicalDeviceProperties);
+
+    std::vector<char> cacheData = loadCacheData();
+    if(!cacheData.empty() && !validateCacheHeader(cacheData)){
+        std::cerr << "VulkanPipelineCache::Create() -> Cache " << m_Path << " was created for another device or driver, ignoring it" << std::endl;
+        cacheData.clear();
+    }
+
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = cacheData.size();
+    pipelineCacheCreateInfo.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+
+    if(vkCreatePipelineCache(m_Device, &pipelineCacheCreateInfo, nullptr, &PipelineCache) == VK_SUCCESS)
+        return;
+
+    //driver rejected the blob, start with an empty cache
+    pipelineCacheCreateInfo.initialDataSize = 0;
+    pipelineCacheCreateInfo.pInitialData = nullptr;
+
+    if(vkCreatePipelineCache(m_Device, &pipelineCacheCreateInfo, nullptr, &PipelineCache) != VK_SUCCESS)
+        throw std::runtime_error("VulkanPipelineCache::Create() -> Failed to create pipeline cache!");
+}
+
+void VulkanPipelineCache::Save() {
+    if(PipelineCache == VK_NULL_HANDLE)
+        return;
+
+    size_t dataSize = 0;
+    if(vkGetPipelineCacheData(m_Device, PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+        return;
+
+    std::vector<char> cacheData(dataSize);
+    if(vkGetPipelineCacheData(m_Device, PipelineCache, &dataSize, cacheData.data()) != VK_SUCCESS)
+        return;
+    cacheData.resize(dataSize);
+
+    FileHeader fileHeader{};
+    fileHeader.magic = FILE_MAGIC;
+    fileHeader.version = FILE_VERSION;
+    fileHeader.payloadSize = dataSize;
+    fileHeader.payloadHash = hashData(cacheData.data(), dataSize);
+
+    std::string temporaryPath = m_Path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if(!file.is_open()){
+            std::cerr << "VulkanPipelineCache::Save() -> Failed to open " << temporaryPath << std::endl;
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+        file.write(cacheData.data(), (long long)dataSize);
+        file.flush();
+
+        if(!file.good()){
+            std::cerr << "VulkanPipelineCache::Save() -> Failed to write " << temporaryPath << std::endl;
+            return;
+        }
+    }
+
+    //the data has to reach the disk before the rename does, otherwise a crash can leave the new name on a truncated file
+    if(!syncFile(temporaryPath)){
+        std::cerr << "VulkanPipelineCache::Save() -> Failed to flush " << temporaryPath << std::endl;
+        std::error_code errorCode;
+        std::filesystem::remove(temporaryPath, errorCode);
+        return;
+    }
+
+    //rename is atomic, readers see either the old or the new cache but never a partial one
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, m_Path, errorCode);
+    if(errorCode){
+        std::cerr << "VulkanPipelineCache::Save() -> Failed to replace " << m_Path << ": " << errorCode.message() << std::endl;
+        std::filesystem::remove(temporaryPath, errorCode);
+    }
+}
+
+std::vector<char> VulkanPipelineCache::loadCacheData() const {
+    std::ifstream file(m_Path, std::ios::ate | std::ios::binary);
+    if(!file.is_open())
+        return {};
+
+    auto fileSize = (size_t)file.tellg();
+    if(fileSize < sizeof(FileHeader))
+        return {};
+
+    FileHeader fileHeader{};
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+
+    if(fileHeader.magic != FILE_MAGIC || fileHeader.version != FILE_VERSION ||
+       fileHeader.payloadSize != fileSize - sizeof(FileHeader)){
+        std::cerr << "VulkanPipelineCache::loadCacheData() -> " << m_Path << " is truncated or not a pipeline cache" << std::endl;
+        return {};
+    }
+
+    std::vector<char> cacheData(fileHeader.payloadSize);
+    file.read(cacheData.data(), (long long)cacheData.size());
+
+    if(!file.good() || hashData(cacheData.data(), cacheData.size()) != fileHeader.payloadHash){
+        std::cerr << "VulkanPipelineCache::loadCacheData() -> " << m_Path << " is corrupted" << std::endl;
+        return {};
+    }
+
+    return cacheData;
+}
+
+bool VulkanPipelineCache::validateCacheHeader(const std::vector<char>& data) const {
+    //VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID, pipelineCacheUUID
+    constexpr size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    if(data.size() < headerSize)
+        return false;
+
+    uint32_t header[4];
+    std::memcpy(header, data.data(), sizeof(header));
+
+    if(header[0] < headerSize || header[0] > data.size())
+        return false;
+    if(header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+        return false;
+    if(header[2] != m_PhysicalDeviceProperties.vendorID || header[3] != m_PhysicalDeviceProperties.deviceID)
+        return false;
+
+    return std::memcmp(data.data() + sizeof(header), m_PhysicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+bool VulkanPipelineCache::syncFile(const std::string& path) {
+#ifdef PIPELINE_CACHE_FSYNC
+    int fileDescriptor = open(path.c_str(), O_WRONLY);
+    if(fileDescriptor < 0)
+        return false;
+
+    bool synced = fsync(fileDescriptor) == 0;
+    close(fileDescriptor);
+    return synced;
+#else
+    //no portable way to flush a closed stream elsewhere, the checksum still rejects a truncated file
+    static_cast<void>(path);
+    return true;
+#endif
+}
+
+uint64_t VulkanPipelineCache::hashData(const char* data, size_t size) {
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for(size_t i = 0; i < size; i++){
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,475 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanPipelineRegistry.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+
+namespace {
+    void hashCombine(size_t& seed, size_t value) {
+        seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+    }
+
+    std::vector<char> loadShaderCode(const std::string& path) {
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        if(!file.is_open())
+            throw std::runtime_error("VulkanPipelineRegistry::loadShaderCode() -> Failed to open " + path + "!");
+
+        std::vector<char> code(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(code.data(), static_cast<std::streamsize>(code.size()));
+
+        return code;
+    }
+
+    ///@brief create infos of one pipeline, kept alive until the batch create call
+    struct PipelineState {
+        std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+        VkPipelineVertexInputStateCreateInfo vertexInputState{};
+        VkPipelineInputAssemblyStateCreateInfo inputAssemblyState{};
+        VkPipelineViewportStateCreateInfo viewportState{};
+        VkPipelineRasterizationStateCreateInfo rasterizationState{};
+        VkPipelineMultisampleStateCreateInfo multisampleState{};
+        VkPipelineDepthStencilStateCreateInfo depthStencilState{};
+        VkPipelineColorBlendAttachmentState colorBlendAttachmentState{};
+        VkPipelineColorBlendStateCreateInfo colorBlendState{};
+    };
+
+    const std::array<VkDynamicState, 2> DYNAMIC_STATES = {
+            VK_DYNAMIC_STATE_VIEWPORT,
+            VK_DYNAMIC_STATE_SCISSOR
+    };
+}
+
+bool PipelineDescription::operator==(const PipelineDescription& other) const {
+    auto bindingsEqual = [](const VkVertexInputBindingDescription& a, const VkVertexInputBindingDescription& b){
+        return a.binding == b.binding && a.stride == b.stride && a.inputRate == b.inputRate;
+    };
+    auto attributesEqual = [](const VkVertexInputAttributeDescription& a, const VkVertexInputAttributeDescription& b){
+        return a.location == b.location && a.binding == b.binding && a.format == b.format && a.offset == b.offset;
+    };
+
+    return vertexShader == other.vertexShader && fragmentShader == other.fragmentShader &&
+           std::equal(vertexBindings.begin(), vertexBindings.end(), other.vertexBindings.begin(), other.vertexBindings.end(), bindingsEqual) &&
+           std::equal(vertexAttributes.begin(), vertexAttributes.end(), other.vertexAttributes.begin(), other.vertexAttributes.end(), attributesEqual) &&
+           topology == other.topology && polygonMode == other.polygonMode && cullMode == other.cullMode &&
+           frontFace == other.frontFace && samples == other.samples &&
+           depthTest == other.depthTest && depthWrite == other.depthWrite && depthCompareOp == other.depthCompareOp &&
+           alphaBlend == other.alphaBlend && renderPass == other.renderPass && subpass == other.subpass && layout == other.layout;
+}
+
+size_t PipelineDescription::Hash() const {
+    size_t seed = 0;
+    hashCombine(seed, std::hash<std::string>{}(vertexShader));
+    hashCombine(seed, std::hash<std::string>{}(fragmentShader));
+
+    for(const auto& binding : vertexBindings){
+        hashCombine(seed, binding.binding);
+        hashCombine(seed, binding.stride);
+        hashCombine(seed, binding.inputRate);
+    }
+    for(const auto& attribute : vertexAttributes){
+        hashCombine(seed, attribute.location);
+        hashCombine(seed, attribute.binding);
+        hashCombine(seed, attribute.format);
+        hashCombine(seed, attribute.offset);
+    }
+
+    hashCombine(seed, topology);
+    hashCombine(seed, polygonMode);
+    hashCombine(seed, cullMode);
+    hashCombine(seed, frontFace);
+    hashCombine(seed, samples);
+    hashCombine(seed, (depthTest ? 1u : 0u) | (depthWrite ? 2u : 0u) | (alphaBlend ? 4u : 0u));
+    hashCombine(seed, depthCompareOp);
+    hashCombine(seed, std::hash<VkRenderPass>{}(renderPass));
+    hashCombine(seed, subpass);
+    hashCombine(seed, std::hash<VkPipelineLayout>{}(layout));
+
+    return seed;
+}
+
+VulkanPipelineRegistry::~VulkanPipelineRegistry() {
+    //running batches reference the registry
+    WaitIdle();
+
+    for(auto& entry : m_Entries)
+        vkDestroyPipeline(m_Device, entry.pipeline, nullptr);
+}
+
+void VulkanPipelineRegistry::Create(VkDevice device, VkPipelineCache pipelineCache) {
+    m_Device = device;
+    m_PipelineCache = pipelineCache;
+}
+
+VulkanPipelineRegistry::PipelineHandle VulkanPipelineRegistry::Request(const PipelineDescription& pipelineDescription) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto found = m_Lookup.find(pipelineDescription);
+    if(found != m_Lookup.end())
+        return found->second;
+
+    auto handle = static_cast<PipelineHandle>(m_Entries.size());
+    m_Entries.push_back({pipelineDescription, VK_NULL_HANDLE});
+    m_Lookup.emplace(pipelineDescription, handle);
+
+    return handle;
+}
+
+VkResult VulkanPipelineRegistry::Flush() {
+    std::vector<PipelineHandle> handles;
+    std::vector<PipelineDescription> descriptions;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for(PipelineHandle handle = 0; handle < m_Entries.size(); handle++){
+            if(m_Entries[handle].pipeline != VK_NULL_HANDLE || m_Entries[handle].compiling)
+                continue;
+
+            handles.push_back(handle);
+            descriptions.push_back(m_Entries[handle].description);
+        }
+    }
+
+    if(handles.empty())
+        return VK_SUCCESS;
+
+    std::vector<VkPipeline> pipelines;
+    VkResult result = createPipelines(descriptions, pipelines);
+    if(result != VK_SUCCESS)
+        return result;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(size_t i = 0; i < handles.size(); i++)
+        m_Entries[handles[i]].pipeline = pipelines[i];
+
+    return VK_SUCCESS;
+}
+
+void VulkanPipelineRegistry::CompileAsync(ThreadPool* threadPool) {
+    std::vector<PipelineHandle> handles;
+    std::vector<PipelineDescription> descriptions;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for(PipelineHandle handle = 0; handle < m_Entries.size(); handle++){
+            if(m_Entries[handle].pipeline != VK_NULL_HANDLE || m_Entries[handle].compiling)
+                continue;
+
+            m_Entries[handle].compiling = true;
+            handles.push_back(handle);
+            descriptions.push_back(m_Entries[handle].description);
+        }
+    }
+
+    if(handles.empty())
+        return;
+
+    //one batch per worker, drivers compile a batch on the calling thread, so more batches would only queue up
+    const size_t batchCount = std::min<size_t>(threadPool->GetThreadCount(), handles.size());
+    const size_t batchSize = (handles.size() + batchCount - 1) / batchCount;
+
+    for(size_t first = 0; first < handles.size(); first += batchSize){
+        size_t last = std::min(first + batchSize, handles.size());
+
+        std::vector<PipelineHandle> batchHandles(handles.begin() + static_cast<std::ptrdiff_t>(first), handles.begin() + static_cast<std::ptrdiff_t>(last));
+        std::vector<PipelineDescription> batchDescriptions(descriptions.begin() + static_cast<std::ptrdiff_t>(first), descriptions.begin() + static_cast<std::ptrdiff_t>(last));
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_RunningBatches++;
+        }
+
+        threadPool->Submit([this, batchHandles = std::move(batchHandles), batchDescriptions = std::move(batchDescriptions)]{
+            std::vector<VkPipeline> pipelines;
+            VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+            try{
+                result = createPipelines(batchDescriptions, pipelines);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(result == VK_SUCCESS){
+                for(size_t i = 0; i < batchHandles.size(); i++)
+                    m_Compiled.emplace_back(batchHandles[i], pipelines[i]);
+            }
+            else {
+                std::cerr << "VulkanPipelineRegistry::CompileAsync() -> Failed to create " << batchHandles.size() << " pipelines!" << std::endl;
+                m_Failed.insert(m_Failed.end(), batchHandles.begin(), batchHandles.end());
+            }
+
+            m_RunningBatches--;
+            m_BatchesFinished.notify_all();
+        });
+    }
+}
+
+uint32_t VulkanPipelineRegistry::CollectCompiled() {
+    std::vector<std::pair<PipelineHandle, VkPipeline>> stalePipelines;
+    std::vector<PipelineDescription> staleDescriptions;
+    uint32_t collected = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        for(const auto& [handle, pipeline] : m_Compiled){
+            Entry& entry = m_Entries[handle];
+            entry.compiling = false;
+
+            //built from shaders a hot reload replaced while the batch was running
+            if(entry.stale){
+                entry.stale = false;
+                stalePipelines.emplace_back(handle, pipeline);
+                staleDescriptions.push_back(entry.description);
+                continue;
+            }
+
+            entry.pipeline = pipeline;
+            collected++;
+        }
+        for(PipelineHandle handle : m_Failed){
+            m_Entries[handle].compiling = false;
+            m_Entries[handle].stale = false;
+        }
+
+        m_Compiled.clear();
+        m_Failed.clear();
+    }
+
+    if(stalePipelines.empty())
+        return collected;
+
+    //rebuilt outside of the lock, the shader watcher may be creating replacements at the same time
+    std::vector<VkPipeline> pipelines;
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+    try{
+        result = createPipelines(staleDescriptions, pipelines);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    //a failed rebuild leaves the old shaders running rather than no pipeline at all
+    if(result != VK_SUCCESS)
+        std::cerr << "VulkanPipelineRegistry::CollectCompiled() -> Failed to rebuild " << stalePipelines.size() << " pipelines after a reload!" << std::endl;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(size_t i = 0; i < stalePipelines.size(); i++){
+        auto [handle, pipeline] = stalePipelines[i];
+        if(result == VK_SUCCESS){
+            //never bound, nothing can still be using it
+            vkDestroyPipeline(m_Device, pipeline, nullptr);
+            pipeline = pipelines[i];
+        }
+
+        m_Entries[handle].pipeline = pipeline;
+        collected++;
+    }
+
+    return collected;
+}
+
+void VulkanPipelineRegistry::WaitIdle() {
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_BatchesFinished.wait(lock, [this]{ return m_RunningBatches == 0; });
+    }
+
+    CollectCompiled();
+}
+
+bool VulkanPipelineRegistry::IsCompiling() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_RunningBatches > 0 || !m_Compiled.empty() || !m_Failed.empty();
+}
+
+uint32_t VulkanPipelineRegistry::GetReadyPipelineCount() const {
+    return static_cast<uint32_t>(std::count_if(m_Entries.begin(), m_Entries.end(), [](const Entry& entry){
+        return entry.pipeline != VK_NULL_HANDLE;
+    }));
+}
+
+std::vector<std::pair<VulkanPipelineRegistry::PipelineHandle, VkPipeline>> VulkanPipelineRegistry::CreateReplacements(const std::vector<std::string>& shaderPaths) {
+    std::vector<PipelineHandle> handles;
+    std::vector<PipelineDescription> descriptions;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for(PipelineHandle handle = 0; handle < m_Entries.size(); handle++){
+            const auto& description = m_Entries[handle].description;
+            bool usesShader = std::any_of(shaderPaths.begin(), shaderPaths.end(), [&description](const std::string& shaderPath){
+                return description.vertexShader == shaderPath || description.fragmentShader == shaderPath;
+            });
+
+            if(!usesShader)
+                continue;
+
+            //a running batch already loaded the old binary, CollectCompiled() rebuilds its pipeline,
+            //pipelines not handed to a batch yet pick the new binary up on their own
+            if(m_Entries[handle].compiling)
+                m_Entries[handle].stale = true;
+            else if(m_Entries[handle].pipeline != VK_NULL_HANDLE){
+                handles.push_back(handle);
+                descriptions.push_back(description);
+            }
+        }
+    }
+
+    std::vector<std::pair<PipelineHandle, VkPipeline>> replacements;
+    if(handles.empty())
+        return replacements;
+
+    std::vector<VkPipeline> pipelines;
+    if(createPipelines(descriptions, pipelines) != VK_SUCCESS)
+        throw std::runtime_error("VulkanPipelineRegistry::CreateReplacements() -> Failed to create pipelines!");
+
+    for(size_t i = 0; i < handles.size(); i++)
+        replacements.emplace_back(handles[i], pipelines[i]);
+
+    return replacements;
+}
+
+VkPipeline VulkanPipelineRegistry::Replace(PipelineHandle handle, VkPipeline pipeline) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return std::exchange(m_Entries.at(handle).pipeline, pipeline);
+}
+
+VkResult VulkanPipelineRegistry::createPipelines(const std::vector<PipelineDescription>& descriptions, std::vector<VkPipeline>& pipelines) {
+    //pipelines of a batch usually share shaders, every binary is loaded and turned into a module once
+    std::map<std::string, VkShaderModule> shaderModules;
+    auto getShaderModule = [this, &shaderModules](const std::string& path){
+        auto found = shaderModules.find(path);
+        if(found != shaderModules.end())
+            return found->second;
+
+        auto shaderCode = loadShaderCode(path);
+
+        VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+        shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        shaderModuleCreateInfo.codeSize = shaderCode.size();
+        shaderModuleCreateInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+
+        VkShaderModule shaderModule = VK_NULL_HANDLE;
+        if(vkCreateShaderModule(m_Device, &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS)
+            throw std::runtime_error("VulkanPipelineRegistry::createPipelines() -> Failed to create shader module for " + path + "!");
+
+        shaderModules.emplace(path, shaderModule);
+        return shaderModule;
+    };
+
+    auto destroyShaderModules = [this, &shaderModules](){
+        for(auto& [path, shaderModule] : shaderModules)
+            vkDestroyShaderModule(m_Device, shaderModule, nullptr);
+    };
+
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(DYNAMIC_STATES.size());
+    dynamicState.pDynamicStates = DYNAMIC_STATES.data();
+
+    //sized up front, create infos point into the states
+    std::vector<PipelineState> states(descriptions.size());
+    std::vector<VkGraphicsPipelineCreateInfo> createInfos(descriptions.size());
+
+    try{
+        for(size_t i = 0; i < descriptions.size(); i++){
+            const PipelineDescription& description = descriptions[i];
+            PipelineState& state = states[i];
+
+            state.shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            state.shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+            state.shaderStages[0].module = getShaderModule(description.vertexShader);
+            state.shaderStages[0].pName = "main";
+
+            state.shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            state.shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+            state.shaderStages[1].module = getShaderModule(description.fragmentShader);
+            state.shaderStages[1].pName = "main";
+
+            state.vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+            state.vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(description.vertexBindings.size());
+            state.vertexInputState.pVertexBindingDescriptions = description.vertexBindings.data();
+            state.vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(description.vertexAttributes.size());
+            state.vertexInputState.pVertexAttributeDescriptions = description.vertexAttributes.data();
+
+            state.inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+            state.inputAssemblyState.topology = description.topology;
+            state.inputAssemblyState.primitiveRestartEnable = VK_FALSE;
+
+            state.viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+            state.viewportState.viewportCount = 1;
+            state.viewportState.scissorCount = 1;
+
+            state.rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+            state.rasterizationState.depthClampEnable = VK_FALSE;
+            state.rasterizationState.rasterizerDiscardEnable = VK_FALSE;
+            state.rasterizationState.polygonMode = description.polygonMode;
+            state.rasterizationState.cullMode = description.cullMode;
+            state.rasterizationState.frontFace = description.frontFace;
+            state.rasterizationState.lineWidth = 1.0f;
+            state.rasterizationState.depthBiasEnable = VK_FALSE;
+
+            state.multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+            state.multisampleState.sampleShadingEnable = VK_FALSE;
+            state.multisampleState.rasterizationSamples = description.samples;
+            state.multisampleState.minSampleShading = 1.0f;
+
+            state.depthStencilState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+            state.depthStencilState.depthTestEnable = description.depthTest ? VK_TRUE : VK_FALSE;
+            state.depthStencilState.depthWriteEnable = description.depthWrite ? VK_TRUE : VK_FALSE;
+            state.depthStencilState.depthCompareOp = description.depthCompareOp;
+            state.depthStencilState.depthBoundsTestEnable = VK_FALSE;
+            state.depthStencilState.stencilTestEnable = VK_FALSE;
+
+            state.colorBlendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+            state.colorBlendAttachmentState.blendEnable = description.alphaBlend ? VK_TRUE : VK_FALSE;
+            state.colorBlendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            state.colorBlendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            state.colorBlendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
+            state.colorBlendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            state.colorBlendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+            state.colorBlendAttachmentState.alphaBlendOp = VK_BLEND_OP_ADD;
+
+            state.colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+            state.colorBlendState.logicOpEnable = VK_FALSE;
+            state.colorBlendState.attachmentCount = 1;
+            state.colorBlendState.pAttachments = &state.colorBlendAttachmentState;
+
+            VkGraphicsPipelineCreateInfo& createInfo = createInfos[i];
+            createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+            createInfo.stageCount = static_cast<uint32_t>(state.shaderStages.size());
+            createInfo.pStages = state.shaderStages.data();
+            createInfo.pVertexInputState = &state.vertexInputState;
+            createInfo.pInputAssemblyState = &state.inputAssemblyState;
+            createInfo.pViewportState = &state.viewportState;
+            createInfo.pRasterizationState = &state.rasterizationState;
+            createInfo.pMultisampleState = &state.multisampleState;
+            createInfo.pDepthStencilState = &state.depthStencilState;
+            createInfo.pColorBlendState = &state.colorBlendState;
+            createInfo.pDynamicState = &dynamicState;
+            createInfo.layout = description.layout;
+            createInfo.renderPass = description.renderPass;
+            createInfo.subpass = description.subpass;
+        }
+    } catch (...) {
+        destroyShaderModules();
+        throw;
+    }
+
+    pipelines.assign(descriptions.size(), VK_NULL_HANDLE);
+    VkResult result = vkCreateGraphicsPipelines(m_Device, m_PipelineCache, static_cast<uint32_t>(createInfos.size()),
+                                                createInfos.data(), nullptr, pipelines.data());
+
+    destroyShaderModules();
+
+    //a failed batch may still have created some of the pipelines
+    if(result != VK_SUCCESS){
+        for(auto& pipeline : pipelines)
+            vkDestroyPipeline(m_Device, pipeline, nullptr);
+        pipelines.clear();
+    }
+
+    return result;
+}
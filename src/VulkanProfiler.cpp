@@ -0,0 +1,288 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+VulkanProfiler::CpuScope::CpuScope(VulkanProfiler* profiler, const char* name)
+    : m_Profiler(profiler), m_Name(name), m_StartUs(profiler->GetTimeUs()) {}
+
+VulkanProfiler::CpuScope::~CpuScope() {
+    m_Profiler->addCpuScope(m_Name, m_StartUs, m_Profiler->GetTimeUs());
+}
+
+VulkanProfiler::GpuScope::GpuScope(VulkanProfiler* profiler, VkCommandBuffer commandBuffer, const char* name)
+    : m_Profiler(profiler), m_CommandBuffer(commandBuffer), m_ScopeIndex(profiler->beginGpuScope(commandBuffer, name)) {}
+
+VulkanProfiler::GpuScope::~GpuScope() {
+    m_Profiler->endGpuScope(m_CommandBuffer, m_ScopeIndex);
+}
+
+VulkanProfiler::~VulkanProfiler() {
+    if(m_QueryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(m_Device, m_QueryPool, nullptr);
+}
+
+void VulkanProfiler::Create(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamilyIndex, uint32_t framesInFlight) {
+    m_Device = device;
+    m_Epoch = std::chrono::steady_clock::now();
+
+    m_History.resize(m_HistorySize);
+
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+    uint32_t queueFamiliesCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamiliesCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamiliesProperties(queueFamiliesCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamiliesCount, queueFamiliesProperties.data());
+
+    uint32_t timestampValidBits = queueFamiliesProperties[queueFamilyIndex].timestampValidBits;
+    if(timestampValidBits == 0)
+        std::cerr << "VulkanProfiler::Create() -> Queue family " << queueFamilyIndex << " does not support timestamps, GPU scopes are disabled" << std::endl;
+
+    m_GpuTimingSupported = timestampValidBits != 0;
+    m_TimestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+    m_TimestampMask = timestampValidBits >= 64 ? ~0ULL : (1ULL << timestampValidBits) - 1;
+
+    SetFramesInFlight(framesInFlight);
+}
+
+void VulkanProfiler::SetFramesInFlight(uint32_t framesInFlight) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    //device is idle, keep results of frames which were already submitted
+    completeSubmittedFrames();
+
+    m_GpuFrames.assign(framesInFlight, GpuFrame{});
+    m_CurrentFrameIndex = 0;
+
+    if(!m_GpuTimingSupported)
+        return;
+
+    if(m_QueryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(m_Device, m_QueryPool, nullptr);
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo{};
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = framesInFlight * m_MaxGpuScopesPerFrame * 2;
+
+    if(vkCreateQueryPool(m_Device, &queryPoolCreateInfo, nullptr, &m_QueryPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanProfiler::SetFramesInFlight() -> Failed to create timestamp query pool!");
+}
+
+void VulkanProfiler::BeginFrame(uint32_t frameIndex) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_FrameNumber++;
+    FrameRecord& frameRecord = m_History[m_FrameNumber % m_HistorySize];
+    frameRecord.frameNumber = m_FrameNumber;
+    frameRecord.beginUs = GetTimeUs();
+    frameRecord.cpuScopes.clear();
+    frameRecord.gpuScopes.clear();
+    frameRecord.counters.clear();
+    frameRecord.submitUs = 0.0;
+
+    m_CurrentFrameIndex = frameIndex;
+}
+
+void VulkanProfiler::BeginCommandBuffer(VkCommandBuffer commandBuffer) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    GpuFrame& gpuFrame = m_GpuFrames[m_CurrentFrameIndex];
+    completeFrame(gpuFrame, m_CurrentFrameIndex);
+
+    gpuFrame.frameNumber = m_FrameNumber;
+    gpuFrame.scopeNames.clear();
+    gpuFrame.submitted = false;
+
+    if(m_GpuTimingSupported)
+        vkCmdResetQueryPool(commandBuffer, m_QueryPool, m_CurrentFrameIndex * m_MaxGpuScopesPerFrame * 2, m_MaxGpuScopesPerFrame * 2);
+}
+
+void VulkanProfiler::MarkSubmit() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_GpuFrames[m_CurrentFrameIndex].submitted = true;
+    if(FrameRecord* frameRecord = findRecord(m_FrameNumber))
+        frameRecord->submitUs = GetTimeUs();
+}
+
+void VulkanProfiler::SetCounter(const char* name, double value) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if(FrameRecord* frameRecord = findRecord(m_FrameNumber))
+        frameRecord->counters.push_back({name, GetTimeUs(), value});
+}
+
+void VulkanProfiler::SetFrameCallback(FrameCallback frameCallback) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_FrameCallback = std::move(frameCallback);
+}
+
+void VulkanProfiler::Flush() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    completeSubmittedFrames();
+}
+
+void VulkanProfiler::WriteChromeTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    //device is idle, pick up frames which were submitted but not collected yet
+    completeSubmittedFrames();
+
+    std::ofstream file(path, std::ios::trunc);
+    if(!file.is_open()){
+        std::cerr << "VulkanProfiler::WriteChromeTrace() -> Failed to open " << path << std::endl;
+        return;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+    auto writeScope = [&file](const Scope& scope, uint32_t pid, uint64_t frameNumber){
+        file << ",\n{\"name\":\"" << scope.name << "\",\"ph\":\"X\",\"pid\":" << pid
+             << ",\"tid\":" << scope.threadIndex
+             << ",\"ts\":" << scope.startUs << ",\"dur\":" << scope.durationUs
+             << ",\"args\":{\"frame\":" << frameNumber << "}}";
+    };
+
+    file.setf(std::ios::fixed);
+    file.precision(3);
+
+    //oldest frame first, the ring slot of a frame is frameNumber % historySize
+    uint64_t firstFrame = m_FrameNumber >= m_HistorySize ? m_FrameNumber - m_HistorySize + 1 : 1;
+    for(uint64_t frameNumber = firstFrame; frameNumber <= m_FrameNumber; frameNumber++){
+        const FrameRecord* frameRecord = findRecord(frameNumber);
+        if(frameRecord == nullptr)
+            continue;
+
+        for(const auto& scope : frameRecord->cpuScopes)
+            writeScope(scope, 0, frameNumber);
+        for(const auto& scope : frameRecord->gpuScopes)
+            writeScope(scope, 1, frameNumber);
+        for(const auto& counter : frameRecord->counters)
+            file << ",\n{\"name\":\"" << counter.name << "\",\"ph\":\"C\",\"pid\":0,\"ts\":" << counter.timeUs
+                 << ",\"args\":{\"value\":" << counter.value << "}}";
+    }
+
+    file << "\n]}\n";
+}
+
+double VulkanProfiler::GetTimeUs() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_Epoch).count();
+}
+
+uint32_t VulkanProfiler::beginGpuScope(VkCommandBuffer commandBuffer, const char* name) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    GpuFrame& gpuFrame = m_GpuFrames[m_CurrentFrameIndex];
+    if(!m_GpuTimingSupported || gpuFrame.scopeNames.size() >= m_MaxGpuScopesPerFrame)
+        return UINT32_MAX;
+
+    uint32_t scopeIndex = static_cast<uint32_t>(gpuFrame.scopeNames.size());
+    gpuFrame.scopeNames.push_back(name);
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_QueryPool,
+                        (m_CurrentFrameIndex * m_MaxGpuScopesPerFrame + scopeIndex) * 2);
+    return scopeIndex;
+}
+
+void VulkanProfiler::endGpuScope(VkCommandBuffer commandBuffer, uint32_t scopeIndex) {
+    if(scopeIndex == UINT32_MAX)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_QueryPool,
+                        (m_CurrentFrameIndex * m_MaxGpuScopesPerFrame + scopeIndex) * 2 + 1);
+}
+
+void VulkanProfiler::addCpuScope(const char* name, double startUs, double endUs) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if(FrameRecord* frameRecord = findRecord(m_FrameNumber))
+        frameRecord->cpuScopes.push_back({name, startUs, endUs - startUs, threadIndex()});
+}
+
+void VulkanProfiler::collectGpuScopes(GpuFrame& gpuFrame, uint32_t frameIndex) {
+    FrameRecord* frameRecord = findRecord(gpuFrame.frameNumber);
+    if(frameRecord == nullptr)
+        return;
+
+    uint32_t queryCount = static_cast<uint32_t>(gpuFrame.scopeNames.size()) * 2;
+    std::vector<uint64_t> timestamps(queryCount);
+
+    //the slot fence was already waited on, results are available without VK_QUERY_RESULT_WAIT_BIT
+    VkResult result = vkGetQueryPoolResults(m_Device, m_QueryPool, frameIndex * m_MaxGpuScopesPerFrame * 2, queryCount,
+                                            timestamps.size() * sizeof(uint64_t), timestamps.data(),
+                                            sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if(result != VK_SUCCESS)
+        return;
+
+    for(auto& timestamp : timestamps)
+        timestamp &= m_TimestampMask;
+
+    //GPU and CPU clocks are not calibrated, the earliest timestamp of the frame is placed at submit time
+    uint64_t frameBegin = timestamps[0];
+    for(size_t i = 0; i < timestamps.size(); i += 2)
+        frameBegin = std::min(frameBegin, timestamps[i]);
+
+    for(size_t i = 0; i < gpuFrame.scopeNames.size(); i++){
+        uint64_t begin = timestamps[i * 2];
+        uint64_t end = std::max(begin, timestamps[i * 2 + 1]);
+
+        double startUs = static_cast<double>(begin - frameBegin) * m_TimestampPeriod / 1000.0;
+        double durationUs = static_cast<double>(end - begin) * m_TimestampPeriod / 1000.0;
+
+        frameRecord->gpuScopes.push_back({gpuFrame.scopeNames[i], frameRecord->submitUs + startUs, durationUs, 0});
+    }
+}
+
+void VulkanProfiler::completeFrame(GpuFrame& gpuFrame, uint32_t frameIndex) {
+    if(!gpuFrame.submitted)
+        return;
+    gpuFrame.submitted = false;
+
+    if(m_GpuTimingSupported && !gpuFrame.scopeNames.empty())
+        collectGpuScopes(gpuFrame, frameIndex);
+
+    const FrameRecord* frameRecord = findRecord(gpuFrame.frameNumber);
+    if(m_FrameCallback && frameRecord != nullptr)
+        m_FrameCallback(*frameRecord);
+}
+
+void VulkanProfiler::completeSubmittedFrames() {
+    std::vector<uint32_t> frameIndices;
+    for(uint32_t frameIndex = 0; frameIndex < m_GpuFrames.size(); frameIndex++)
+        if(m_GpuFrames[frameIndex].submitted)
+            frameIndices.push_back(frameIndex);
+
+    std::sort(frameIndices.begin(), frameIndices.end(), [this](uint32_t a, uint32_t b){
+        return m_GpuFrames[a].frameNumber < m_GpuFrames[b].frameNumber;
+    });
+    for(uint32_t frameIndex : frameIndices)
+        completeFrame(m_GpuFrames[frameIndex], frameIndex);
+}
+
+uint32_t VulkanProfiler::threadIndex() {
+    std::thread::id threadId = std::this_thread::get_id();
+
+    auto it = std::find(m_ThreadIds.begin(), m_ThreadIds.end(), threadId);
+    if(it != m_ThreadIds.end())
+        return static_cast<uint32_t>(it - m_ThreadIds.begin());
+
+    m_ThreadIds.push_back(threadId);
+    return static_cast<uint32_t>(m_ThreadIds.size() - 1);
+}
+
+VulkanProfiler::FrameRecord* VulkanProfiler::findRecord(uint64_t frameNumber) {
+    if(frameNumber == 0 || m_History.empty())
+        return nullptr;
+
+    FrameRecord& frameRecord = m_History[frameNumber % m_HistorySize];
+    return frameRecord.frameNumber == frameNumber ? &frameRecord : nullptr;
+}
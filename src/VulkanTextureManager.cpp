@@ -0,0 +1,216 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanTextureManager.h"
+
+#include <algorithm>
+
+VulkanTextureManager::~VulkanTextureManager() {
+    for(auto& texture : m_Textures){
+        if(texture.bindlessIndex != VulkanBindlessDescriptors::INVALID_INDEX)
+            m_BindlessDescriptors->RemoveSampledImage(texture.bindlessIndex);
+        vkDestroyImageView(m_Device, texture.imageView, nullptr);
+        m_Allocator->DestroyImage(texture.image, texture.allocation);
+    }
+
+    vkDestroySampler(m_Device, Sampler, nullptr);
+}
+
+void VulkanTextureManager::EnableFeatures(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures& physicalDeviceFeatures) {
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+    physicalDeviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+    physicalDeviceFeatures.textureCompressionETC2 = supportedFeatures.textureCompressionETC2;
+    physicalDeviceFeatures.textureCompressionASTC_LDR = supportedFeatures.textureCompressionASTC_LDR;
+    physicalDeviceFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
+}
+
+void VulkanTextureManager::Create(VkPhysicalDevice physicalDevice, VkDevice device, DeferDestroyFunction deferDestroy) {
+    m_PhysicalDevice = physicalDevice;
+    m_Device = device;
+    m_DeferDestroy = std::move(deferDestroy);
+
+    //EnableFeatures() turned anisotropy on wherever it is supported
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+    VkPhysicalDeviceProperties physicalDeviceProperties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.anisotropyEnable = supportedFeatures.samplerAnisotropy;
+    samplerCreateInfo.maxAnisotropy = std::min(8.0f, physicalDeviceProperties.limits.maxSamplerAnisotropy);
+    samplerCreateInfo.minLod = 0.0f;
+    //views start at the finest resident level, LOD is relative to it
+    samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+    if(vkCreateSampler(m_Device, &samplerCreateInfo, nullptr, &Sampler) != VK_SUCCESS)
+        throw std::runtime_error("VulkanTextureManager::Create() -> Failed to create sampler!");
+}
+
+uint32_t VulkanTextureManager::Load(const std::string& path) {
+    Texture texture;
+    texture.file = std::make_shared<TextureFile>();
+    texture.file->Open(path);
+
+    texture.format = texture.file->GetFormat();
+    texture.formatInfo = texture.file->GetFormatInfo();
+    if(!isFormatSupported(texture.format)){
+        VkFormat decodedFormat = TextureFile::GetDecodedFormat(texture.format);
+        if(decodedFormat == VK_FORMAT_UNDEFINED || !isFormatSupported(decodedFormat))
+            throw std::runtime_error("VulkanTextureManager::Load() -> " + path + " has a format the device can not sample!");
+
+        texture.format = decodedFormat;
+        TextureFile::GetFormatInfo(decodedFormat, texture.formatInfo);
+        texture.decode = true;
+    }
+
+    texture.extent = {texture.file->GetWidth(), texture.file->GetHeight()};
+    texture.levelCount = texture.file->GetLevelCount();
+    texture.tailLevel = texture.levelCount - 1;
+    while(texture.tailLevel > 0 && std::max(texture.extent.width >> (texture.tailLevel - 1), texture.extent.height >> (texture.tailLevel - 1)) <= MIP_TAIL_SIZE)
+        texture.tailLevel--;
+    texture.residentLevel = texture.levelCount;
+    texture.queuedLevel = texture.levelCount;
+    texture.requestedLevel = texture.levelCount;
+
+    //the whole chain is allocated up front, without sparse binding levels can not be backed one by one
+    VkImageCreateInfo imageCreateInfo{};
+    imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageCreateInfo.format = texture.format;
+    imageCreateInfo.extent = {texture.extent.width, texture.extent.height, 1};
+    imageCreateInfo.mipLevels = texture.levelCount;
+    imageCreateInfo.arrayLayers = 1;
+    imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    m_Allocator->CreateImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture.image, texture.allocation);
+
+    auto textureId = static_cast<uint32_t>(m_Textures.size());
+    m_Textures.push_back(std::move(texture));
+    queueLevels(textureId, m_Textures[textureId].tailLevel);
+
+    return textureId;
+}
+
+void VulkanTextureManager::RequestLevel(uint32_t texture, uint32_t level) {
+    Texture& entry = m_Textures[texture];
+    entry.requestedLevel = std::min(entry.requestedLevel, level);
+}
+
+void VulkanTextureManager::Update() {
+    for(uint32_t texture = 0; texture < m_Textures.size(); texture++){
+        Texture& entry = m_Textures[texture];
+        if(entry.requestedLevel < entry.queuedLevel)
+            queueLevels(texture, entry.requestedLevel);
+        entry.requestedLevel = entry.levelCount;
+    }
+}
+
+VulkanTextureManager::MemoryStats VulkanTextureManager::GetMemoryStats() const {
+    MemoryStats memoryStats;
+    memoryStats.textureCount = static_cast<uint32_t>(m_Textures.size());
+
+    for(const auto& texture : m_Textures){
+        memoryStats.deviceBytes += texture.allocation.Size;
+        for(uint32_t level = 0; level < texture.levelCount; level++){
+            VkExtent2D extent = {std::max(texture.extent.width >> level, 1u), std::max(texture.extent.height >> level, 1u)};
+            memoryStats.rgba8Bytes += static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+            if(level >= texture.residentLevel){
+                VkDeviceSize blocksX = (extent.width + texture.formatInfo.blockWidth - 1) / texture.formatInfo.blockWidth;
+                VkDeviceSize blocksY = (extent.height + texture.formatInfo.blockHeight - 1) / texture.formatInfo.blockHeight;
+                memoryStats.residentBytes += blocksX * blocksY * texture.formatInfo.blockSize;
+            }
+        }
+    }
+
+    return memoryStats;
+}
+
+bool VulkanTextureManager::isFormatSupported(VkFormat format) const {
+    VkFormatProperties formatProperties{};
+    vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, format, &formatProperties);
+
+    VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+                                            VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+    return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+
+void VulkanTextureManager::queueLevels(uint32_t texture, uint32_t level) {
+    Texture& entry = m_Textures[texture];
+    level = std::min(level, entry.tailLevel);
+
+    //coarsest first, every arrived level widens the view by one
+    while(entry.queuedLevel > level){
+        uint32_t queuedLevel = --entry.queuedLevel;
+
+        AssetStreamer::Request request;
+        request.load = [file = entry.file, decode = entry.decode, queuedLevel](){
+            if(decode)
+                return AssetStreamer::AssetData::FromBuffer(file->DecodeLevel(queuedLevel));
+
+            //generated levels are built here on first access, stored ones point into the mapping
+            AssetStreamer::AssetData data;
+            data.data = file->GetLevelData(queuedLevel);
+            data.size = file->GetLevelSize(queuedLevel);
+            data.owner = file;
+            AssetStreamer::Prefault(data.data, static_cast<size_t>(data.size));
+
+            return data;
+        };
+        request.image.image = entry.image;
+        request.image.mipLevel = queuedLevel;
+        request.image.extent = {std::max(entry.extent.width >> queuedLevel, 1u), std::max(entry.extent.height >> queuedLevel, 1u)};
+        request.image.blockWidth = entry.formatInfo.blockWidth;
+        request.image.blockHeight = entry.formatInfo.blockHeight;
+        request.image.blockSize = entry.formatInfo.blockSize;
+        request.onReady = [this, texture, queuedLevel](){ onLevelReady(texture, queuedLevel); };
+
+        m_Streamer->Submit(std::move(request));
+    }
+}
+
+void VulkanTextureManager::onLevelReady(uint32_t texture, uint32_t level) {
+    Texture& entry = m_Textures[texture];
+    entry.residentLevel = level;
+
+    //the tail is published as a whole, levels below it one by one
+    if(level > entry.tailLevel)
+        return;
+
+    VkImageViewCreateInfo imageViewCreateInfo{};
+    imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    imageViewCreateInfo.image = entry.image;
+    imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    imageViewCreateInfo.format = entry.format;
+    imageViewCreateInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, entry.levelCount - level, 0, 1};
+
+    VkImageView imageView = VK_NULL_HANDLE;
+    if(vkCreateImageView(m_Device, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS)
+        throw std::runtime_error("VulkanTextureManager::onLevelReady() -> Failed to create image view!");
+
+    //frames in flight keep sampling the previous view through the previous slot
+    if(entry.imageView != VK_NULL_HANDLE){
+        m_DeferDestroy([device = m_Device, bindlessDescriptors = m_BindlessDescriptors,
+                        imageView = entry.imageView, bindlessIndex = entry.bindlessIndex](){
+            bindlessDescriptors->RemoveSampledImage(bindlessIndex);
+            vkDestroyImageView(device, imageView, nullptr);
+        });
+    }
+
+    entry.imageView = imageView;
+    entry.bindlessIndex = m_BindlessDescriptors->AddSampledImage(imageView, Sampler);
+}
@@ -0,0 +1,307 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "VulkanUploader.h"
+
+#include <algorithm>
+#include <cstring>
+
+VulkanUploader::~VulkanUploader() {
+    if(m_Device == VK_NULL_HANDLE)
+        return;
+
+    for(auto& batch : m_Batches){
+        vkWaitForFences(m_Device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(m_Device, batch.fence, nullptr);
+        vkDestroySemaphore(m_Device, batch.semaphore, nullptr);
+    }
+
+    vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+    m_StagingRing.reset();
+}
+
+void VulkanUploader::Create(VkDevice device, VkQueue transferQueue, uint32_t transferFamily, uint32_t graphicsFamily) {
+    m_Device = device;
+    m_TransferQueue = transferQueue;
+    m_TransferFamily = transferFamily;
+    m_GraphicsFamily = graphicsFamily;
+
+    m_StagingRing = std::make_unique<VulkanRingArena>(m_Allocator, m_StagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, BATCH_COUNT);
+
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = m_TransferFamily;
+
+    if(vkCreateCommandPool(m_Device, &commandPoolCreateInfo, nullptr, &m_CommandPool) != VK_SUCCESS)
+        throw std::runtime_error("VulkanUploader::Create() -> Failed to create transfer command pool!");
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = m_CommandPool;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for(auto& batch : m_Batches){
+        if(vkAllocateCommandBuffers(m_Device, &commandBufferAllocateInfo, &batch.commandBuffer) != VK_SUCCESS)
+            throw std::runtime_error("VulkanUploader::Create() -> Failed to allocate transfer command buffer!");
+        if(vkCreateSemaphore(m_Device, &semaphoreCreateInfo, nullptr, &batch.semaphore) != VK_SUCCESS)
+            throw std::runtime_error("VulkanUploader::Create() -> Failed to create semaphore!");
+        if(vkCreateFence(m_Device, &fenceCreateInfo, nullptr, &batch.fence) != VK_SUCCESS)
+            throw std::runtime_error("VulkanUploader::Create() -> Failed to create fence!");
+    }
+}
+
+void VulkanUploader::UploadBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+                                  VkAccessFlags dstAccessMask, VkPipelineStageFlags dstStageMask) {
+    VkDeviceSize uploaded = 0;
+
+    while(uploaded < size){
+        beginBatch();
+
+        //split uploads so that one chunk never needs more than half of the ring
+        VkDeviceSize chunkSize = std::min(size - uploaded, m_StagingRing->Size / 2);
+        VkDeviceSize stagingOffset = 0;
+
+        if(!m_StagingRing->Allocate(chunkSize, STAGING_ALIGNMENT, stagingOffset)){
+            //ring is full, submit what we have and continue in the next batch
+            Flush();
+            continue;
+        }
+
+        std::memcpy(m_StagingRing->GetMappedData(stagingOffset), static_cast<const char*>(data) + uploaded, chunkSize);
+
+        VkBufferCopy bufferCopy{};
+        bufferCopy.srcOffset = stagingOffset;
+        bufferCopy.dstOffset = dstOffset + uploaded;
+        bufferCopy.size = chunkSize;
+
+        Batch& batch = m_Batches[m_CurrentBatch];
+        vkCmdCopyBuffer(batch.commandBuffer, m_StagingRing->Buffer, dstBuffer, 1, &bufferCopy);
+        batch.dstStageMask |= dstStageMask;
+
+        uploaded += chunkSize;
+    }
+
+    if(m_TransferFamily != m_GraphicsFamily){
+        VkBufferMemoryBarrier bufferMemoryBarrier{};
+        bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        bufferMemoryBarrier.dstAccessMask = 0;
+        bufferMemoryBarrier.srcQueueFamilyIndex = m_TransferFamily;
+        bufferMemoryBarrier.dstQueueFamilyIndex = m_GraphicsFamily;
+        bufferMemoryBarrier.buffer = dstBuffer;
+        bufferMemoryBarrier.offset = dstOffset;
+        bufferMemoryBarrier.size = size;
+        m_ReleaseBarriers.push_back(bufferMemoryBarrier);
+
+        bufferMemoryBarrier.srcAccessMask = 0;
+        bufferMemoryBarrier.dstAccessMask = dstAccessMask;
+        m_AcquireBarriers.push_back(bufferMemoryBarrier);
+    }
+}
+
+void VulkanUploader::BeginImageUpload(const ImageUpload& upload) {
+    beginBatch();
+
+    VkImageMemoryBarrier imageMemoryBarrier{};
+    imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageMemoryBarrier.srcAccessMask = 0;
+    imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    //contents are discarded, the transfer queue may use the level without acquiring it
+    imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.image = upload.image;
+    imageMemoryBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, upload.mipLevel, 1, 0, 1};
+
+    Batch& batch = m_Batches[m_CurrentBatch];
+    vkCmdPipelineBarrier(batch.commandBuffer,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr,
+                         0, nullptr,
+                         1, &imageMemoryBarrier);
+    batch.dstStageMask |= upload.dstStageMask;
+}
+
+void VulkanUploader::UploadImageRows(const ImageUpload& upload, uint32_t firstBlockRow, uint32_t blockRowCount, const void* data) {
+    VkDeviceSize rowSize = upload.GetBlockRowSize();
+    uint32_t uploadedRows = 0;
+
+    while(uploadedRows < blockRowCount){
+        beginBatch();
+
+        //whole block rows only, at least one even when a row is bigger than half of the ring
+        auto maxRows = static_cast<uint32_t>(std::max<VkDeviceSize>(m_StagingRing->Size / 2 / rowSize, 1));
+        uint32_t chunkRows = std::min(blockRowCount - uploadedRows, maxRows);
+        VkDeviceSize stagingOffset = 0;
+
+        if(!m_StagingRing->Allocate(chunkRows * rowSize, STAGING_ALIGNMENT, stagingOffset)){
+            Flush();
+            continue;
+        }
+
+        std::memcpy(m_StagingRing->GetMappedData(stagingOffset), static_cast<const char*>(data) + uploadedRows * rowSize, chunkRows * rowSize);
+
+        //the last block row may reach past the edge of the level, the copy stops at the edge
+        uint32_t firstTexelRow = (firstBlockRow + uploadedRows) * upload.blockHeight;
+        VkBufferImageCopy bufferImageCopy{};
+        bufferImageCopy.bufferOffset = stagingOffset;
+        bufferImageCopy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, upload.mipLevel, 0, 1};
+        bufferImageCopy.imageOffset = {0, static_cast<int32_t>(firstTexelRow), 0};
+        bufferImageCopy.imageExtent = {upload.extent.width, std::min(chunkRows * upload.blockHeight, upload.extent.height - firstTexelRow), 1};
+
+        Batch& batch = m_Batches[m_CurrentBatch];
+        vkCmdCopyBufferToImage(batch.commandBuffer, m_StagingRing->Buffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferImageCopy);
+        batch.dstStageMask |= upload.dstStageMask;
+
+        uploadedRows += chunkRows;
+    }
+}
+
+void VulkanUploader::EndImageUpload(const ImageUpload& upload) {
+    beginBatch();
+
+    VkImageMemoryBarrier imageMemoryBarrier{};
+    imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    imageMemoryBarrier.dstAccessMask = 0;
+    imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.image = upload.image;
+    imageMemoryBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, upload.mipLevel, 1, 0, 1};
+
+    Batch& batch = m_Batches[m_CurrentBatch];
+    batch.dstStageMask |= upload.dstStageMask;
+
+    if(m_TransferFamily == m_GraphicsFamily){
+        //the graphics submit waits on the batch semaphore, which makes the transition visible to it
+        vkCmdPipelineBarrier(batch.commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr,
+                             0, nullptr,
+                             1, &imageMemoryBarrier);
+        return;
+    }
+
+    //release with the layout transition, the acquire repeats both layouts
+    imageMemoryBarrier.srcQueueFamilyIndex = m_TransferFamily;
+    imageMemoryBarrier.dstQueueFamilyIndex = m_GraphicsFamily;
+    m_ImageReleaseBarriers.push_back(imageMemoryBarrier);
+
+    imageMemoryBarrier.srcAccessMask = 0;
+    imageMemoryBarrier.dstAccessMask = upload.dstAccessMask;
+    m_ImageAcquireBarriers.push_back(imageMemoryBarrier);
+}
+
+void VulkanUploader::Flush() {
+    Batch& batch = m_Batches[m_CurrentBatch];
+    if(!batch.recording)
+        return;
+
+    if(!m_ReleaseBarriers.empty() || !m_ImageReleaseBarriers.empty()){
+        vkCmdPipelineBarrier(batch.commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr,
+                             static_cast<uint32_t>(m_ReleaseBarriers.size()), m_ReleaseBarriers.data(),
+                             static_cast<uint32_t>(m_ImageReleaseBarriers.size()), m_ImageReleaseBarriers.data());
+        m_ReleaseBarriers.clear();
+        m_ImageReleaseBarriers.clear();
+    }
+
+    if(vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS)
+        throw std::runtime_error("VulkanUploader::Flush() -> Failed to record transfer command buffer!");
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &batch.semaphore;
+
+    //a signal no graphics submit took yet is waited on here, its batch may be recycled before the next graphics submit
+    //and a binary semaphore must not be signaled again while a signal is pending. The new signal covers every earlier
+    //batch in submission order, so the graphics queue only ever needs to wait on the latest one.
+    VkSemaphore previousSemaphore = VK_NULL_HANDLE;
+    VkPipelineStageFlags previousWaitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkPipelineStageFlags dstStageMask = batch.dstStageMask;
+    if(!m_PendingWaitSemaphores.empty()){
+        previousSemaphore = m_PendingWaitSemaphores.back().semaphore;
+        dstStageMask |= m_PendingWaitSemaphores.back().stageMask;
+        m_PendingWaitSemaphores.clear();
+
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &previousSemaphore;
+        submitInfo.pWaitDstStageMask = &previousWaitStage;
+    }
+
+    if(vkQueueSubmit(m_TransferQueue, 1, &submitInfo, batch.fence) != VK_SUCCESS)
+        throw std::runtime_error("VulkanUploader::Flush() -> Failed to submit transfer command buffer!");
+
+    m_PendingWaitSemaphores.push_back({batch.semaphore, dstStageMask});
+
+    m_PendingAcquireBarriers.insert(m_PendingAcquireBarriers.end(), m_AcquireBarriers.begin(), m_AcquireBarriers.end());
+    m_PendingImageAcquireBarriers.insert(m_PendingImageAcquireBarriers.end(), m_ImageAcquireBarriers.begin(), m_ImageAcquireBarriers.end());
+    m_PendingAcquireStageMask |= batch.dstStageMask;
+    m_AcquireBarriers.clear();
+    m_ImageAcquireBarriers.clear();
+
+    batch.recording = false;
+    m_CurrentBatch = (m_CurrentBatch + 1) % BATCH_COUNT;
+}
+
+void VulkanUploader::RecordAcquireBarriers(VkCommandBuffer commandBuffer) {
+    if(m_PendingAcquireBarriers.empty() && m_PendingImageAcquireBarriers.empty())
+        return;
+
+    //source stage matches the semaphore wait stage of the same submit
+    vkCmdPipelineBarrier(commandBuffer,
+                         m_PendingAcquireStageMask, m_PendingAcquireStageMask, 0,
+                         0, nullptr,
+                         static_cast<uint32_t>(m_PendingAcquireBarriers.size()), m_PendingAcquireBarriers.data(),
+                         static_cast<uint32_t>(m_PendingImageAcquireBarriers.size()), m_PendingImageAcquireBarriers.data());
+    m_PendingAcquireBarriers.clear();
+    m_PendingImageAcquireBarriers.clear();
+    m_PendingAcquireStageMask = 0;
+}
+
+std::vector<VulkanUploader::WaitSemaphore> VulkanUploader::TakeWaitSemaphores() {
+    std::vector<WaitSemaphore> waitSemaphores;
+    waitSemaphores.swap(m_PendingWaitSemaphores);
+    return waitSemaphores;
+}
+
+void VulkanUploader::beginBatch() {
+    Batch& batch = m_Batches[m_CurrentBatch];
+    if(batch.recording)
+        return;
+
+    //batches are recycled in order, this only blocks when the staging ring is exhausted
+    vkWaitForFences(m_Device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(m_Device, 1, &batch.fence);
+
+    m_StagingRing->BeginFrame(m_CurrentBatch);
+
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if(vkBeginCommandBuffer(batch.commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS)
+        throw std::runtime_error("VulkanUploader::beginBatch() -> Failed to begin transfer command buffer!");
+
+    batch.dstStageMask = 0;
+    batch.recording = true;
+}
@@ -1,11 +1,107 @@
 #include "RenderEngine.h"
 #include <stdexcept>
+#include <cctype>
+#include <cmath>
+#include <string>
 
-int main() {
+///@brief whole argument as a number in [min, max], anything else throws naming the option
+static uint64_t parseNumber(const std::string& option, const std::string& value, uint64_t min, uint64_t max) {
+    size_t parsed = 0;
+    uint64_t number = 0;
+    //stoull accepts leading blanks and wraps negative numbers around
+    if(!value.empty() && std::isdigit(static_cast<unsigned char>(value[0]))){
+        try{
+            number = std::stoull(value, &parsed);
+        } catch (const std::exception&) {
+            parsed = 0;
+        }
+    }
+
+    if(parsed == 0 || parsed != value.size() || number < min || number > max)
+        throw std::runtime_error("main() -> " + option + " expects a number from " + std::to_string(min) + " to "
+                                 + std::to_string(max) + ", got \"" + value + "\"!");
+
+    return number;
+}
+
+int main(int argc, char** argv) {
     auto application = MyRenderer::RenderEngine(800, 600, "Vulkan Renderer");
 
     //heap allocation throws SIGSEV????
+    //bad arguments end up in the same error path as a failed Run()
     try{
+        uint32_t instanceCount = 0;
+
+        //--headless [frame count] renders offscreen, without window and swap chain
+        //--trace <file> dumps frame timings as Chrome trace JSON on exit
+        //--latency low|balanced|throughput selects frames in flight and present mode, F1-F3 switch it at runtime
+        //--timeline paces frames with a Vulkan 1.2 timeline semaphore instead of fences
+        //--msaa <samples> multisampling sample count, 1 disables it (default 4)
+        //--no-gpu-culling records the draw list on the CPU instead of compute culling and indirect draws
+        //--async-compute culls on a separate compute queue overlapping the graphics queue
+        //--instances <count> draws a grid of instanced triangles with one draw call
+        //--scene <file.vkm> draws every mesh of a file written by MeshConverter
+        //--texture <file.ktx2> textures every draw, mip levels stream in by screen size
+        //--upload-budget <KiB> bytes of streamed assets uploaded per frame
+        for(int i = 1; i < argc; i++){
+            if(std::string(argv[i]) == "--headless")
+                application.SetHeadless(true, i + 1 < argc && std::isdigit(argv[i + 1][0]) ? static_cast<uint32_t>(parseNumber("--headless", argv[++i], 0, UINT32_MAX)) : 1);
+            else if(std::string(argv[i]) == "--trace" && i + 1 < argc)
+                application.SetTraceOutput(argv[++i]);
+            else if(std::string(argv[i]) == "--timeline")
+                application.SetTimelineSync(true);
+            else if(std::string(argv[i]) == "--no-gpu-culling")
+                application.SetGpuCulling(false);
+            else if(std::string(argv[i]) == "--async-compute")
+                application.SetAsyncCompute(true);
+            else if(std::string(argv[i]) == "--instances" && i + 1 < argc)
+                instanceCount = static_cast<uint32_t>(parseNumber("--instances", argv[++i], 0, UINT32_MAX));
+            else if(std::string(argv[i]) == "--scene" && i + 1 < argc)
+                application.SetSceneFile(argv[++i]);
+            else if(std::string(argv[i]) == "--texture" && i + 1 < argc)
+                application.SetTextureFile(argv[++i]);
+            else if(std::string(argv[i]) == "--upload-budget" && i + 1 < argc)
+                application.SetUploadBudget(parseNumber("--upload-budget", argv[++i], 1, UINT64_MAX / 1024) * 1024);
+            else if(std::string(argv[i]) == "--msaa" && i + 1 < argc){
+                auto sampleCount = static_cast<uint32_t>(parseNumber("--msaa", argv[++i], 1, 16));
+                //VkSampleCountFlagBits only has powers of two
+                if((sampleCount & (sampleCount - 1)) != 0)
+                    throw std::runtime_error("main() -> --msaa expects 1, 2, 4, 8 or 16, got " + std::to_string(sampleCount) + "!");
+
+                application.SetMsaaSamples(sampleCount);
+            }
+            else if(std::string(argv[i]) == "--latency" && i + 1 < argc){
+                std::string latencyMode = argv[++i];
+                if(latencyMode == "low")
+                    application.SetLatencyMode(MyRenderer::RenderEngine::LatencyMode::LowLatency);
+                else if(latencyMode == "throughput")
+                    application.SetLatencyMode(MyRenderer::RenderEngine::LatencyMode::MaxThroughput);
+                else
+                    application.SetLatencyMode(MyRenderer::RenderEngine::LatencyMode::Balanced);
+            }
+        }
+
+        //square grid covering the clip space, has to live until Run() returns
+        InstanceBatch instanceBatch(MyRenderer::RenderEngine::TRIANGLE_MESH);
+        if(instanceCount > 0){
+            auto gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(instanceCount))));
+            float cellSize = 2.0f / static_cast<float>(gridSize);
+
+            instanceBatch.Resize(instanceCount);
+            for(uint32_t i = 0; i < instanceCount; i++){
+                glm::mat4& transform = instanceBatch.Transforms[i];
+                transform[0][0] = cellSize;
+                transform[1][1] = cellSize;
+                transform[3][0] = -1.0f + cellSize * (static_cast<float>(i % gridSize) + 0.5f);
+                transform[3][1] = -1.0f + cellSize * (static_cast<float>(i / gridSize) + 0.5f);
+
+                instanceBatch.Colors[i] = glm::vec4(static_cast<float>(i % gridSize) / static_cast<float>(gridSize),
+                                                    static_cast<float>(i / gridSize) / static_cast<float>(gridSize), 1.0f, 1.0f);
+            }
+
+            application.AddInstanceBatch(&instanceBatch);
+        }
+
         application.Run();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -13,4 +109,4 @@ int main() {
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
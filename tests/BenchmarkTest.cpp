@@ -0,0 +1,123 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "BenchmarkBaseline.h"
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+//percentile maths and baseline comparison of the benchmark, without running a scene
+
+static int s_Failures = 0;
+
+static void check(bool condition, const std::string& message) {
+    if(condition)
+        return;
+
+    std::cerr << "BenchmarkTest -> " << message << std::endl;
+    s_Failures++;
+}
+
+static void summarizePercentiles() {
+    //1 to 100 in random order, the nearest rank of percentile p is p itself
+    std::vector<double> samples(100);
+    std::iota(samples.begin(), samples.end(), 1.0);
+    std::shuffle(samples.begin(), samples.end(), std::mt19937(42));
+
+    FrameStatistics::Summary summary = FrameStatistics::Summarize(samples);
+    check(summary.count == 100, "summarize: count");
+    check(summary.average == 50.5, "summarize: average");
+    check(summary.min == 1.0 && summary.max == 100.0, "summarize: min and max");
+    check(summary.p50 == 50.0, "summarize: p50");
+    check(summary.p95 == 95.0, "summarize: p95");
+    check(summary.p99 == 99.0, "summarize: p99");
+
+    //ranks round up, ceil(0.5 * 3) = 2 and ceil(0.95 * 3) = 3
+    summary = FrameStatistics::Summarize({5.0, 1.0, 3.0});
+    check(summary.p50 == 3.0, "summarize small: p50");
+    check(summary.p95 == 5.0 && summary.p99 == 5.0, "summarize small: p95 and p99");
+
+    summary = FrameStatistics::Summarize({2.0});
+    check(summary.count == 1 && summary.min == 2.0 && summary.p50 == 2.0 && summary.p99 == 2.0 && summary.max == 2.0,
+          "summarize single sample");
+
+    summary = FrameStatistics::Summarize(std::vector<double>{});
+    check(summary.count == 0 && summary.average == 0.0 && summary.p95 == 0.0, "summarize empty");
+}
+
+static FrameStatistics::Summary makeSummary(double average, double p95) {
+    FrameStatistics::Summary summary{};
+    summary.count = 10;
+    summary.average = average;
+    summary.p95 = p95;
+    return summary;
+}
+
+static void baselineComparison() {
+    BenchmarkBaseline baseline(R"({"frames": 10, "warmupFrames": 0, "scenes": [
+        {"name": "scene", "frame": {"count": 10, "average": 10.0, "p95": 12.0},
+         "record": {"count": 10, "average": 0.1, "p95": 0.2},
+         "gpu": {"count": 0, "average": 0.0, "p95": 0.0}}
+    ]})");
+
+    check(baseline.HasScene("scene"), "baseline: scene missing");
+    check(!baseline.HasScene("other"), "baseline: unknown scene found");
+
+    BenchmarkBaseline::Summaries summaries{};
+    summaries[FrameStatistics::FRAME_TIME] = makeSummary(10.0, 12.0);
+    summaries[FrameStatistics::RECORD_TIME] = makeSummary(0.1, 0.2);
+    check(baseline.Compare("scene", summaries, 10.0).empty(), "baseline: same values regressed");
+    check(baseline.Compare("other", summaries, 10.0).empty(), "baseline: unknown scene regressed");
+
+    //exactly at the threshold is still fine, above it only the average regressed
+    summaries[FrameStatistics::FRAME_TIME] = makeSummary(11.0, 13.2);
+    check(baseline.Compare("scene", summaries, 10.0).empty(), "baseline: value at the threshold regressed");
+
+    summaries[FrameStatistics::FRAME_TIME] = makeSummary(11.5, 13.0);
+    auto regressions = baseline.Compare("scene", summaries, 10.0);
+    check(regressions.size() == 1, "baseline: regression count");
+    if(regressions.size() == 1){
+        check(regressions[0].metric == FrameStatistics::FRAME_TIME, "baseline: regression metric");
+        check(std::string(regressions[0].statistic) == "average", "baseline: regression statistic");
+        check(regressions[0].value == 11.5 && regressions[0].baselineValue == 10.0, "baseline: regression values");
+    }
+    check(baseline.Compare("scene", summaries, 20.0).empty(), "baseline: regression below a higher threshold");
+
+    //+40% on 0.1 ms is timer noise, +0.1 ms on 0.2 ms is not
+    summaries[FrameStatistics::FRAME_TIME] = makeSummary(10.0, 12.0);
+    summaries[FrameStatistics::RECORD_TIME] = makeSummary(0.14, 0.3);
+    regressions = baseline.Compare("scene", summaries, 10.0);
+    check(regressions.size() == 1 && std::string(regressions[0].statistic) == "p95", "baseline: minimum regression");
+
+    //no GPU samples in the baseline, or none in the run, is never a regression
+    summaries[FrameStatistics::RECORD_TIME] = makeSummary(0.1, 0.2);
+    summaries[FrameStatistics::GPU_TIME] = makeSummary(100.0, 100.0);
+    check(baseline.Compare("scene", summaries, 10.0).empty(), "baseline: metric without baseline samples regressed");
+
+    summaries[FrameStatistics::GPU_TIME] = FrameStatistics::Summary{};
+    summaries[FrameStatistics::SUBMIT_TIME] = makeSummary(100.0, 100.0);
+    check(baseline.Compare("scene", summaries, 10.0).empty(), "baseline: metric missing in the baseline regressed");
+}
+
+int main() {
+    summarizePercentiles();
+
+    try{
+        baselineComparison();
+    } catch (const std::exception& e) {
+        std::cerr << "BenchmarkTest -> " << e.what() << std::endl;
+        s_Failures++;
+    }
+
+    if(s_Failures != 0){
+        std::cerr << "BenchmarkTest -> " << s_Failures << " checks failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
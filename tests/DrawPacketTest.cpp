@@ -0,0 +1,104 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "DrawPacket.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+//DrawPacketSorter::Sort() has to give the same order as std::stable_sort by key, whatever digits the keys share
+
+static int s_Failures = 0;
+
+static void check(bool condition, const std::string& message) {
+    if(condition)
+        return;
+
+    std::cerr << "DrawPacketTest -> " << message << std::endl;
+    s_Failures++;
+}
+
+///@brief packets in draw index order with keys only varying in the 8 bit digits set in digitMask
+static std::vector<DrawPacket> makePackets(size_t count, uint32_t digitMask, uint64_t sharedBits, std::mt19937_64& random) {
+    uint64_t keyMask = 0;
+    for(uint32_t digit = 0; digit < 8; digit++){
+        if(digitMask & (1u << digit))
+            keyMask |= uint64_t(0xFF) << (digit * 8);
+    }
+
+    //few distinct values per digit, so equal keys are common and stability is actually tested
+    std::vector<DrawPacket> packets(count);
+    for(size_t i = 0; i < count; i++){
+        uint64_t key = random() & keyMask & 0x0303030303030303ull;
+        packets[i] = {(sharedBits & ~keyMask) | key, static_cast<uint32_t>(i)};
+    }
+
+    return packets;
+}
+
+static void checkSort(DrawPacketSorter& sorter, std::vector<DrawPacket> packets, const std::string& name) {
+    std::vector<DrawPacket> expected = packets;
+    std::stable_sort(expected.begin(), expected.end(), [](const DrawPacket& a, const DrawPacket& b){ return a.sortKey < b.sortKey; });
+
+    sorter.Sort(packets);
+
+    bool equal = packets.size() == expected.size() && std::equal(packets.begin(), packets.end(), expected.begin(),
+        [](const DrawPacket& a, const DrawPacket& b){ return a.sortKey == b.sortKey && a.drawIndex == b.drawIndex; });
+    check(equal, name + ": order differs from std::stable_sort");
+}
+
+static void sortMatchesStableSort(DrawPacketSorter& sorter) {
+    std::mt19937_64 random(42);
+    const uint64_t sharedBits = 0x1234567890ABCDEFull;
+
+    //enough packets for several chunks, not a multiple of the chunk size
+    for(size_t count : {size_t(0), size_t(1), size_t(2), size_t(1000), size_t(40001)}){
+        std::string suffix = " (" + std::to_string(count) + " packets)";
+
+        //odd number of scattered digits ends in the scratch buffer, even in the packets
+        checkSort(sorter, makePackets(count, 0b00000001, sharedBits, random), "one digit" + suffix);
+        checkSort(sorter, makePackets(count, 0b00010101, sharedBits, random), "three scattered digits" + suffix);
+        checkSort(sorter, makePackets(count, 0b10000010, sharedBits, random), "two scattered digits" + suffix);
+        checkSort(sorter, makePackets(count, 0b11111111, sharedBits, random), "all digits" + suffix);
+
+        //every digit shared, nothing is scattered and the order has to stay as it is
+        checkSort(sorter, makePackets(count, 0, sharedBits, random), "all digits equal" + suffix);
+    }
+
+    //the sorter reuses its buffers, a smaller sort after a larger one must not see stale packets
+    checkSort(sorter, makePackets(40001, 0b00010101, sharedBits, random), "reused large");
+    checkSort(sorter, makePackets(3, 0b00010101, sharedBits, random), "reused small");
+}
+
+static void keyOrder() {
+    //pipeline outranks material, material outranks mesh, mesh outranks depth
+    check(DrawPacketSorter::MakeKey(0, 1, 0, 0, 0.0f) > DrawPacketSorter::MakeKey(0, 0, 100, 100, 100.0f), "key: pipeline order");
+    check(DrawPacketSorter::MakeKey(0, 0, 1, 0, 0.0f) > DrawPacketSorter::MakeKey(0, 0, 0, 100, 100.0f), "key: material order");
+    check(DrawPacketSorter::MakeKey(0, 0, 0, 1, 0.0f) > DrawPacketSorter::MakeKey(0, 0, 0, 0, 100.0f), "key: mesh order");
+    check(DrawPacketSorter::MakeKey(0, 0, 0, 0, 2.0f) > DrawPacketSorter::MakeKey(0, 0, 0, 0, 1.0f), "key: depth order");
+    check(DrawPacketSorter::MakeKey(0, 0, 0, 0, -1.0f) == DrawPacketSorter::MakeKey(0, 0, 0, 0, 0.0f), "key: negative depth");
+
+    uint64_t sortKey = DrawPacketSorter::MakeKey(3, 17, 123456, 4000, 5.0f);
+    check(DrawPacketSorter::GetPipeline(sortKey) == 17, "key: pipeline field");
+    check(DrawPacketSorter::GetMaterial(sortKey) == 123456, "key: material field");
+}
+
+int main() {
+    //fixed worker count, so the chunked path runs on any machine
+    ThreadPool threadPool(4);
+    DrawPacketSorter sorter(&threadPool);
+
+    sortMatchesStableSort(sorter);
+    keyOrder();
+
+    if(s_Failures != 0){
+        std::cerr << "DrawPacketTest -> " << s_Failures << " checks failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+//
+// Created by Lukasz on 17.10.2026.
+//
+
+#include "RenderGraph.h"
+
+#include <cstdlib>
+#include <iostream>
+
+//Compile() needs no device, so the graphs here are only declared and compiled, never realized or executed
+
+static int s_Failures = 0;
+
+static void check(bool condition, const std::string& message) {
+    if(condition)
+        return;
+
+    std::cerr << "RenderGraphTest -> " << message << std::endl;
+    s_Failures++;
+}
+
+static void checkBarrier(const RenderGraph::ImageBarrier& barrier, RenderGraph::ResourceHandle resource,
+                         VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkImageLayout oldLayout,
+                         VkPipelineStageFlags dstStage, VkAccessFlags dstAccess, VkImageLayout newLayout,
+                         const std::string& name) {
+    check(barrier.resource == resource, name + ": resource");
+    check(barrier.srcStage == srcStage, name + ": srcStage");
+    check(barrier.srcAccess == srcAccess, name + ": srcAccess");
+    check(barrier.oldLayout == oldLayout, name + ": oldLayout");
+    check(barrier.dstStage == dstStage, name + ": dstStage");
+    check(barrier.dstAccess == dstAccess, name + ": dstAccess");
+    check(barrier.newLayout == newLayout, name + ": newLayout");
+}
+
+static const RenderGraph::ImageDescription COLOR_IMAGE{VK_FORMAT_R8G8B8A8_UNORM, {64, 64}};
+
+static const VkAccessFlags COLOR_ATTACHMENT_ACCESS = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+static RenderGraph::ResourceHandle importBackBuffer(RenderGraph& renderGraph, VkPipelineStageFlags initialStage) {
+    RenderGraph::ImportDescription importDescription{};
+    importDescription.initialStage = initialStage;
+    importDescription.finalAccess = RenderGraph::AccessType::Present;
+    return renderGraph.ImportImage("back buffer", importDescription);
+}
+
+static void culledWriteOnlyPass() {
+    RenderGraph renderGraph;
+    RenderGraph::ResourceHandle backBuffer = importBackBuffer(renderGraph, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    RenderGraph::ResourceHandle unused = renderGraph.CreateImage("unused", COLOR_IMAGE);
+
+    uint32_t unusedPass = renderGraph.AddPass("unused", nullptr);
+    renderGraph.Write(unusedPass, unused, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    uint32_t mainPass = renderGraph.AddPass("main", nullptr);
+    renderGraph.Write(mainPass, backBuffer, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    renderGraph.Compile();
+
+    check(renderGraph.IsPassCulled(unusedPass), "culled: pass writing an image nobody reads is live");
+    check(!renderGraph.IsPassCulled(mainPass), "culled: pass writing the back buffer is culled");
+    check(renderGraph.GetAliasSlot(unused) == UINT32_MAX, "culled: image of a culled pass has an alias slot");
+    check(renderGraph.GetAliasSlotCount() == 0, "culled: alias slot count");
+
+    const auto& compiledPasses = renderGraph.GetCompiledPasses();
+    check(compiledPasses.size() == 1 && compiledPasses[0].pass == mainPass, "culled: compiled passes");
+}
+
+static void readAfterWrite() {
+    RenderGraph renderGraph;
+    RenderGraph::ResourceHandle backBuffer = importBackBuffer(renderGraph, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    RenderGraph::ResourceHandle color = renderGraph.CreateImage("color", COLOR_IMAGE);
+
+    uint32_t scenePass = renderGraph.AddPass("scene", nullptr);
+    renderGraph.Write(scenePass, color, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    uint32_t compositePass = renderGraph.AddPass("composite", nullptr);
+    renderGraph.Read(compositePass, color, RenderGraph::AccessType::FragmentShaderRead);
+    renderGraph.Write(compositePass, backBuffer, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    renderGraph.Compile();
+
+    const auto& compiledPasses = renderGraph.GetCompiledPasses();
+    check(compiledPasses.size() == 2, "read after write: compiled pass count");
+    if(compiledPasses.size() != 2)
+        return;
+
+    //first use of a transient image also waits for the readers of the previous frame
+    check(compiledPasses[0].barriers.size() == 1, "read after write: scene barrier count");
+    if(compiledPasses[0].barriers.size() == 1)
+        checkBarrier(compiledPasses[0].barriers[0], color,
+                     VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, COLOR_ATTACHMENT_ACCESS, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     "read after write: scene color");
+
+    check(compiledPasses[1].barriers.size() == 2, "read after write: composite barrier count");
+    if(compiledPasses[1].barriers.size() == 2){
+        checkBarrier(compiledPasses[1].barriers[0], color,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                     "read after write: composite color");
+        checkBarrier(compiledPasses[1].barriers[1], backBuffer,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, COLOR_ATTACHMENT_ACCESS, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     "read after write: composite back buffer");
+    }
+}
+
+static void aliasedTransients() {
+    RenderGraph renderGraph;
+    RenderGraph::ResourceHandle backBuffer = importBackBuffer(renderGraph, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    RenderGraph::ResourceHandle first = renderGraph.CreateImage("first", COLOR_IMAGE);
+    RenderGraph::ResourceHandle second = renderGraph.CreateImage("second", COLOR_IMAGE);
+    RenderGraph::ResourceHandle third = renderGraph.CreateImage("third", COLOR_IMAGE);
+
+    //first lives in passes 0-1, second in 1-2, third in 2-3, so first and third can share memory
+    uint32_t pass0 = renderGraph.AddPass("pass 0", nullptr);
+    renderGraph.Write(pass0, first, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    uint32_t pass1 = renderGraph.AddPass("pass 1", nullptr);
+    renderGraph.Read(pass1, first, RenderGraph::AccessType::FragmentShaderRead);
+    renderGraph.Write(pass1, second, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    uint32_t pass2 = renderGraph.AddPass("pass 2", nullptr);
+    renderGraph.Read(pass2, second, RenderGraph::AccessType::FragmentShaderRead);
+    renderGraph.Write(pass2, third, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    uint32_t pass3 = renderGraph.AddPass("pass 3", nullptr);
+    renderGraph.Read(pass3, third, RenderGraph::AccessType::FragmentShaderRead);
+    renderGraph.Write(pass3, backBuffer, RenderGraph::AccessType::ColorAttachmentWrite);
+
+    renderGraph.Compile();
+
+    check(renderGraph.GetAliasSlotCount() == 2, "alias: slot count");
+    check(renderGraph.GetAliasSlot(first) == 0, "alias: first slot");
+    check(renderGraph.GetAliasSlot(second) == 1, "alias: second slot");
+    check(renderGraph.GetAliasSlot(third) == 0, "alias: third does not reuse the slot of first");
+    check(renderGraph.GetAliasSlot(backBuffer) == UINT32_MAX, "alias: imported image has an alias slot");
+
+    //third takes over the memory of first, its first write waits for the last read of first
+    const auto& compiledPasses = renderGraph.GetCompiledPasses();
+    check(compiledPasses.size() == 4, "alias: compiled pass count");
+    if(compiledPasses.size() != 4)
+        return;
+
+    check(compiledPasses[2].barriers.size() == 2, "alias: pass 2 barrier count");
+    if(compiledPasses[2].barriers.size() == 2)
+        checkBarrier(compiledPasses[2].barriers[1], third,
+                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, COLOR_ATTACHMENT_ACCESS, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     "alias: third after first");
+}
+
+static void backBufferFinalTransition() {
+    RenderGraph renderGraph;
+    RenderGraph::ResourceHandle backBuffer = importBackBuffer(renderGraph, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    uint32_t blitPass = renderGraph.AddPass("blit", nullptr);
+    renderGraph.Write(blitPass, backBuffer, RenderGraph::AccessType::TransferWrite);
+
+    renderGraph.Compile();
+
+    const auto& compiledPasses = renderGraph.GetCompiledPasses();
+    check(compiledPasses.size() == 1 && compiledPasses[0].barriers.size() == 1, "final: blit barrier count");
+    if(compiledPasses.size() == 1 && compiledPasses[0].barriers.size() == 1)
+        checkBarrier(compiledPasses[0].barriers[0], backBuffer,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     "final: blit back buffer");
+
+    //presentation synchronizes through the semaphore, only the layout transition is left
+    const auto& finalBarriers = renderGraph.GetFinalBarriers();
+    check(finalBarriers.size() == 1, "final: barrier count");
+    if(finalBarriers.size() == 1)
+        checkBarrier(finalBarriers[0], backBuffer,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                     "final: present");
+}
+
+int main() {
+    culledWriteOnlyPass();
+    readAfterWrite();
+    aliasedTransients();
+    backBufferFinalTransition();
+
+    if(s_Failures != 0){
+        std::cerr << "RenderGraphTest -> " << s_Failures << " checks failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}